@@ -0,0 +1,242 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    BlockMatrix.hpp
+ *    \brief   Dense matrices distributed by blocks on a grid of processes and
+ *             their parallel product ( SUMMA algorithm )
+ */
+#ifndef _PARALLEL_BLOCKMATRIX_HPP_
+# define _PARALLEL_BLOCKMATRIX_HPP_
+# include <algorithm>
+# include <array>
+# include <cassert>
+# include <functional>
+# include <vector>
+# include "Parallel/Communicator"
+# include "Parallel/LocalGemm.hpp"
+# include "Parallel/StridedView.hpp"
+# include "Parallel/Topology.hpp"
+
+namespace Parallel
+{
+    /*!   \class BlockMatrix
+     *    \brief Dense matrix stored by columns
+     *
+     *    Used for the block of a distributed matrix owned by a process.
+     */
+    template<typename K>
+    class BlockMatrix : public std::vector<K>
+    {
+    public:
+        BlockMatrix() = default;
+        BlockMatrix( std::size_t nrows, std::size_t ncols ) :
+            std::vector<K>(nrows*ncols),
+            m_nrows(nrows), m_ncols(ncols)
+        {}
+        BlockMatrix( std::size_t nrows, std::size_t ncols, const K& val ) :
+            std::vector<K>(nrows*ncols, val),
+            m_nrows(nrows), m_ncols(ncols)
+        {}
+        BlockMatrix( const BlockMatrix& A ) = default;
+        BlockMatrix( BlockMatrix&& A ) = default;
+        ~BlockMatrix() = default;
+
+        BlockMatrix& operator = ( const BlockMatrix& A )  = default;
+        BlockMatrix& operator = ( BlockMatrix&& A ) = default;
+
+        std::size_t getNRows() const { return m_nrows; }
+        std::size_t getNCols() const { return m_ncols; }
+
+        const K& operator () ( std::size_t i, std::size_t j ) const {
+            assert(i<m_nrows);
+            assert(j<m_ncols);
+            return (*this)[i + j*m_nrows];
+        }
+        K& operator () ( std::size_t i, std::size_t j ) {
+            assert(i<m_nrows);
+            assert(j<m_ncols);
+            return (*this)[i + j*m_nrows];
+        }
+        // The rows of the matrix aren't contiguous ( storage by columns ) :
+        StridedView<const K> row( std::size_t i ) const {
+            assert(i<m_nrows);
+            return StridedView<const K>(this->data()+i, m_ncols, m_nrows);
+        }
+        StridedView<K> row( std::size_t i ) {
+            assert(i<m_nrows);
+            return StridedView<K>(this->data()+i, m_ncols, m_nrows);
+        }
+    private:
+        std::size_t m_nrows = 0, m_ncols = 0;
+    };
+    // =================================================================
+    /*!   \class DistributedMatrix
+     *    \brief Dense matrix distributed by blocks on a square grid of processes
+     *
+     *    The process of coordinates ( I, J ) in the grid owns the block ( I, J ) of
+     *    the matrix. The rows ( and the columns ) are split in as many blocks as the
+     *    grid has rows ( and columns ), the sizes of the blocks differing at most by one.
+     *
+     *    \code
+     *    Parallel::CartesianCommunicator grid(com, {p, p}, {true, true});
+     *    Parallel::DistributedMatrix<double> A(grid, n, n, [] ( std::size_t i, std::size_t j ) {
+     *        return 1./(i+j+1.); } );
+     *    \endcode
+     */
+    template<typename K>
+    class DistributedMatrix
+    {
+    public:
+        /*!
+         *   \brief Create a null matrix ( collective call on the grid )
+         *
+         *   \param grid   A square two dimensional grid of processes
+         *   \param nrows  The global number of rows
+         *   \param ncols  The global number of columns
+         */
+        DistributedMatrix( const CartesianCommunicator& grid, std::size_t nrows, std::size_t ncols ) :
+            m_grid(grid), m_rows(grid, {false, true}), m_cols(grid, {true, false}),
+            m_nrows(nrows), m_ncols(ncols),
+            m_block( blockSize(nrows, m_cols.size, m_cols.rank),
+                     blockSize(ncols, m_rows.size, m_rows.rank), K(0) )
+        {
+            assert( grid.nbDimensions() == 2 );
+            assert( m_rows.size == m_cols.size );
+        }
+        /*!
+         *   \brief Create a matrix with coefficients given by a function of the global indices
+         *          ( collective call on the grid )
+         */
+        DistributedMatrix( const CartesianCommunicator& grid, std::size_t nrows, std::size_t ncols,
+                           const std::function<K(std::size_t, std::size_t)>& coefficient ) :
+            DistributedMatrix( grid, nrows, ncols )
+        {
+            for ( std::size_t j = 0; j < m_block.getNCols(); ++j )
+                for ( std::size_t i = 0; i < m_block.getNRows(); ++i )
+                    m_block(i, j) = coefficient( beginRow() + i, beginCol() + j );
+        }
+
+        std::size_t nbRows() const { return m_nrows; }
+        std::size_t nbCols() const { return m_ncols; }
+        /*!
+         *   \brief Global index of the first row of the local block
+         */
+        std::size_t beginRow() const { return blockBegin(m_nrows, m_cols.size, m_cols.rank); }
+        /*!
+         *   \brief Global index of the first column of the local block
+         */
+        std::size_t beginCol() const { return blockBegin(m_ncols, m_rows.size, m_rows.rank); }
+        /*!
+         *   \brief The block of the matrix owned by the current process
+         */
+        const BlockMatrix<K>& block() const { return m_block; }
+        BlockMatrix<K>& block() { return m_block; }
+        /*!
+         *   \brief The grid of processes
+         */
+        const CartesianCommunicator& grid() const { return m_grid; }
+        /*!
+         *   \brief The processes owning the blocks of the same row of blocks
+         *          ( the rank is the index of the block column )
+         */
+        const CartesianCommunicator& rowCommunicator() const { return m_rows; }
+        /*!
+         *   \brief The processes owning the blocks of the same column of blocks
+         *          ( the rank is the index of the block row )
+         */
+        const CartesianCommunicator& colCommunicator() const { return m_cols; }
+        /*!
+         *   \brief Size of the block iBlock when n indices are split in nbBlocks blocks
+         */
+        static std::size_t blockSize( std::size_t n, int nbBlocks, int iBlock )
+        {
+            return n/nbBlocks + ( std::size_t(iBlock) < n%nbBlocks ? 1 : 0 );
+        }
+        /*!
+         *   \brief First index of the block iBlock when n indices are split in nbBlocks blocks
+         */
+        static std::size_t blockBegin( std::size_t n, int nbBlocks, int iBlock )
+        {
+            return iBlock*(n/nbBlocks) + std::min( std::size_t(iBlock), n%nbBlocks );
+        }
+    private:
+        CartesianCommunicator m_grid, m_rows, m_cols;
+        std::size_t    m_nrows, m_ncols;
+        BlockMatrix<K> m_block;
+    };
+    // =================================================================
+    /*!
+     *   \brief Product of matrices on the current process : C = alpha.A.B + beta.C ( see local_gemm )
+     */
+    template<typename K> void
+    gemm( const K& alpha, const BlockMatrix<K>& A, const BlockMatrix<K>& B,
+          const K& beta, BlockMatrix<K>& C, int nbThreads = gemmThreads() )
+    {
+        assert( A.getNCols() == B.getNRows() );
+        assert( A.getNRows() == C.getNRows() && B.getNCols() == C.getNCols() );
+        if ( beta != K(1) )
+            for ( K& coef : C ) coef *= beta;
+        local_gemm( C.getNRows(), C.getNCols(), A.getNCols(), alpha, A.data(), A.getNRows(),
+                    B.data(), B.getNRows(), C.data(), C.getNRows(), nbThreads );
+    }
+    // -----------------------------------------------------------------
+    /*!
+     *   \brief Parallel product of distributed matrices : C = alpha.A.B + beta.C ( collective call )
+     *
+     *   SUMMA algorithm : at step k, the blocks of the k-th column of blocks of A are broadcasted
+     *   along the rows of the grid, the blocks of the k-th row of blocks of B along the columns,
+     *   and each process adds the product of the received blocks to its block of C. The
+     *   broadcasts are non blocking and double buffered : the blocks of step k+1 are in flight
+     *   while the blocks of step k are multiplied.
+     *
+     *   The three matrices must be distributed on the same grid, with compatible dimensions.
+     */
+    template<typename K> void
+    gemm( const K& alpha, const DistributedMatrix<K>& A, const DistributedMatrix<K>& B,
+          const K& beta, DistributedMatrix<K>& C )
+    {
+        assert( A.nbCols() == B.nbRows() );
+        assert( A.nbRows() == C.nbRows() && B.nbCols() == C.nbCols() );
+        const CartesianCommunicator& rows = A.rowCommunicator();
+        const CartesianCommunicator& cols = B.colCommunicator();
+        BlockMatrix<K>& Cblock = C.block();
+        const std::size_t m = Cblock.getNRows(), n = Cblock.getNCols();
+        if ( beta != K(1) )
+            for ( K& coef : Cblock ) coef *= beta;
+        // Two buffers per matrix : the step k uses the buffers k%2
+        std::array<std::vector<K>,2> Apanel, Bpanel;
+        std::array<std::array<Request,2>,2> pending;
+        const int nbSteps = rows.size;
+        auto start = [&] ( int step ) {
+            const int buf = step%2;
+            const std::size_t kk = DistributedMatrix<K>::blockSize( A.nbCols(), nbSteps, step );
+            Apanel[buf].resize( m*kk );
+            Bpanel[buf].resize( kk*n );
+            pending[buf][0] = rows.ibcast( Apanel[buf].size(), A.block().data(), Apanel[buf].data(), step );
+            pending[buf][1] = cols.ibcast( Bpanel[buf].size(), B.block().data(), Bpanel[buf].data(), step );
+        };
+        start( 0 );
+        for ( int step = 0; step < nbSteps; ++step ) {
+            if ( step + 1 < nbSteps ) start( step + 1 );
+            const int buf = step%2;
+            pending[buf][0].wait();
+            pending[buf][1].wait();
+            const std::size_t kk = DistributedMatrix<K>::blockSize( A.nbCols(), nbSteps, step );
+            local_gemm( m, n, kk, alpha, Apanel[buf].data(), m, Bpanel[buf].data(), kk,
+                        Cblock.data(), m );
+        }
+    }
+}
+
+#endif
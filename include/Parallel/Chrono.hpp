@@ -11,16 +11,159 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+/**
+ *    \file    Chrono.hpp
+ *    \brief   Timers of nested regions of the program and their statistics on the processes
+ */
 #ifndef _PARALLEL_CHRONO_HPP_
 # define _PARALLEL_CHRONO_HPP_
+# include <chrono>
+# include <string>
+# include <vector>
+# include "Parallel/Trace.hpp"
 
 namespace Parallel
 {
+    class Communicator;
+    /*!   \class TimerLog
+     *    \brief Call tree of the timed regions of a process
+     *
+     *    A region is timed by a Scope object ( see the TimeRegion macro ) : the
+     *    time between its construction and its destruction is added to the region.
+     *    The regions opened while a region is running are its children, so the same
+     *    name can be timed in several places of the call tree. The clock is the
+     *    steady clock and the region is found by comparing the address of its name
+     *    first, so the cost of a timed region is about two readings of the clock.
+     *
+     *    \code
+     *    {
+     *        TimeRegion("solver");
+     *        for ( int it = 0; it < nbIter; ++it ) {
+     *            TimeRegion("product");
+     *            ...
+     *        }
+     *    }
+     *    \endcode
+     *
+     *    The timers of the context ( Context::timers ) are reported at the destruction
+     *    of the context. When the tracer is enabled, the regions are also traced.
+     *    A TimerLog must be used by one thread only.
+     */
     class TimerLog
     {
     public:
+        typedef std::chrono::steady_clock clock;
+        /*!
+         *   \brief Time the region name until the destruction of the scope
+         *
+         *   The name must not contain '/', tabulations or new lines and must live until
+         *   the end of the scope ( a string literal by example ).
+         */
+        class Scope
+        {
+        public:
+            Scope( TimerLog& log, const char* name ) :
+                m_log(log), m_tracer( Tracer::current().isEnabled() ? &Tracer::current() : nullptr )
+            {
+                m_log.enter(name);
+                if ( m_tracer != nullptr ) m_tracer->begin( m_log.m_nodes[m_log.m_current].label );
+                m_start = clock::now();
+            }
+            Scope( const Scope& ) = delete;
+            ~Scope()
+            {
+                if ( m_tracer != nullptr ) m_tracer->end( m_log.m_nodes[m_log.m_current].label );
+                m_log.leave( clock::now() - m_start );
+            }
+            Scope& operator = ( const Scope& ) = delete;
+        private:
+            TimerLog&         m_log;
+            Tracer*           m_tracer;
+            clock::time_point m_start;
+        };
 
+        TimerLog();
+        TimerLog( const TimerLog& ) = delete;
+        TimerLog& operator = ( const TimerLog& ) = delete;
+        /*!
+         *   \brief Open the region name inside the current region
+         */
+        void enter( const char* name )
+        {
+            for ( int child : m_nodes[m_current].children )
+                if ( m_nodes[child].key == name ) {
+                    m_current = child;
+                    return;
+                }
+            m_current = findOrAddNode( name );
+        }
+        /*!
+         *   \brief Close the current region, which ran during elapsed
+         */
+        void leave( clock::duration elapsed )
+        {
+            Node& node = m_nodes[m_current];
+            node.elapsed += elapsed;
+            node.calls   += 1;
+            m_current     = node.parent;
+        }
+        /*!
+         *   \brief Return true if no region was timed
+         */
+        bool empty() const { return m_nodes.size() == 1; }
+        /*!
+         *   \brief Forget all the regions ( no region must be running )
+         */
+        void clear();
+        /*!
+         *   \brief Time spent in a region ( in seconds )
+         *
+         *   \param path The names of the region and of its parents, separated by '/'
+         *               ( "solver/product" by example ). 0 if the region was never timed.
+         */
+        double seconds( const std::string& path ) const;
+        /*!
+         *   \brief Number of times a region was timed ( see seconds for path )
+         */
+        std::size_t calls( const std::string& path ) const;
+        /*!
+         *   \brief Statistics of the regions on the processes of com ( collective call )
+         *
+         *   For each region of the call tree of any process : the total number of calls,
+         *   the minimum, mean and maximum times on the processes ( a process which never
+         *   entered the region counts for zero ), the rank of the slowest process and the
+         *   imbalance ( max/mean - 1 ).
+         *
+         *   \return The table of the statistics on the root process, an empty string on
+         *           the other processes or if no process timed a region.
+         */
+        std::string report( const Communicator& com, int root = 0 ) const;
+    private:
+        struct Node
+        {
+            const char*     key;
+            std::string     name;
+            const char*     label; // The name living until the end of the program, for the tracer
+            int             parent;
+            std::vector<int> children;
+            std::size_t     calls;
+            clock::duration elapsed;
+        };
+        // Same name at another address, or new region :
+        int findOrAddNode( const char* name );
+        int find( const std::string& path ) const;
+
+        std::vector<Node> m_nodes; // The node 0 is the root of the call tree
+        int m_current;
     };
 }
 
+# define PARALLEL_CONCATENATE_( a, b ) a##b
+# define PARALLEL_CONCATENATE( a, b ) PARALLEL_CONCATENATE_( a, b )
+/*!
+ *   \brief Time the region name with the timers of the context until the end of the current block
+ */
+# define TimeRegion( name ) \
+    Parallel::TimerLog::Scope PARALLEL_CONCATENATE( parallel_region_, __LINE__ )( Parallel::Context::timers, name )
+
 #endif
@@ -22,10 +22,12 @@
  */#ifndef _PARALLEL_COMMUNICATOR_HPP_
 # define _PARALLEL_COMMUNICATOR_HPP_
 # include <functional>
+# include <memory>
 # include <vector>
 # include <cstdlib>
 # include "Parallel/Status.hpp"
 # include "Parallel/Request.hpp"
+# include "Parallel/StridedView.hpp"
 namespace Parallel
 {
     /*!   \class Communicator
@@ -43,6 +45,10 @@ namespace Parallel
      *    Probably than future versions of the library will provide other
      *    services to create new groups.
      *
+     *    An instance is a light handle on a reference counted communicator :
+     *    copying or moving an instance is cheap and the copies share the same
+     *    communication context. Use duplicate to get a new communication context.
+     *
      */
     class Communicator
     {
@@ -51,7 +57,9 @@ namespace Parallel
          *   \brief Default constructor : instance a global communicator
          *
          *   The default constructor build an instance which contains all
-         *   processes executed for the parallel session.
+         *   processes executed for the parallel session. The instance shares
+         *   the communication context of world(), so the construction costs
+         *   neither a collective call nor an allocation.
          */
         Communicator();
         /*!
@@ -80,6 +88,25 @@ namespace Parallel
          *
          */
         Communicator( const Communicator& com, int color, int key );
+        /*!
+         *   \brief Kind of split of a communicator done by the underlying library
+         */
+        enum split_type {
+            shared_memory /*!< One communicator per group of processes sharing the memory ( node ) */
+        };
+        /*!
+         *   \brief Split a communicator according to the hardware
+         *
+         *   With shared_memory, the new communicator contains the processes of
+         *   com which can share memory with the current process ( the processes
+         *   of the same node ).
+         *
+         *   \param com  The communicator to split
+         *   \param type The kind of split
+         *   \param key  Determines the ordering ( rank ) within each new communicator
+         *               ( as for the split with a color )
+         */
+        Communicator( const Communicator& com, split_type type, int key = 0 );
         /*!
          *  \brief Convert a communicator coming from external library used
          *         for Parallel library in Parallel communicator.
@@ -89,29 +116,75 @@ namespace Parallel
          */
         Communicator( const Ext_Communicator& com );
         /*!
-         *   \brief Duplicate a communicator in a new instance.
+         *   \brief Copy a communicator handle
          *
-         *   This constructor is used to create a new communicator that has a new
-         *   communication context but contains the same group of processes
-         *   as the input communicator.
+         *   The copy shares the communication context of com : no collective call
+         *   is done. The communication context is freed with the last copy.
          *
-         *   \param com Communicator to be duplicated
+         *   \param com Communicator to be shared
          */
-        Communicator( const Communicator& com );
+        Communicator( const Communicator& com ) = default;
+        /*!
+         *   \brief Move a communicator handle
+         *
+         *   The moved communicator com can only be destroyed or assigned after the move.
+         */
+        Communicator( Communicator&& com );
+        /*!
+         *    Destructor. Destroy the communicator in the parallel context
+         *    if this instance is the last one sharing it.
+         */
+        ~Communicator() = default;
 
-        Communicator( Communicator&& com ) = delete;
+        Communicator& operator = ( const Communicator& com ) = default;
+        Communicator& operator = ( Communicator&& com );
+        /*!
+         *   \brief Duplicate a communicator in a new instance ( collective call )
+         *
+         *   Create a new communicator that has a new communication context but
+         *   contains the same group of processes as this communicator. The
+         *   messages of the two communicators never match.
+         */
+        Communicator duplicate() const;
         /*!
-         *    Destructor. Destroy the communicator in the parallel context.
+         *   \brief The global communicator containing all processes of the parallel session
+         *
+         *   The instance is created once ( the first call is collective ) and kept until
+         *   the destruction of the parallel context. Without MPI, each simulated process
+         *   has its own instance.
          */
-        ~Communicator();
+        static const Communicator& world();
 
-        Communicator& operator = ( const Communicator& com ) = delete;
-        Communicator& operator = ( Communicator&& com ) = delete;
+        /*!
+         *   \brief Rank in the world communicator of the process of rank rank in this communicator
+         */
+        int worldRank( int rank ) const;
 
         int rank; /*!< Rank of the current process inside the communicator instance */
         int size; /*!< Size of the communicator instance ( a.k.a number of processes
                        included in the communicator ) */
 
+        /*!
+         *    \brief Choose node aware collective operations for this communicator
+         *
+         *    When enabled, bcast, reduce and allreduce are done in two levels : inside
+         *    each node with a communicator of the processes sharing the memory, and
+         *    between the nodes with a communicator of one leader process per node.
+         *    Reductions use the two levels only with commutative operations. The
+         *    other collective operations and the duplicated communicators are not
+         *    concerned, but the copies sharing this communicator are ( as all the
+         *    default constructed communicators for world ). This is a collective
+         *    call ( the first time the hierarchy is built ).
+         *
+         *    \param hierarchical True to use node aware collective operations,
+         *                        false to use the flat ones ( by default )
+         */
+        void setHierarchical( bool hierarchical );
+        /*!
+         *    \brief Return true if the node aware collective operations are used
+         */
+        bool isHierarchical() const;
+
         /*!
          *    \brief Perform a blocking send to send an object to another process
          *
@@ -121,7 +194,11 @@ namespace Parallel
          *    small objects.
          *
          *    NB : For a container, the send method send the data contained in the
-         *         container... ( only vector now but other later )
+         *         container. The data of a contiguous container ( vector, array,
+         *         string, ... ) are sended without copy. A StridedView is sended
+         *         without copy too, the blocks being gathered by the parallel library.
+         *         A std::valarray isn't seen as a container ( it has no begin() and
+         *         end() members ) : send its elements as a buffer, with v.size() and &v[0].
          *
          *    \param obj  The object to send
          *    \param dest The rank of the destination
@@ -227,6 +304,52 @@ namespace Parallel
          *    \return        The request object associated at the receive message.
          */
         template<typename K> Request irecv( std::size_t nbItems, K* obj, int sender, int tag = any_tag ) const;
+        /*!
+         *    \brief Create a persistent send request for an object
+         *
+         *    The request is created inactive and the communication is done each time
+         *    the request is started ( with Request::start or RequestSet::startAll ) and
+         *    completed. The sended object must stay alive ( and a vector mustn't be
+         *    reallocated ) while the request is used. The size of a sended container
+         *    is fixed at the creation of the request.
+         *
+         *    \param obj  The object to send
+         *    \param dest The destination rank
+         *    \param tag  The message tag
+         *    \return     The inactive persistent request
+         */
+        template<typename K> Request send_init( const K& obj, int dest, int tag = 0 ) const;
+        /*!
+         *    \brief Create a persistent send request for a buffer of objects
+         *
+         *    \param nbItems The number of items stored in the buffer
+         *    \param obj     The buffer to send
+         *    \param dest    The destination rank
+         *    \param tag     The message tag
+         *    \return        The inactive persistent request
+         */
+        template<typename K> Request send_init( std::size_t nbItems, const K* obj, int dest, int tag = 0 ) const;
+        /*!
+         *    \brief Create a persistent receive request for an object
+         *
+         *    A receiving container must have the size of the message before the call.
+         *
+         *    \param obj    The receive object
+         *    \param sender Rank of the source
+         *    \param tag    Message tag.
+         *    \return       The inactive persistent request
+         */
+        template<typename K> Request recv_init( K& obj, int sender, int tag = any_tag ) const;
+        /*!
+         *    \brief Create a persistent receive request for a buffer of objects
+         *
+         *    \param nbItems Number of item to receive into the buffer
+         *    \param obj     The receive buffer
+         *    \param sender  Rank of the source
+         *    \param tag     Message tag.
+         *    \return        The inactive persistent request
+         */
+        template<typename K> Request recv_init( std::size_t nbItems, K* obj, int sender, int tag = any_tag ) const;
         /*!
          *    \brief Perform a broadcast from a process to other processes.
          *
@@ -273,6 +396,55 @@ namespace Parallel
          *    \param root  The rank of the root process
          */
         template<typename K> void bcast( std::size_t nbObjs, K* b_rcv, int root = 0 ) const;
+        /*!
+         *    \brief Shape of the pipeline of the segmented collective operations
+         */
+        enum pipeline_type {
+            chain,      /*!< Each process forwards the segments to the next process */
+            binary_tree /*!< Each process forwards the segments to two processes */
+        };
+        /*!
+         *    \brief Function called for each segment of a segmented collective operation
+         *           with the index of the first object of the segment and the number of
+         *           objects of the segment
+         */
+        typedef std::function<void(std::size_t, std::size_t)> SegmentCallback;
+        /*!
+         *    \brief Broadcast a large buffer by segments pipelined along a chain or a binary tree
+         *
+         *    The buffer is split in segments of segmentSize objects. Each process forwards a
+         *    segment as soon as it is received, so the segments flow along the pipeline
+         *    together. The callback is called on each process, in the order of the segments,
+         *    as soon as a segment is available in b_rcv : the computation can use the
+         *    beginning of the buffer while the end is still sended.
+         *
+         *    The segments are exchanged by point to point messages with the tag segment_tag
+         *    which must not be used by other messages pending on this communicator.
+         *
+         *    \code
+         *    com.segmented_bcast( n, a, a, root, 4096, Parallel::Communicator::binary_tree,
+         *                         [&] ( std::size_t first, std::size_t count ) {
+         *                           compute( a + first, count );
+         *                         } );
+         *    \endcode
+         *
+         *    \param nbObjs      Number of objects to broadcast
+         *    \param b_snd       The buffer to broadcast ( significant only on root process )
+         *    \param b_rcv       The buffer receiving the objects ( can be b_snd on root process )
+         *    \param root        The rank of the root process
+         *    \param segmentSize The number of objects of each segment
+         *    \param pipeline    The shape of the pipeline : a chain suits large buffers and
+         *                       few processes, a binary tree many processes
+         *    \param onSegment   Called for each available segment ( may be empty )
+         */
+        template<typename K> void
+        segmented_bcast( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root,
+                         std::size_t segmentSize, pipeline_type pipeline = chain,
+                         const SegmentCallback& onSegment = SegmentCallback() ) const;
+        /*!
+         *    \brief Tag of the messages of the segmented collective operations
+         */
+        static constexpr int segment_tag = 32767;
         /*!
          *    \brief Blocks until all processor inside the communicator have reached this routine.
          *
@@ -474,10 +646,566 @@ namespace Parallel
           template<typename K, typename Func>
           void reduce( std::size_t nbObjs, const K* b_objs,
                        const Func& op, bool is_commutable, int root = 0 ) const;
+         /*!
+          *   \brief Reduce large buffers by segments pipelined along a chain or a binary tree
+          *
+          *   Each process reduces a segment received from its children with its own
+          *   contribution and forwards the partial result to its parent as soon as it is done,
+          *   so the reductions of successive segments overlap. The callback is called on the
+          *   root process, in the order of the segments, as soon as a segment of b_res holds
+          *   the final result. A non commutative operation ( an Operator created as non
+          *   commutative ) is done by reduce(), the callback being called for all the
+          *   segments at the end.
+          *
+          *   The segments are exchanged by point to point messages with the tag segment_tag.
+          *
+          *   \param nbObjs      The number of objects of the buffers
+          *   \param b_objs      A buffer used in the reduction operation
+          *   \param b_res       The result buffer computed in the root process ( significant only on
+          *                      root process, can be b_objs )
+          *   \param op          The pre-defined operation to do in the reduction operation
+          *   \param root        The rank of the process where store the result of the reduction operation
+          *   \param segmentSize The number of objects of each segment
+          *   \param pipeline    The shape of the pipeline
+          *   \param onSegment   Called on root for each reduced segment ( may be empty )
+          */
+          template<typename K> void
+          segmented_reduce( std::size_t nbObjs, const K* b_objs, K* b_res, Operation op, int root,
+                            std::size_t segmentSize, pipeline_type pipeline = chain,
+                            const SegmentCallback& onSegment = SegmentCallback() ) const;
+          // ===================================================================
+         /*!
+          *   \brief Reduce values on all processes and distribute the result to all processes
+          *
+          *   This method performs a global reduce operation ( such as sum, max, logical AND, etc. ) across all members of the
+          *   current communicator and returns the combined value on all processes. If \ref obj is a container, the reduction
+          *   is done element by element and \ref res is resized to the size of \ref obj.
+          *
+          *   \param obj   An object ( or a container ) used in the reduction operation
+          *   \param res   The result object ( or container ) computed on all processes. Can be the same object than \ref obj
+          *   \param op    The pre-defined operation to do in the reduction operation
+          */
+          template<typename K> void
+          allreduce( const K& obj, K& res, const Operation& op ) const;
+         /*!
+          *   \brief Reduce values on all processes and distribute the result to all processes
+          *
+          *   \param nbObjs The number of items stored in the local buffer.
+          *   \param b_objs A buffer used in the reduction operation
+          *   \param b_res  The result buffer computed on all processes ( can be the same buffer than \ref b_objs )
+          *   \param op     The pre-defined operation to do in the reduction operation
+          */
+          template<typename K> void
+          allreduce( std::size_t nbObjs, const K* b_objs, K* b_res, Operation op ) const;
+         /*!
+          *   \brief Reduce values on all processes with a user functor and distribute the result to all processes
+          *
+          *   \param obj           An object used in the reduction operation
+          *   \param res           The result object computed on all processes
+          *   \param op            An functor on two objects
+          *   \param is_commutable A boolean to say if the function as commutable parameters ( a.k.a op(x,y) = op(y,x) )
+          */
+          template<typename K, typename Func> void
+          allreduce( const K& obj, K& res, const Func& op, bool is_commutable = false ) const;
+         /*!
+          *   \brief Reduce vectors element by element with a user functor and distribute the result to all processes
+          *
+          *   \param obj           A vector used in the reduction operation
+          *   \param res           The result vector computed on all processes
+          *   \param op            An functor on two objects
+          *   \param is_commutable A boolean to say if the function as commutable parameters ( a.k.a op(x,y) = op(y,x) )
+          */
+          template<typename K, typename Func> void
+          allreduce( const std::vector<K>& obj, std::vector<K>& res,
+                     const Func& op, bool is_commutable ) const;
+         /*!
+          *   \brief Reduce buffers element by element with a user functor and distribute the result to all processes
+          *
+          *   \param nbObjs        The number of the objects in the buffer
+          *   \param b_objs        A buffer used in the reduction operation
+          *   \param b_res         The result buffer computed on all processes
+          *   \param op            An functor on two objects
+          *   \param is_commutable A boolean to say if the function as commutable parameters ( a.k.a op(x,y) = op(y,x) )
+          */
+          template<typename K, typename Func> void
+          allreduce( std::size_t nbObjs, const K* b_objs, K* b_res,
+                     const Func& op, bool is_commutable ) const;
+          // -----------------------------------------------------------
+         /*!
+          *   \brief Gather one object from each process and distribute the gathered objects to all processes
+          *
+          *   \param obj The object sended by the current process
+          *   \param res The vector receiving the objects ( sorted by rank ) on all processes
+          */
+          template<typename K> void allgather( const K& obj, std::vector<K>& res ) const;
+         /*!
+          *   \brief Gather containers of same size from each process and distribute the concatenation
+          *          to all processes
+          *
+          *   \param obj The container sended by the current process
+          *   \param res The container receiving the concatenation ( by rank order ) of the containers
+          */
+          template<typename K> void allgather( const K& obj, K& res ) const;
+         /*!
+          *   \brief Gather buffers of same size from each process and distribute the concatenation
+          *          to all processes
+          *
+          *   \param nbObjs Number of objects sended by each process
+          *   \param b_snd  The buffer sended by the current process
+          *   \param b_rcv  The buffer receiving nbObjs*size objects ( must be allocated before the call )
+          */
+          template<typename K> void allgather( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *   \brief Gather containers of different sizes from each process and distribute the
+          *          concatenation to all processes
+          *
+          *   \param obj The container sended by the current process
+          *   \param res The container receiving the concatenation ( by rank order ) of the containers
+          */
+          template<typename K> void allgatherv( const K& obj, K& res ) const;
+         /*!
+          *   \brief Gather containers of different sizes from each process and distribute the
+          *          concatenation to all processes
+          *
+          *   \param obj    The container sended by the current process
+          *   \param res    The container receiving the concatenation ( by rank order ) of the containers
+          *   \param counts Returns the number of objects sended by each process
+          */
+          template<typename K> void allgatherv( const K& obj, K& res, std::vector<int>& counts ) const;
+         /*!
+          *   \brief Gather buffers of different sizes from each process and distribute the
+          *          concatenation to all processes
+          *
+          *   \param nbObjs Number of objects sended by the current process
+          *   \param b_snd  The buffer sended by the current process
+          *   \param counts Number of objects sended by each process
+          *   \param b_rcv  The buffer receiving the concatenation ( must be allocated before the call )
+          */
+          template<typename K> void allgatherv( std::size_t nbObjs, const K* b_snd,
+                                                const std::vector<int>& counts, K* b_rcv ) const;
+          // -----------------------------------------------------------
+         /*!
+          *   \brief Gather one object from each process on the root process
+          *
+          *   \param obj  The object sended by the current process
+          *   \param res  The vector receiving the objects ( significant only on root process )
+          *   \param root The rank of the process receiving the objects
+          */
+          template<typename K> void gather( const K& obj, std::vector<K>& res, int root = 0 ) const;
+         /*!
+          *   \brief Gather containers of same size from each process on the root process
+          *
+          *   \param obj  The container sended by the current process
+          *   \param res  The container receiving the concatenation of the containers ( significant only on root process )
+          *   \param root The rank of the process receiving the containers
+          */
+          template<typename K> void gather( const K& obj, K& res, int root = 0 ) const;
+         /*!
+          *   \brief Gather buffers of same size from each process on the root process
+          *
+          *   \param nbObjs Number of objects sended by each process
+          *   \param b_snd  The buffer sended by the current process
+          *   \param b_rcv  The buffer receiving nbObjs*size objects ( significant only on root process )
+          *   \param root   The rank of the process receiving the buffers
+          */
+          template<typename K> void gather( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root = 0 ) const;
+         /*!
+          *   \brief Gather containers of different sizes from each process on the root process
+          *
+          *   \param obj  The container sended by the current process
+          *   \param res  The container receiving the concatenation of the containers ( significant only on root process )
+          *   \param root The rank of the process receiving the containers
+          */
+          template<typename K> void gatherv( const K& obj, K& res, int root = 0 ) const;
+         /*!
+          *   \brief Gather buffers of different sizes from each process on the root process
+          *
+          *   \param nbObjs Number of objects sended by the current process
+          *   \param b_snd  The buffer sended by the current process
+          *   \param counts Number of objects sended by each process ( significant only on root process )
+          *   \param b_rcv  The buffer receiving the concatenation ( significant only on root process )
+          *   \param root   The rank of the process receiving the buffers
+          */
+          template<typename K> void gatherv( std::size_t nbObjs, const K* b_snd,
+                                             const std::vector<int>& counts, K* b_rcv, int root = 0 ) const;
+          // -----------------------------------------------------------
+         /*!
+          *   \brief Scatter a vector of objects from the root process : each process receives one object
+          *
+          *   \param objs The objects to scatter ( significant only on root process )
+          *   \param res  The object received by the current process
+          *   \param root The rank of the process sending the objects
+          */
+          template<typename K> void scatter( const std::vector<K>& objs, K& res, int root = 0 ) const;
+         /*!
+          *   \brief Scatter a container from the root process by chunks of same size
+          *
+          *   Each process receives res.size() objects, so the receiving container must have
+          *   the right size before the call.
+          *
+          *   \param objs The container to scatter ( significant only on root process )
+          *   \param res  The container receiving the chunk of the current process
+          *   \param root The rank of the process sending the container
+          */
+          template<typename K> void scatter( const K& objs, K& res, int root = 0 ) const;
+         /*!
+          *   \brief Scatter a buffer from the root process by chunks of same size
+          *
+          *   \param nbObjs Number of objects received by each process
+          *   \param b_snd  The buffer to scatter ( significant only on root process )
+          *   \param b_rcv  The buffer receiving nbObjs objects
+          *   \param root   The rank of the process sending the buffer
+          */
+          template<typename K> void scatter( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root = 0 ) const;
+         /*!
+          *   \brief Scatter a container from the root process by chunks of different sizes
+          *
+          *   \param objs   The container to scatter ( significant only on root process )
+          *   \param counts Number of objects sended to each process ( significant only on root process )
+          *   \param res    The container receiving the chunk of the current process ( resized if needed )
+          *   \param root   The rank of the process sending the container
+          */
+          template<typename K> void scatterv( const K& objs, const std::vector<int>& counts,
+                                              K& res, int root = 0 ) const;
+         /*!
+          *   \brief Scatter a buffer from the root process by chunks of different sizes
+          *
+          *   \param b_snd  The buffer to scatter ( significant only on root process )
+          *   \param counts Number of objects sended to each process ( significant only on root process )
+          *   \param nbObjs Number of objects received by the current process
+          *   \param b_rcv  The buffer receiving the chunk of the current process
+          *   \param root   The rank of the process sending the buffer
+          */
+          template<typename K> void scatterv( const K* b_snd, const std::vector<int>& counts,
+                                              std::size_t nbObjs, K* b_rcv, int root = 0 ) const;
+          // -----------------------------------------------------------
+         /*!
+          *   \brief Each process sends a distinct chunk of same size to each process
+          *
+          *   The size of the sended container must be a multiple of the communicator size.
+          *   The chunk i of the container is sended to the process of rank i.
+          *
+          *   \param snd The container to send
+          *   \param rcv The container receiving the chunks ( sorted by rank of the sender )
+          */
+          template<typename K> void alltoall( const K& snd, K& rcv ) const;
+         /*!
+          *   \brief Each process sends a distinct chunk of same size to each process
+          *
+          *   \param nbObjs Number of objects sended to each process
+          *   \param b_snd  The buffer to send ( nbObjs*size objects )
+          *   \param b_rcv  The buffer receiving nbObjs*size objects ( can be the same than \ref b_snd )
+          */
+          template<typename K> void alltoall( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *   \brief Each process sends a distinct chunk of different size to each process
+          *
+          *   \param snd       The container to send
+          *   \param sndCounts Number of objects sended to each process
+          *   \param rcv       The container receiving the chunks ( resized if needed )
+          *   \param rcvCounts Returns the number of objects received from each process
+          */
+          template<typename K> void alltoallv( const K& snd, const std::vector<int>& sndCounts,
+                                               K& rcv, std::vector<int>& rcvCounts ) const;
+         /*!
+          *   \brief Each process sends a distinct chunk of different size to each process
+          *
+          *   \param b_snd     The buffer to send
+          *   \param sndCounts Number of objects sended to each process
+          *   \param b_rcv     The buffer receiving the chunks ( must be allocated before the call )
+          *   \param rcvCounts Number of objects received from each process
+          */
+          template<typename K> void alltoallv( const K* b_snd, const std::vector<int>& sndCounts,
+                                               K* b_rcv, const std::vector<int>& rcvCounts ) const;
+          // ===================================================================
+          // Neighborhood collective operations :
+          //   The communicator must have a topology ( CartesianCommunicator or GraphCommunicator ).
+          //   Each process exchanges only with its neighbors : it receives from its sources and
+          //   sends to its destinations, in the order given by neighborSources() and
+          //   neighborDestinations(). For a Cartesian topology, the neighbors of each dimension
+          //   are the process in the negative direction then the process in the positive
+          //   direction ( no_process on the boundaries of a non periodic dimension ).
+          // ===================================================================
+         /*!
+          *   \brief Ranks of the processes sending data to the current process in the neighborhood
+          *          collective operations
+          */
+          std::vector<int> neighborSources() const;
+         /*!
+          *   \brief Ranks of the processes receiving data from the current process in the
+          *          neighborhood collective operations
+          */
+          std::vector<int> neighborDestinations() const;
+         /*!
+          *   \brief Gather one object from each source neighbor
+          *
+          *   \param obj The object sended to all the destinations
+          *   \param res The vector receiving the objects ( in the order of the sources )
+          */
+          template<typename K> void neighbor_allgather( const K& obj, std::vector<K>& res ) const;
+         /*!
+          *   \brief Gather buffers of same size from each source neighbor
+          *
+          *   \param nbObjs Number of objects sended to each destination
+          *   \param b_snd  The buffer sended to all the destinations
+          *   \param b_rcv  The buffer receiving nbObjs objects per source ( must be allocated before the call )
+          */
+          template<typename K> void neighbor_allgather( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *   \brief Each process sends a distinct chunk of same size to each destination neighbor
+          *
+          *   The size of the sended container must be a multiple of the number of destinations.
+          *
+          *   \param snd The container to send ( chunk i is sended to the destination i )
+          *   \param rcv The container receiving the chunks ( in the order of the sources )
+          */
+          template<typename K> void neighbor_alltoall( const K& snd, K& rcv ) const;
+         /*!
+          *   \brief Each process sends a distinct chunk of same size to each destination neighbor
+          *
+          *   \param nbObjs Number of objects sended to each destination
+          *   \param b_snd  The buffer to send ( nbObjs objects per destination )
+          *   \param b_rcv  The buffer receiving nbObjs objects per source
+          */
+          template<typename K> void neighbor_alltoall( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *   \brief Each process sends a distinct chunk of different size to each destination neighbor
+          *
+          *   \param snd       The container to send
+          *   \param sndCounts Number of objects sended to each destination
+          *   \param rcv       The container receiving the chunks ( resized if needed )
+          *   \param rcvCounts Returns the number of objects received from each source
+          */
+          template<typename K> void neighbor_alltoallv( const K& snd, const std::vector<int>& sndCounts,
+                                                        K& rcv, std::vector<int>& rcvCounts ) const;
+         /*!
+          *   \brief Each process sends a distinct chunk of different size to each destination neighbor
+          *
+          *   \param b_snd     The buffer to send
+          *   \param sndCounts Number of objects sended to each destination
+          *   \param b_rcv     The buffer receiving the chunks ( must be allocated before the call )
+          *   \param rcvCounts Number of objects received from each source
+          */
+          template<typename K> void neighbor_alltoallv( const K* b_snd, const std::vector<int>& sndCounts,
+                                                        K* b_rcv, const std::vector<int>& rcvCounts ) const;
+          // ===================================================================
+          // Non blocking collective operations :
+          //   The returned request must be completed ( with test or wait ) before reading the
+          //   received objects or modifying the sended objects. The temporary buffers used
+          //   internally by the communication stay alive until the completion of the request.
+          // ===================================================================
+         /*!
+          *    \brief Start a non blocking broadcast from the root process to other processes.
+          *
+          *    For a container, the receiving container must have the right size on
+          *    the non root processes.
+          *
+          *    \param o_snd The object to broadcast.
+          *    \param o_rcv The object where receive the broadcasted object.
+          *    \param root  The rank of the root process
+          *    \return      The request object associated at the broadcast
+          */
+          template<typename K> Request ibcast( const K& o_snd, K& o_rcv, int root = 0 ) const;
+         /*!
+          *    \brief Start a non blocking broadcast. Don't call this method with the root process !
+          *
+          *    \param o_rcv The object where receive the broadcasted object.
+          *    \param root  The rank of the root process
+          *    \return      The request object associated at the broadcast
+          */
+          template<typename K> Request ibcast( K& o_rcv, int root = 0 ) const;
+         /*!
+          *    \brief Start a non blocking broadcast of a buffer from the root process to other processes.
+          *
+          *    \param nbObjs Number of items to broadcast.
+          *    \param b_snd  The buffer of objects to broadcast.
+          *    \param b_rcv  The buffer of objects where receive broadcasted objects ( must be allocated
+          *                  before the call of this method )
+          *    \param root   The rank of the root process
+          *    \return       The request object associated at the broadcast
+          */
+          template<typename K> Request ibcast( std::size_t nbObjs, const K* b_snd, K* b_rcv,
+                                               int root = 0 ) const;
+         /*!
+          *    \brief Start a non blocking broadcast of a buffer. Don't call this method with the root process !
+          *
+          *    \param nbObjs Number of items to broadcast.
+          *    \param b_rcv  The buffer of objects where receive broadcasted objects
+          *    \param root   The rank of the root process
+          *    \return       The request object associated at the broadcast
+          */
+          template<typename K> Request ibcast( std::size_t nbObjs, K* b_rcv, int root = 0 ) const;
+         /*!
+          *   \brief Start a non blocking reduction on the root process
+          *
+          *   \param obj   An object ( or a container ) used in the reduction operation
+          *   \param res   The result computed in the root process ( significant only on root process )
+          *   \param op    The pre-defined operation to do in the reduction operation
+          *   \param root  The rank of the process where store the result of the reduction operation
+          *   \return      The request object associated at the reduction
+          */
+          template<typename K> Request
+          ireduce( const K& obj, K& res, const Operation& op, int root = 0 ) const;
+         /*!
+          *   \brief Start a non blocking reduction of buffers on the root process
+          *
+          *   \param nbObjs The number of items stored in the local buffer.
+          *   \param b_objs A buffer used in the reduction operation
+          *   \param b_res  The result buffer computed in the root process ( significant only on root process )
+          *   \param op     The pre-defined operation to do in the reduction operation
+          *   \param root   The rank of the process where store the result of the reduction operation
+          *   \return       The request object associated at the reduction
+          */
+          template<typename K> Request
+          ireduce( std::size_t nbObjs, const K* b_objs, K* b_res, Operation op, int root = 0 ) const;
+         /*!
+          *   \brief Start a non blocking reduction with the result distributed to all processes
+          *
+          *   \param obj   An object ( or a container ) used in the reduction operation
+          *   \param res   The result computed on all processes
+          *   \param op    The pre-defined operation to do in the reduction operation
+          *   \return      The request object associated at the reduction
+          */
+          template<typename K> Request
+          iallreduce( const K& obj, K& res, const Operation& op ) const;
+         /*!
+          *   \brief Start a non blocking reduction of buffers with the result distributed to all processes
+          *
+          *   \param nbObjs The number of items stored in the local buffer.
+          *   \param b_objs A buffer used in the reduction operation
+          *   \param b_res  The result buffer computed on all processes
+          *   \param op     The pre-defined operation to do in the reduction operation
+          *   \return       The request object associated at the reduction
+          */
+          template<typename K> Request
+          iallreduce( std::size_t nbObjs, const K* b_objs, K* b_res, Operation op ) const;
+         /*!
+          *   \brief Start a non blocking gathering of one object per process on all processes
+          *
+          *   \param obj The object sended by the current process
+          *   \param res The vector receiving the objects ( sorted by rank )
+          *   \return    The request object associated at the gathering
+          */
+          template<typename K> Request iallgather( const K& obj, std::vector<K>& res ) const;
+         /*!
+          *   \brief Start a non blocking gathering of containers of same size on all processes
+          *
+          *   \param obj The container sended by the current process
+          *   \param res The container receiving the concatenation of the containers
+          *   \return    The request object associated at the gathering
+          */
+          template<typename K> Request iallgather( const K& obj, K& res ) const;
+         /*!
+          *   \brief Start a non blocking gathering of buffers of same size on all processes
+          *
+          *   \param nbObjs Number of objects sended by each process
+          *   \param b_snd  The buffer sended by the current process
+          *   \param b_rcv  The buffer receiving nbObjs*size objects
+          *   \return       The request object associated at the gathering
+          */
+          template<typename K> Request iallgather( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *   \brief Start a non blocking exchange of distinct chunks of same size between all processes
+          *
+          *   \param snd The container to send ( size multiple of the communicator size )
+          *   \param rcv The container receiving the chunks
+          *   \return    The request object associated at the exchange
+          */
+          template<typename K> Request ialltoall( const K& snd, K& rcv ) const;
+         /*!
+          *   \brief Start a non blocking exchange of distinct chunks of same size between all processes
+          *
+          *   \param nbObjs Number of objects sended to each process
+          *   \param b_snd  The buffer to send ( nbObjs*size objects )
+          *   \param b_rcv  The buffer receiving nbObjs*size objects ( different from \ref b_snd )
+          *   \return       The request object associated at the exchange
+          */
+          template<typename K> Request ialltoall( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *    \brief Start a non blocking barrier.
+          *
+          *    The request is completed when all processes of the communicator have called
+          *    this method.
+          */
+          Request ibarrier() const;
+          // ===================================================================
+          // Persistent collective operations :
+          //   The returned requests are inactive and can be started several times ( with
+          //   Request::start or RequestSet::startAll ). The buffers must stay alive while
+          //   the request is used. With MPI 4, the persistent collective operations of the
+          //   library are used, else they are emulated with the non blocking operations.
+          // ===================================================================
+         /*!
+          *    \brief Create a persistent broadcast of a buffer from the root process
+          *
+          *    \param nbObjs Number of items to broadcast.
+          *    \param b_snd  The buffer of objects to broadcast ( significant only on root process )
+          *    \param b_rcv  The buffer of objects where receive broadcasted objects
+          *    \param root   The rank of the root process
+          *    \return       The inactive persistent request
+          */
+          template<typename K> Request bcast_init( std::size_t nbObjs, const K* b_snd, K* b_rcv,
+                                                   int root = 0 ) const;
+         /*!
+          *   \brief Create a persistent reduction of buffers on the root process
+          *
+          *   \param nbObjs The number of items stored in the local buffer.
+          *   \param b_objs A buffer used in the reduction operation
+          *   \param b_res  The result buffer ( significant only on root process )
+          *   \param op     The pre-defined operation to do in the reduction operation
+          *   \param root   The rank of the process where store the result of the reduction operation
+          *   \return       The inactive persistent request
+          */
+          template<typename K> Request
+          reduce_init( std::size_t nbObjs, const K* b_objs, K* b_res, Operation op, int root = 0 ) const;
+         /*!
+          *   \brief Create a persistent reduction of buffers with the result distributed to all processes
+          *
+          *   \param nbObjs The number of items stored in the local buffer.
+          *   \param b_objs A buffer used in the reduction operation
+          *   \param b_res  The result buffer
+          *   \param op     The pre-defined operation to do in the reduction operation
+          *   \return       The inactive persistent request
+          */
+          template<typename K> Request
+          allreduce_init( std::size_t nbObjs, const K* b_objs, K* b_res, Operation op ) const;
+         /*!
+          *   \brief Create a persistent gathering of buffers of same size on all processes
+          *
+          *   \param nbObjs Number of objects sended by each process
+          *   \param b_snd  The buffer sended by the current process
+          *   \param b_rcv  The buffer receiving nbObjs*size objects
+          *   \return       The inactive persistent request
+          */
+          template<typename K> Request allgather_init( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *   \brief Create a persistent exchange of distinct chunks of same size between all processes
+          *
+          *   \param nbObjs Number of objects sended to each process
+          *   \param b_snd  The buffer to send ( nbObjs*size objects )
+          *   \param b_rcv  The buffer receiving nbObjs*size objects
+          *   \return       The inactive persistent request
+          */
+          template<typename K> Request alltoall_init( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const;
+         /*!
+          *    \brief Create a persistent barrier
+          */
+          Request barrier_init() const;
           // ===================================================================
     private:
+        template<typename K> friend class SharedArray;
+        template<typename K> friend class Window;
+        friend class CartesianCommunicator;
+        friend class GraphCommunicator;
+        friend class Context;
         struct Implementation;
-        Implementation* m_impl;
+        Communicator( Implementation* impl );
+        // Release the global communicator before the end of the parallel context
+        static void releaseWorld();
+        // Parent ( or no_process ) and children of the current process in a pipeline from root
+        void pipelineNeighbors( int root, pipeline_type pipeline, int& parent,
+                                std::vector<int>& children ) const;
+        std::shared_ptr<Implementation> m_impl;
     };
 }
 #endif
@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 // template for Communicator class
+# include <algorithm>
+# include <cassert>
 # include <iostream>
+# include <numeric>
+# include "Parallel/Profiler.hpp"
 # if defined(USE_MPI)
 #   include "Parallel/Communicator_mpi.tpp"
 # else
@@ -24,6 +28,7 @@ namespace Parallel
     template<typename K> void 
     Communicator::send( const K& obj, int dest, int tag ) const
     {
+        Profiler::Probe probe( *this, Profiler::send, dest, Profiler::bytes(obj) );
         m_impl->send(obj, dest, tag );
     }
     // .................................................................
@@ -31,79 +36,123 @@ namespace Parallel
     Communicator::send( std::size_t nbObjs, const K* buff, 
                         int dest, int tag ) const
     {
+        Profiler::Probe probe( *this, Profiler::send, dest, nbObjs*sizeof(K) );
         m_impl->send(nbObjs, buff, dest, tag);
     }
     // .................................................................
     template<typename K> Request
     Communicator::isend( const K& obj, int dest, int tag ) const
     {
+        Profiler::Probe probe( *this, Profiler::isend, dest, Profiler::bytes(obj) );
         return m_impl->isend( obj, dest, tag );
     }
     // .................................................................
     template<typename K> Request
     Communicator::isend( std::size_t nbItems, const K* obj, int dest, int tag ) const
     {
+        Profiler::Probe probe( *this, Profiler::isend, dest, nbItems*sizeof(K) );
         return m_impl->isend( nbItems, obj, dest, tag );
     }    
     // .................................................................
     template<typename K> Status 
     Communicator::recv( K& obj, int sender, int tag ) const
     {
-        return m_impl->recv( obj, sender, tag );
+        Profiler::Probe probe( *this, Profiler::recv, sender );
+        Status status = m_impl->recv( obj, sender, tag );
+        probe.setPeer( status.source() );
+        probe.setBytes( Profiler::bytes(obj) );
+        return status;
     }
     // .................................................................
     template<typename K> Status
     Communicator::recv( std::size_t nbObjs, K* buff, int sender, int tag ) const
     {
-        return m_impl->recv( nbObjs, buff, sender, tag );
+        Profiler::Probe probe( *this, Profiler::recv, sender, nbObjs*sizeof(K) );
+        Status status = m_impl->recv( nbObjs, buff, sender, tag );
+        probe.setPeer( status.source() );
+        return status;
     }
     // .................................................................
     template<typename K> Request 
     Communicator::irecv( K& obj, int sender, int tag ) const
     {
+        Profiler::Probe probe( *this, Profiler::irecv, sender, Profiler::bytes(obj) );
         return m_impl->irecv( obj, sender, tag );
     }
     // .................................................................
     template<typename K> Request
     Communicator::irecv( std::size_t nbObjs, K* buff, int sender, int tag ) const
     {
+        Profiler::Probe probe( *this, Profiler::irecv, sender, nbObjs*sizeof(K) );
         return m_impl->irecv( nbObjs, buff, sender, tag );
     }
+    // .................................................................
+    template<typename K> Request
+    Communicator::send_init( const K& obj, int dest, int tag ) const
+    {
+        return m_impl->send_init( obj, dest, tag );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::send_init( std::size_t nbItems, const K* obj, int dest, int tag ) const
+    {
+        return m_impl->send_init( nbItems, obj, dest, tag );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::recv_init( K& obj, int sender, int tag ) const
+    {
+        return m_impl->recv_init( obj, sender, tag );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::recv_init( std::size_t nbItems, K* obj, int sender, int tag ) const
+    {
+        return m_impl->recv_init( nbItems, obj, sender, tag );
+    }
     // =================================================================
     // Opérations collectives :
     template<typename K> void
     Communicator::bcast( const K& objsnd, K& objrcv, int root ) const
     {
+      Profiler::Probe probe( *this, Profiler::bcast, root );
       m_impl->broadcast( &objsnd, objrcv, root );
+      probe.setBytes( Profiler::bytes(objrcv) );
     }
     // .................................................................
     template<typename K> void
     Communicator::bcast( K& objrcv, int root ) const
     {
+      Profiler::Probe probe( *this, Profiler::bcast, root );
       m_impl->broadcast( static_cast<K*>(nullptr), objrcv, root );
+      probe.setBytes( Profiler::bytes(objrcv) );
     }
     // .................................................................
     template<typename K> void 
     Communicator::bcast( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::bcast, root, nbObjs*sizeof(K) );
         m_impl->broadcast(nbObjs, b_snd, b_rcv, root);
     }
     // .................................................................
     template<typename K> void 
     Communicator::bcast( std::size_t nbObjs, K* b_rcv, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::bcast, root, nbObjs*sizeof(K) );
         m_impl->broadcast(nbObjs, (const K*)nullptr, b_rcv, root);
     }
     // =================================================================
     template<typename K> void
     Communicator::reduce( const K& obj, K& res, const Operation& op, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, Profiler::bytes(obj) );
         m_impl->reduce(obj, &res, op, root );
     }
     // .................................................................
     template<typename K> void
     Communicator::reduce( const K& obj, const Operation& op, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, Profiler::bytes(obj) );
         assert(root != rank);
         m_impl->reduce(1, &obj, nullptr, op, root );
     }
@@ -112,6 +161,7 @@ namespace Parallel
     Communicator::reduce( const K& obj, K& res, const Func& op, 
                           bool commute, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, Profiler::bytes(obj) );
         m_impl->reduce(1, &obj, &res, op, commute, root );
     }
     // .................................................................
@@ -119,6 +169,7 @@ namespace Parallel
     Communicator::reduce( const K& obj, const Func& op, bool commute, 
                           int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, Profiler::bytes(obj) );
         assert(root != rank);
         m_impl->reduce(1, &obj, nullptr, op, commute, root );
     }
@@ -128,7 +179,8 @@ namespace Parallel
     Communicator::reduce( const std::vector<K>& obj, std::vector<K>& res,
                           const Func& op, bool commute, int root) const
     {
-        if ( res.size() < obj.data() ) {
+        Profiler::Probe probe( *this, Profiler::reduce, root, Profiler::bytes(obj) );
+        if ( res.size() < obj.size() ) {
             std::vector<K>(obj.size()).swap(res);
         }
         m_impl->reduce(obj.size(), obj.data(), res.data(), op, 
@@ -139,6 +191,7 @@ namespace Parallel
     Communicator::reduce( const std::vector<K>& obj, const Func& op,
                           bool commute, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, Profiler::bytes(obj) );
         assert(root != rank);
         m_impl->reduce(obj.size(), obj.data(), nullptr, op, 
                        commute, root );
@@ -148,6 +201,7 @@ namespace Parallel
     Communicator::reduce( std::size_t nbItems, const K* obj, K* res,
                           Operation op, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, nbItems*sizeof(K) );
         m_impl->reduce( nbItems, obj, res, op, root );
     }
     // .................................................................    
@@ -155,6 +209,7 @@ namespace Parallel
     Communicator::reduce( std::size_t nbItems, const K* obj,
                           Operation op, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, nbItems*sizeof(K) );
         assert(rank != root);
         m_impl->reduce( nbItems, obj, nullptr, op, root );
     }
@@ -163,6 +218,7 @@ namespace Parallel
     Communicator::reduce( std::size_t nbItems, const K* obj, K* res,
                           const Func& op, bool commute, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, nbItems*sizeof(K) );
         m_impl->reduce( nbItems, obj, res, op, commute, root );
     }
     // .................................................................
@@ -170,7 +226,458 @@ namespace Parallel
     Communicator::reduce( std::size_t nbItems, const K* obj,
                           const Func& op, bool commute, int root ) const
     {
+        Profiler::Probe probe( *this, Profiler::reduce, root, nbItems*sizeof(K) );
         assert(rank != root);
         m_impl->reduce( nbItems, obj, nullptr, op, commute, root );
     }
+    // =================================================================
+    template<typename K> void
+    Communicator::allreduce( const K& obj, K& res, const Operation& op ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allreduce, no_process, Profiler::bytes(obj) );
+        m_impl->allreduce( obj, res, op );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::allreduce( std::size_t nbItems, const K* obj, K* res,
+                             Operation op ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allreduce, no_process, nbItems*sizeof(K) );
+        m_impl->allreduce( nbItems, obj, res, op );
+    }
+    // _________________________________________________________________
+    template<typename K, typename Func> void
+    Communicator::allreduce( const K& obj, K& res, const Func& op,
+                             bool commute ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allreduce, no_process, Profiler::bytes(obj) );
+        m_impl->allreduce( 1, &obj, &res, op, commute );
+    }
+    // .................................................................
+    template<typename K, typename Func> void
+    Communicator::allreduce( const std::vector<K>& obj, std::vector<K>& res,
+                             const Func& op, bool commute ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allreduce, no_process, Profiler::bytes(obj) );
+        if ( res.size() != obj.size() ) {
+            std::vector<K>(obj.size()).swap(res);
+        }
+        m_impl->allreduce( obj.size(), obj.data(), res.data(), op, commute );
+    }
+    // .................................................................
+    template<typename K, typename Func> void
+    Communicator::allreduce( std::size_t nbItems, const K* obj, K* res,
+                             const Func& op, bool commute ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allreduce, no_process, nbItems*sizeof(K) );
+        m_impl->allreduce( nbItems, obj, res, op, commute );
+    }
+    // =================================================================
+    template<typename K> void
+    Communicator::allgather( const K& obj, std::vector<K>& res ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allgather, no_process, Profiler::bytes(obj) );
+        m_impl->allgather( obj, res );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::allgather( const K& obj, K& res ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allgather, no_process, Profiler::bytes(obj) );
+        m_impl->allgather( obj, res );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::allgather( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allgather, no_process, nbObjs*sizeof(K) );
+        m_impl->allgather( nbObjs, b_snd, b_rcv );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::allgatherv( const K& obj, K& res ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allgather, no_process, Profiler::bytes(obj) );
+        std::vector<int> counts;
+        m_impl->allgatherv( obj, res, counts );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::allgatherv( const K& obj, K& res, std::vector<int>& counts ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allgather, no_process, Profiler::bytes(obj) );
+        m_impl->allgatherv( obj, res, counts );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::allgatherv( std::size_t nbObjs, const K* b_snd,
+                              const std::vector<int>& counts, K* b_rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::allgather, no_process, nbObjs*sizeof(K) );
+        m_impl->allgatherv( nbObjs, b_snd, counts, b_rcv );
+    }
+    // =================================================================
+    template<typename K> void
+    Communicator::gather( const K& obj, std::vector<K>& res, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::gather, root, Profiler::bytes(obj) );
+        m_impl->gather( obj, res, root );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::gather( const K& obj, K& res, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::gather, root, Profiler::bytes(obj) );
+        m_impl->gather( obj, res, root );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::gather( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::gather, root, nbObjs*sizeof(K) );
+        m_impl->gather( nbObjs, b_snd, b_rcv, root );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::gatherv( const K& obj, K& res, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::gather, root, Profiler::bytes(obj) );
+        m_impl->gatherv( obj, res, root );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::gatherv( std::size_t nbObjs, const K* b_snd,
+                           const std::vector<int>& counts, K* b_rcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::gather, root, nbObjs*sizeof(K) );
+        m_impl->gatherv( nbObjs, b_snd, counts, b_rcv, root );
+    }
+    // =================================================================
+    template<typename K> void
+    Communicator::scatter( const std::vector<K>& objs, K& res, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::scatter, root );
+        m_impl->scatter( objs, res, root );
+        probe.setBytes( Profiler::bytes(res) );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::scatter( const K& objs, K& res, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::scatter, root );
+        m_impl->scatter( objs, res, root );
+        probe.setBytes( Profiler::bytes(res) );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::scatter( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::scatter, root, nbObjs*sizeof(K) );
+        m_impl->scatter( nbObjs, b_snd, b_rcv, root );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::scatterv( const K& objs, const std::vector<int>& counts,
+                            K& res, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::scatter, root );
+        m_impl->scatterv( objs, counts, res, root );
+        probe.setBytes( Profiler::bytes(res) );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::scatterv( const K* b_snd, const std::vector<int>& counts,
+                            std::size_t nbObjs, K* b_rcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::scatter, root, nbObjs*sizeof(K) );
+        m_impl->scatterv( b_snd, counts, nbObjs, b_rcv, root );
+    }
+    // =================================================================
+    template<typename K> void
+    Communicator::alltoall( const K& snd, K& rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::alltoall, no_process, Profiler::bytes(snd) );
+        m_impl->alltoall( snd, rcv );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::alltoall( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::alltoall, no_process, nbObjs*size*sizeof(K) );
+        m_impl->alltoall( nbObjs, b_snd, b_rcv );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::alltoallv( const K& snd, const std::vector<int>& sndCounts,
+                             K& rcv, std::vector<int>& rcvCounts ) const
+    {
+        Profiler::Probe probe( *this, Profiler::alltoall, no_process, Profiler::bytes(snd) );
+        m_impl->alltoallv( snd, sndCounts, rcv, rcvCounts );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::alltoallv( const K* b_snd, const std::vector<int>& sndCounts,
+                             K* b_rcv, const std::vector<int>& rcvCounts ) const
+    {
+        Profiler::Probe probe( *this, Profiler::alltoall );
+        if ( probe.isActive() )
+            probe.setBytes( std::accumulate( sndCounts.begin(), sndCounts.end(), std::size_t(0) )*sizeof(K) );
+        m_impl->alltoallv( b_snd, sndCounts, b_rcv, rcvCounts );
+    }
+    // =================================================================
+    template<typename K> void
+    Communicator::neighbor_allgather( const K& obj, std::vector<K>& res ) const
+    {
+        Profiler::Probe probe( *this, Profiler::neighbor, no_process, Profiler::bytes(obj) );
+        m_impl->neighbor_allgather( obj, res );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::neighbor_allgather( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::neighbor, no_process, nbObjs*sizeof(K) );
+        m_impl->neighbor_allgather( nbObjs, b_snd, b_rcv );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::neighbor_alltoall( const K& snd, K& rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::neighbor, no_process, Profiler::bytes(snd) );
+        m_impl->neighbor_alltoall( snd, rcv );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::neighbor_alltoall( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::neighbor );
+        if ( probe.isActive() ) probe.setBytes( nbObjs*neighborDestinations().size()*sizeof(K) );
+        m_impl->neighbor_alltoall( nbObjs, b_snd, b_rcv );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::neighbor_alltoallv( const K& snd, const std::vector<int>& sndCounts,
+                                      K& rcv, std::vector<int>& rcvCounts ) const
+    {
+        Profiler::Probe probe( *this, Profiler::neighbor, no_process, Profiler::bytes(snd) );
+        m_impl->neighbor_alltoallv( snd, sndCounts, rcv, rcvCounts );
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::neighbor_alltoallv( const K* b_snd, const std::vector<int>& sndCounts,
+                                      K* b_rcv, const std::vector<int>& rcvCounts ) const
+    {
+        Profiler::Probe probe( *this, Profiler::neighbor );
+        if ( probe.isActive() )
+            probe.setBytes( std::accumulate( sndCounts.begin(), sndCounts.end(), std::size_t(0) )*sizeof(K) );
+        m_impl->neighbor_alltoallv( b_snd, sndCounts, b_rcv, rcvCounts );
+    }
+    // =================================================================
+    // Opérations collectives non bloquantes :
+    template<typename K> Request
+    Communicator::ibcast( const K& objsnd, K& objrcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ibcast, root );
+        Request req = m_impl->ibroadcast( &objsnd, objrcv, root );
+        probe.setBytes( Profiler::bytes(objrcv) );
+        return req;
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::ibcast( K& objrcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ibcast, root );
+        Request req = m_impl->ibroadcast( static_cast<K*>(nullptr), objrcv, root );
+        probe.setBytes( Profiler::bytes(objrcv) );
+        return req;
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::ibcast( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ibcast, root, nbObjs*sizeof(K) );
+        return m_impl->ibroadcast( nbObjs, b_snd, b_rcv, root );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::ibcast( std::size_t nbObjs, K* b_rcv, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ibcast, root, nbObjs*sizeof(K) );
+        return m_impl->ibroadcast( nbObjs, (const K*)nullptr, b_rcv, root );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::ireduce( const K& obj, K& res, const Operation& op, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ireduce, root, Profiler::bytes(obj) );
+        return m_impl->ireduce( obj, &res, op, root );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::ireduce( std::size_t nbItems, const K* obj, K* res,
+                           Operation op, int root ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ireduce, root, nbItems*sizeof(K) );
+        return m_impl->ireduce( nbItems, obj, res, op, root );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::iallreduce( const K& obj, K& res, const Operation& op ) const
+    {
+        Profiler::Probe probe( *this, Profiler::iallreduce, no_process, Profiler::bytes(obj) );
+        return m_impl->iallreduce( obj, res, op );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::iallreduce( std::size_t nbItems, const K* obj, K* res,
+                              Operation op ) const
+    {
+        Profiler::Probe probe( *this, Profiler::iallreduce, no_process, nbItems*sizeof(K) );
+        return m_impl->iallreduce( nbItems, obj, res, op );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::iallgather( const K& obj, std::vector<K>& res ) const
+    {
+        Profiler::Probe probe( *this, Profiler::iallgather, no_process, Profiler::bytes(obj) );
+        return m_impl->iallgather( obj, res );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::iallgather( const K& obj, K& res ) const
+    {
+        Profiler::Probe probe( *this, Profiler::iallgather, no_process, Profiler::bytes(obj) );
+        return m_impl->iallgather( obj, res );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::iallgather( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::iallgather, no_process, nbObjs*sizeof(K) );
+        return m_impl->iallgather( nbObjs, b_snd, b_rcv );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::ialltoall( const K& snd, K& rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ialltoall, no_process, Profiler::bytes(snd) );
+        return m_impl->ialltoall( snd, rcv );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::ialltoall( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        Profiler::Probe probe( *this, Profiler::ialltoall, no_process, nbObjs*size*sizeof(K) );
+        return m_impl->ialltoall( nbObjs, b_snd, b_rcv );
+    }
+    // =================================================================
+    // Opérations collectives persistantes :
+    template<typename K> Request
+    Communicator::bcast_init( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root ) const
+    {
+        return m_impl->broadcast_init( nbObjs, b_snd, b_rcv, root );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::reduce_init( std::size_t nbItems, const K* obj, K* res,
+                               Operation op, int root ) const
+    {
+        return m_impl->reduce_init( nbItems, obj, res, op, root );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::allreduce_init( std::size_t nbItems, const K* obj, K* res,
+                                  Operation op ) const
+    {
+        return m_impl->allreduce_init( nbItems, obj, res, op );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::allgather_init( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        return m_impl->allgather_init( nbObjs, b_snd, b_rcv );
+    }
+    // .................................................................
+    template<typename K> Request
+    Communicator::alltoall_init( std::size_t nbObjs, const K* b_snd, K* b_rcv ) const
+    {
+        return m_impl->alltoall_init( nbObjs, b_snd, b_rcv );
+    }
+    // =================================================================
+    // Segmented collective operations
+    template<typename K> void
+    Communicator::segmented_bcast( std::size_t nbObjs, const K* b_snd, K* b_rcv, int root,
+                                   std::size_t segmentSize, pipeline_type pipeline,
+                                   const SegmentCallback& onSegment ) const
+    {
+        assert( segmentSize > 0 );
+        assert( b_rcv != nullptr );
+        if ( (rank == root) && (b_snd != b_rcv) ) {
+            assert( b_snd != nullptr );
+            std::copy_n( b_snd, nbObjs, b_rcv );
+        }
+        int parent;
+        std::vector<int> children;
+        pipelineNeighbors( root, pipeline, parent, children );
+        const std::size_t nbSegments = ( nbObjs + segmentSize - 1 )/segmentSize;
+        // All the receptions are posted first, then each segment is forwarded as soon as it arrives :
+        std::vector<Request> receptions;
+        if ( parent != no_process ) {
+            receptions.reserve( nbSegments );
+            for ( std::size_t first = 0; first < nbObjs; first += segmentSize )
+                receptions.push_back( irecv( std::min( segmentSize, nbObjs - first ), b_rcv + first,
+                                             parent, segment_tag ) );
+        }
+        RequestSet sendings;
+        for ( std::size_t s = 0; s < nbSegments; ++s ) {
+            const std::size_t first = s*segmentSize, count = std::min( segmentSize, nbObjs - first );
+            if ( parent != no_process ) receptions[s].wait();
+            for ( int child : children )
+                sendings.push_back( isend( count, b_rcv + first, child, segment_tag ) );
+            if ( onSegment ) onSegment( first, count );
+        }
+        sendings.waitAll();
+    }
+    // .................................................................
+    template<typename K> void
+    Communicator::segmented_reduce( std::size_t nbObjs, const K* b_objs, K* b_res, Operation op,
+                                    int root, std::size_t segmentSize, pipeline_type pipeline,
+                                    const SegmentCallback& onSegment ) const
+    {
+        assert( segmentSize > 0 );
+        assert( b_objs != nullptr );
+        // The partial results are combined in the order of the pipeline, not in the order
+        // of the ranks : a non commutative operation is done by reduce()
+        if ( !Implementation::isCommutative( op ) ) {
+            reduce( nbObjs, b_objs, ( rank == root ? b_res : nullptr ), op, root );
+            if ( (rank == root) && onSegment )
+                for ( std::size_t first = 0; first < nbObjs; first += segmentSize )
+                    onSegment( first, std::min( segmentSize, nbObjs - first ) );
+            return;
+        }
+        int parent;
+        std::vector<int> children;
+        pipelineNeighbors( root, pipeline, parent, children );
+        // The partial results are computed in b_res on root, in a temporary buffer elsewhere :
+        std::vector<K> partial;
+        K* work = b_res;
+        if ( rank != root ) {
+            partial.resize( nbObjs );
+            work = partial.data();
+        }
+        assert( work != nullptr );
+        std::vector<K> incoming( children.empty() ? 0 : std::min( segmentSize, nbObjs ) );
+        RequestSet sendings;
+        for ( std::size_t first = 0; first < nbObjs; first += segmentSize ) {
+            const std::size_t count = std::min( segmentSize, nbObjs - first );
+            if ( work != b_objs ) std::copy_n( b_objs + first, count, work + first );
+            for ( int child : children ) {
+                recv( count, incoming.data(), child, segment_tag );
+                m_impl->reduce_local( count, incoming.data(), work + first, op );
+            }
+            if ( parent != no_process )
+                sendings.push_back( isend( count, work + first, parent, segment_tag ) );
+            else if ( onSegment ) onSegment( first, count );
+        }
+        sendings.waitAll();
+    }
 }
@@ -16,29 +16,197 @@
 #  define _PARALLEL_COMMUNICATOR_MPI_HPP_
 # include <algorithm>
 # include <functional>
+# include <memory>
+# include <mutex>
 # include <cassert>
 # include <iostream>
+# include <limits>
 # include <mpi.h>
 # include "Parallel/Status.hpp"
 # include "Parallel/Constantes.hpp"
 # include "Parallel/DetectContainer.hpp"
+# include "Parallel/NodeHierarchy.hpp"
+# include "Parallel/Operator.hpp"
 # include "Parallel/Logger.hpp"
 # include "Parallel/Context.hpp"
 
 namespace Parallel
 {
     namespace {
-    template<typename K> std::function<K(const K&, const K&)> reduce_functor;
-    template<typename K> void reduce_user_function ( void* x, void* y, int* length, 
-                                                     MPI_Datatype* tp )
+    // Datatype and number of datatype elements per object used to exchange objects of type K :
+    template<typename K> MPI_Datatype mpi_data_type()
     {
-        K val;
-        K* ax = (K*)x;
-        K* ay = (K*)y;
-        for ( int i = 0; i < *length; ++i) {
-            val = reduce_functor<K>(ax[i], ay[i]);
-            ay[i] = val;
+        return ( Type_MPI<K>::must_be_packed() ? MPI_BYTE : Type_MPI<K>::mpi_type() );
+    }
+    template<typename K> int mpi_item_size()
+    {
+        return ( Type_MPI<K>::must_be_packed() ? int(sizeof(K)) : 1 );
+    }
+    // Counts and displacements ( in datatype elements ) for the v-variants of collectives :
+    template<typename K> std::vector<int> mpi_counts( const std::vector<int>& counts )
+    {
+        std::vector<int> mpi_cnts(counts.size());
+        std::transform(counts.begin(), counts.end(), mpi_cnts.begin(),
+                       [] (int cnt) { return cnt*mpi_item_size<K>(); });
+        return mpi_cnts;
+    }
+    inline std::vector<int> mpi_displacements( const std::vector<int>& counts )
+    {
+        std::vector<int> displs(counts.size(), 0);
+        for ( std::size_t i = 1; i < counts.size(); ++i )
+            displs[i] = displs[i-1] + counts[i-1];
+        return displs;
+    }
+    // Large messages : the counts of the MPI calls are int. With MPI 4, the point to point
+    // calls and the non blocking broadcast use the large count entry points ( _c suffix ).
+    // Otherwise, a message of more than max_count elements is described by one element of a
+    // derived datatype. The reductions are done by chunks of reduce_chunk elements because the
+    // predefined operations only apply to the basic datatypes ( the chunks also bound the
+    // temporary buffers allocated by the MPI library ).
+    constexpr std::size_t max_count    = std::size_t(std::numeric_limits<int>::max());
+    constexpr std::size_t reduce_chunk = std::size_t(1) << 26;
+    // Count and datatype describing nbElts elements of type :
+    class LargeCount
+    {
+    public:
+        LargeCount( std::size_t nbElts, MPI_Datatype type ) :
+            count(int(nbElts)), datatype(type)
+        {
+            if ( nbElts <= max_count ) return;
+            // nbChunks chunks of max_count elements followed by the remaining elements :
+            std::size_t nbChunks = nbElts/max_count, remain = nbElts%max_count;
+            MPI_Datatype chunk, chunks;
+            MPI_Type_contiguous( int(max_count), type, &chunk );
+            MPI_Type_contiguous( int(nbChunks), chunk, &chunks );
+            MPI_Type_free( &chunk );
+            if ( remain == 0 ) datatype = chunks;
+            else {
+                MPI_Aint lb, extent;
+                MPI_Type_get_extent( type, &lb, &extent );
+                MPI_Datatype rest;
+                MPI_Type_contiguous( int(remain), type, &rest );
+                int          blocks[2] = { 1, 1 };
+                MPI_Aint     displs[2] = { 0, MPI_Aint(nbChunks*max_count)*extent };
+                MPI_Datatype types [2] = { chunks, rest };
+                MPI_Type_create_struct( 2, blocks, displs, types, &datatype );
+                MPI_Type_free( &chunks );
+                MPI_Type_free( &rest );
+            }
+            MPI_Type_commit( &datatype );
+            count = 1;
+            m_derived = true;
         }
+        LargeCount( const LargeCount& ) = delete;
+        LargeCount& operator = ( const LargeCount& ) = delete;
+        // The datatype can be freed before the end of a non blocking communication
+        ~LargeCount() { if ( m_derived ) MPI_Type_free( &datatype ); }
+
+        int          count;
+        MPI_Datatype datatype;
+    private:
+        bool m_derived = false;
+    };
+    // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+    inline int large_send( const void* buf, std::size_t nbElts, MPI_Datatype type,
+                           int dest, int tag, MPI_Comm com )
+    {
+#   if MPI_VERSION >= 4
+        return MPI_Send_c( buf, MPI_Count(nbElts), type, dest, tag, com );
+#   else
+        LargeCount msg( nbElts, type );
+        return MPI_Send( buf, msg.count, msg.datatype, dest, tag, com );
+#   endif
+    }
+    inline int large_isend( const void* buf, std::size_t nbElts, MPI_Datatype type,
+                            int dest, int tag, MPI_Comm com, MPI_Request* req )
+    {
+#   if MPI_VERSION >= 4
+        return MPI_Isend_c( buf, MPI_Count(nbElts), type, dest, tag, com, req );
+#   else
+        LargeCount msg( nbElts, type );
+        return MPI_Isend( buf, msg.count, msg.datatype, dest, tag, com, req );
+#   endif
+    }
+    inline int large_recv( void* buf, std::size_t nbElts, MPI_Datatype type,
+                           int sender, int tag, MPI_Comm com, MPI_Status* status )
+    {
+#   if MPI_VERSION >= 4
+        return MPI_Recv_c( buf, MPI_Count(nbElts), type, sender, tag, com, status );
+#   else
+        LargeCount msg( nbElts, type );
+        return MPI_Recv( buf, msg.count, msg.datatype, sender, tag, com, status );
+#   endif
+    }
+    inline int large_irecv( void* buf, std::size_t nbElts, MPI_Datatype type,
+                            int sender, int tag, MPI_Comm com, MPI_Request* req )
+    {
+#   if MPI_VERSION >= 4
+        return MPI_Irecv_c( buf, MPI_Count(nbElts), type, sender, tag, com, req );
+#   else
+        LargeCount msg( nbElts, type );
+        return MPI_Irecv( buf, msg.count, msg.datatype, sender, tag, com, req );
+#   endif
+    }
+    // Number of basic elements of type in a received message :
+    inline std::size_t large_count( const MPI_Status& status, MPI_Datatype type )
+    {
+        MPI_Count count;
+#   if MPI_VERSION >= 4
+        MPI_Get_count_c( &status, type, &count );
+#   else
+        MPI_Get_elements_x( &status, type, &count );
+#   endif
+        return std::size_t(count);
+    }
+    // The node aware broadcast takes the derived datatype :
+    inline int large_bcast( void* buf, std::size_t nbElts, MPI_Datatype type, int root, MPI_Comm com )
+    {
+        LargeCount msg( nbElts, type );
+        return NodeHierarchy::bcast( buf, msg.count, msg.datatype, root, com );
+    }
+    inline int large_ibcast( void* buf, std::size_t nbElts, MPI_Datatype type, int root,
+                             MPI_Comm com, MPI_Request* req )
+    {
+#   if MPI_VERSION >= 4
+        return MPI_Ibcast_c( buf, MPI_Count(nbElts), type, root, com, req );
+#   else
+        LargeCount msg( nbElts, type );
+        return MPI_Ibcast( buf, msg.count, msg.datatype, root, com, req );
+#   endif
+    }
+    // Reductions by chunks ( one call for the small messages ). snd can be MPI_IN_PLACE and
+    // rcv is null on the processes other than root.
+    inline int large_reduce( const void* snd, void* rcv, std::size_t nbElts, MPI_Datatype type,
+                             MPI_Op op, int root, MPI_Comm com )
+    {
+        MPI_Aint lb, extent;
+        MPI_Type_get_extent( type, &lb, &extent );
+        std::size_t first = 0;
+        int err;
+        do {
+            int count = int(std::min( reduce_chunk, nbElts - first ));
+            const void* s = ( snd == MPI_IN_PLACE ? snd : static_cast<const char*>(snd) + first*extent );
+            void*       r = ( rcv == nullptr ? rcv : static_cast<char*>(rcv) + first*extent );
+            err = NodeHierarchy::reduce( s, r, count, type, op, root, com );
+            first += reduce_chunk;
+        } while ( (first < nbElts) && (err == MPI_SUCCESS) );
+        return err;
+    }
+    inline int large_allreduce( const void* snd, void* rcv, std::size_t nbElts, MPI_Datatype type,
+                                MPI_Op op, MPI_Comm com )
+    {
+        MPI_Aint lb, extent;
+        MPI_Type_get_extent( type, &lb, &extent );
+        std::size_t first = 0;
+        int err;
+        do {
+            int count = int(std::min( reduce_chunk, nbElts - first ));
+            const void* s = ( snd == MPI_IN_PLACE ? snd : static_cast<const char*>(snd) + first*extent );
+            err = NodeHierarchy::allreduce( s, static_cast<char*>(rcv) + first*extent, count,
+                                            type, op, com );
+            first += reduce_chunk;
+        } while ( (first < nbElts) && (err == MPI_SUCCESS) );
+        return err;
     }
     }
     // .................................................................
@@ -55,11 +223,41 @@ namespace Parallel
                             &m_communicator );
         }
         // -------------------------------------------------------------
+        // shared_memory is the only kind of split :
+        Implementation( const Implementation& impl, Communicator::split_type, int key )
+        {
+            MPI_Comm_split_type( impl.m_communicator, MPI_COMM_TYPE_SHARED, key,
+                                 MPI_INFO_NULL, &m_communicator );
+        }
+        // -------------------------------------------------------------
         Implementation( const Implementation& impl )
         {
             MPI_Comm_dup( impl.m_communicator, &m_communicator );
         }
         // -------------------------------------------------------------
+        Implementation( const Implementation& impl, const std::vector<int>& dims,
+                        const std::vector<bool>& periods, bool reorder )
+        {
+            std::vector<int> prds(periods.begin(), periods.end());
+            MPI_Cart_create( impl.m_communicator, int(dims.size()), dims.data(), prds.data(),
+                             int(reorder), &m_communicator );
+        }
+        // -------------------------------------------------------------
+        Implementation( const Implementation& cart, const std::vector<bool>& remainDims )
+        {
+            std::vector<int> remain(remainDims.begin(), remainDims.end());
+            MPI_Cart_sub( cart.m_communicator, remain.data(), &m_communicator );
+        }
+        // -------------------------------------------------------------
+        Implementation( const Implementation& impl, const std::vector<int>& sources,
+                        const std::vector<int>& destinations, bool reorder )
+        {
+            MPI_Dist_graph_create_adjacent( impl.m_communicator,
+                                            int(sources.size()), sources.data(), MPI_UNWEIGHTED,
+                                            int(destinations.size()), destinations.data(), MPI_UNWEIGHTED,
+                                            MPI_INFO_NULL, int(reorder), &m_communicator );
+        }
+        // -------------------------------------------------------------
         Implementation( const Ext_Communicator& excom )
         {
             MPI_Comm_dup( excom, &m_communicator );
@@ -67,7 +265,10 @@ namespace Parallel
         // -------------------------------------------------------------
         ~Implementation() 
         {
-            MPI_Comm_free(&m_communicator);
+            // A communicator kept after the end of the parallel context can't be freed
+            int finalized;
+            MPI_Finalized(&finalized);
+            if ( !finalized ) MPI_Comm_free(&m_communicator);
         }
         // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
         int getRank() const 
@@ -84,6 +285,112 @@ namespace Parallel
             return size;
         }
         // -------------------------------------------------------------
+        // The ranks in MPI_COMM_WORLD are translated once, at the first call :
+        int worldRank( int rank ) const
+        {
+            std::call_once( m_worldRanksTranslated, [this] () {
+                MPI_Group group, world;
+                MPI_Comm_group( m_communicator, &group );
+                MPI_Comm_group( MPI_COMM_WORLD, &world );
+                std::vector<int> ranks(getSize());
+                for ( std::size_t r = 0; r < ranks.size(); ++r ) ranks[r] = int(r);
+                m_worldRanks.resize( ranks.size() );
+                MPI_Group_translate_ranks( group, int(ranks.size()), ranks.data(),
+                                           world, m_worldRanks.data() );
+                MPI_Group_free( &group );
+                MPI_Group_free( &world );
+            } );
+            return m_worldRanks[rank];
+        }
+        // -------------------------------------------------------------
+        const MPI_Comm& communicator() const { return m_communicator; }
+        // -------------------------------------------------------------
+        void setHierarchical( bool hierarchical )
+        {
+            if ( hierarchical ) NodeHierarchy::attach( m_communicator );
+            else NodeHierarchy::detach( m_communicator );
+        }
+        // -------------------------------------------------------------
+        bool isHierarchical() const
+        {
+            return ( NodeHierarchy::get( m_communicator ) != nullptr );
+        }
+        // -------------------------------------------------------------
+        // Cartesian topology :
+        int nbDimensions() const
+        {
+            int nbDims;
+            MPI_Cartdim_get( m_communicator, &nbDims );
+            return nbDims;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        void cartesian( std::vector<int>& dims, std::vector<bool>& periods,
+                        std::vector<int>& coords ) const
+        {
+            int nbDims = nbDimensions();
+            std::vector<int> prds(nbDims);
+            dims.resize(nbDims);
+            coords.resize(nbDims);
+            MPI_Cart_get( m_communicator, nbDims, dims.data(), prds.data(), coords.data() );
+            periods.assign(prds.begin(), prds.end());
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        std::vector<int> coordinates( int rank ) const
+        {
+            std::vector<int> coords(nbDimensions());
+            MPI_Cart_coords( m_communicator, rank, int(coords.size()), coords.data() );
+            return coords;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        int rankOf( const std::vector<int>& coords ) const
+        {
+            int rank;
+            MPI_Cart_rank( m_communicator, coords.data(), &rank );
+            return rank;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        std::pair<int,int> shift( int direction, int displacement ) const
+        {
+            std::pair<int,int> neighbors;
+            MPI_Cart_shift( m_communicator, direction, displacement,
+                            &neighbors.first, &neighbors.second );
+            return neighbors;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        static std::vector<int> dimensions( int nbProcs, const std::vector<int>& dims )
+        {
+            std::vector<int> res(dims);
+            MPI_Dims_create( nbProcs, int(res.size()), res.data() );
+            return res;
+        }
+        // -------------------------------------------------------------
+        // Neighbors of the topology. For a Cartesian topology, the neighbors of each
+        // dimension are the process in the negative direction then in the positive one.
+        void neighbors( std::vector<int>& sources, std::vector<int>& destinations ) const
+        {
+            int topology;
+            MPI_Topo_test( m_communicator, &topology );
+            if ( topology == MPI_CART ) {
+                int nbDims = nbDimensions();
+                sources.resize(2*nbDims);
+                for ( int d = 0; d < nbDims; ++d )
+                    MPI_Cart_shift( m_communicator, d, 1, &sources[2*d], &sources[2*d+1] );
+                destinations = sources;
+            }
+            else if ( topology == MPI_DIST_GRAPH ) {
+                int nbSources, nbDests, weighted;
+                MPI_Dist_graph_neighbors_count( m_communicator, &nbSources, &nbDests, &weighted );
+                sources.resize(nbSources);
+                destinations.resize(nbDests);
+                MPI_Dist_graph_neighbors( m_communicator, nbSources, sources.data(), MPI_UNWEIGHTED,
+                                          nbDests, destinations.data(), MPI_UNWEIGHTED );
+            }
+            else {
+                sources.clear();
+                destinations.clear();
+            }
+        }
+        // -------------------------------------------------------------
         Status probe( int src, int tag ) const
         {
             Status status;
@@ -155,6 +462,27 @@ namespace Parallel
             return Request(req);
           }
           // .......................................................................................
+          static Request send_init( const MPI_Comm& com, const K& snd_obj, int dest, int tag )
+          {
+#           if defined(DEBUG)
+            LogTrace << "Persistent send for an object to " << dest << " with tag " << tag << std::endl;
+#           endif
+            MPI_Request req;
+            MPI_Send_init(&snd_obj, mpi_item_size<K>(), mpi_data_type<K>(), dest, tag, com, &req);
+            return Request::persistent(req);
+          }
+          // .......................................................................................
+          static Request recv_init( const MPI_Comm& com, K& rcvobj, int sender, int tag )
+          {
+#           if defined(DEBUG)
+            LogTrace << "Persistent receive of an object from " << sender << " with tag "
+                     << tag << std::endl;
+#           endif
+            MPI_Request req;
+            MPI_Recv_init(&rcvobj, mpi_item_size<K>(), mpi_data_type<K>(), sender, tag, com, &req);
+            return Request::persistent(req);
+          }
+          // .......................................................................................
           static void broadcast( const MPI_Comm& com, const K* obj_snd, K& obj_rcv, int root )
           {
 #           if defined(DEBUG)            
@@ -167,9 +495,9 @@ namespace Parallel
               obj_rcv = *obj_snd;
             }
             if ( Type_MPI<K>::must_be_packed() ) {
-              MPI_Bcast(&obj_rcv, sizeof(K), MPI_BYTE, root, com );
+              NodeHierarchy::bcast(&obj_rcv, sizeof(K), MPI_BYTE, root, com );
             } else {
-              MPI_Bcast(&obj_rcv, 1, Type_MPI<K>::mpi_type(), root, com );
+              NodeHierarchy::bcast(&obj_rcv, 1, Type_MPI<K>::mpi_type(), root, com );
             }
           }
           // .......................................................................................
@@ -182,11 +510,118 @@ namespace Parallel
             MPI_Comm_rank(com, &rank);
             assert( (rank!=root) || (glob != nullptr) );
 #           endif
-            MPI_Reduce( &loc, glob, 1, Type_MPI<K>::mpi_type(), op, root, com );
+            NodeHierarchy::reduce( &loc, glob, 1, Type_MPI<K>::mpi_type(), op, root, com );
 #           if defined(DEBUG)            
             LogTrace << "End of reduction" << std::endl;
 #           endif
           }
+          // .......................................................................................
+          static void allreduce( const MPI_Comm& com, const K& loc, K& glob, const Operation& op )
+          {
+#           if defined(DEBUG)
+            LogTrace << "Allreduce operation on one object" << std::endl;
+#           endif
+            if ( &loc == &glob )
+              NodeHierarchy::allreduce( MPI_IN_PLACE, &glob, 1, Type_MPI<K>::mpi_type(), op, com );
+            else
+              NodeHierarchy::allreduce( &loc, &glob, 1, Type_MPI<K>::mpi_type(), op, com );
+          }
+          // .......................................................................................
+          static void allgather( const MPI_Comm& com, const K& obj, std::vector<K>& res )
+          {
+            int size;
+            MPI_Comm_size(com, &size);
+#           if defined(DEBUG)
+            LogTrace << "Allgather of one object per process" << std::endl;
+#           endif
+            if ( res.size() < std::size_t(size) ) std::vector<K>(size).swap(res);
+            MPI_Allgather( &obj, mpi_item_size<K>(), mpi_data_type<K>(),
+                           res.data(), mpi_item_size<K>(), mpi_data_type<K>(), com );
+          }
+          // .......................................................................................
+          static void gather( const MPI_Comm& com, const K& obj, std::vector<K>& res, int root )
+          {
+            int rank, size;
+            MPI_Comm_rank(com, &rank);
+            MPI_Comm_size(com, &size);
+#           if defined(DEBUG)
+            LogTrace << "Gather of one object per process with root = " << root << std::endl;
+#           endif
+            if ( (rank == root) && (res.size() < std::size_t(size)) ) std::vector<K>(size).swap(res);
+            MPI_Gather( &obj, mpi_item_size<K>(), mpi_data_type<K>(),
+                        res.data(), mpi_item_size<K>(), mpi_data_type<K>(), root, com );
+          }
+          // .......................................................................................
+          static void scatter( const MPI_Comm& com, const std::vector<K>& snd, K& obj, int root )
+          {
+#           if defined(DEBUG)
+            LogTrace << "Scatter of one object per process with root = " << root << std::endl;
+            int rank, size;
+            MPI_Comm_rank(com, &rank);
+            MPI_Comm_size(com, &size);
+            assert( (rank != root) || (snd.size() >= std::size_t(size)) );
+#           endif
+            MPI_Scatter( snd.data(), mpi_item_size<K>(), mpi_data_type<K>(),
+                         &obj, mpi_item_size<K>(), mpi_data_type<K>(), root, com );
+          }
+          // .......................................................................................
+          static Request ibroadcast( const MPI_Comm& com, const K* obj_snd, K& obj_rcv, int root )
+          {
+#           if defined(DEBUG)
+            LogTrace << "Asynchronous broadcast of one object with root = " << root << std::endl;
+#           endif
+            int rank;
+            MPI_Comm_rank(com, &rank);
+            if ( (root == rank) && (obj_snd != &obj_rcv) ) {
+              assert(obj_snd != nullptr);
+              obj_rcv = *obj_snd;
+            }
+            MPI_Request req;
+            MPI_Ibcast(&obj_rcv, mpi_item_size<K>(), mpi_data_type<K>(), root, com, &req );
+            return Request(req);
+          }
+          // .......................................................................................
+          static Request ireduce( const MPI_Comm& com, const K& loc, K* glob,
+                                  const Operation& op, int root )
+          {
+#           if defined(DEBUG)
+            LogTrace << "Asynchronous reduce operation on one object with root = " << root
+                     << std::endl;
+#           endif
+            MPI_Request req;
+            if ( &loc == glob )
+              MPI_Ireduce( MPI_IN_PLACE, glob, 1, Type_MPI<K>::mpi_type(), op, root, com, &req );
+            else
+              MPI_Ireduce( &loc, glob, 1, Type_MPI<K>::mpi_type(), op, root, com, &req );
+            return Request(req);
+          }
+          // .......................................................................................
+          static Request iallreduce( const MPI_Comm& com, const K& loc, K& glob, const Operation& op )
+          {
+#           if defined(DEBUG)
+            LogTrace << "Asynchronous allreduce operation on one object" << std::endl;
+#           endif
+            MPI_Request req;
+            if ( &loc == &glob )
+              MPI_Iallreduce( MPI_IN_PLACE, &glob, 1, Type_MPI<K>::mpi_type(), op, com, &req );
+            else
+              MPI_Iallreduce( &loc, &glob, 1, Type_MPI<K>::mpi_type(), op, com, &req );
+            return Request(req);
+          }
+          // .......................................................................................
+          static Request iallgather( const MPI_Comm& com, const K& obj, std::vector<K>& res )
+          {
+            int size;
+            MPI_Comm_size(com, &size);
+#           if defined(DEBUG)
+            LogTrace << "Asynchronous allgather of one object per process" << std::endl;
+#           endif
+            if ( res.size() < std::size_t(size) ) std::vector<K>(size).swap(res);
+            MPI_Request req;
+            MPI_Iallgather( &obj, mpi_item_size<K>(), mpi_data_type<K>(),
+                            res.data(), mpi_item_size<K>(), mpi_data_type<K>(), com, &req );
+            return Request(req);
+          }
         };      
         // -------------------------------------------------------------
         // Envoie par défaut :
@@ -194,11 +629,11 @@ namespace Parallel
                                       int dest, int tag ) const
       {
         if ( Type_MPI<K>::must_be_packed() ) {
-          MPI_Send(sndbuff, nbItems*sizeof(K), MPI_BYTE,
-                   dest, tag, m_communicator );
+          large_send(sndbuff, nbItems*sizeof(K), MPI_BYTE,
+                     dest, tag, m_communicator );
         } else {
-          MPI_Send(sndbuff, nbItems, Type_MPI<K>::mpi_type(), 
-                   dest, tag, m_communicator );
+          large_send(sndbuff, nbItems, Type_MPI<K>::mpi_type(), 
+                     dest, tag, m_communicator );
 #               if defined(TRACE)
           std::cerr << "A envoyé buffer à l'adresse "
                     << (void*)sndbuff << " un message pour "
@@ -219,11 +654,11 @@ namespace Parallel
       {
         MPI_Request m_req;
         if ( Type_MPI<K>::must_be_packed() ) {
-          MPI_Isend(sndbuff, nbItems*sizeof(K), MPI_BYTE,
-                    dest, tag, m_communicator,  &m_req);
+          large_isend(sndbuff, nbItems*sizeof(K), MPI_BYTE,
+                      dest, tag, m_communicator,  &m_req);
         } else {
-          MPI_Isend(sndbuff, nbItems, Type_MPI<K>::mpi_type(), 
-                    dest, tag, m_communicator, &m_req );
+          large_isend(sndbuff, nbItems, Type_MPI<K>::mpi_type(), 
+                      dest, tag, m_communicator, &m_req );
 #         if defined(TRACE)
           std::cerr << "A envoyé buffer à l'adresse "
                     << (void*)sndbuff << " un message pour "
@@ -245,8 +680,8 @@ namespace Parallel
         {
             Status status;
             if ( Type_MPI<K>::must_be_packed() ) {
-                MPI_Recv(rcvbuff, nbItems*sizeof(K), MPI_BYTE,
-                         sender, tag, m_communicator, &status.status);
+                large_recv(rcvbuff, nbItems*sizeof(K), MPI_BYTE,
+                           sender, tag, m_communicator, &status.status);
             }
             else {
 #               if defined(TRACE)
@@ -256,8 +691,8 @@ namespace Parallel
                           << " contenant " << nbItems << " éléments"
                           << std::endl;
 #               endif
-                MPI_Recv(rcvbuff, nbItems, Type_MPI<K>::mpi_type(),
-                         sender, tag, m_communicator, &status.status );
+                large_recv(rcvbuff, nbItems, Type_MPI<K>::mpi_type(),
+                           sender, tag, m_communicator, &status.status );
 #               if defined(TRACE)
                 std::cerr << "OK, bien reçu !" << "\n";
 #               endif                         
@@ -274,8 +709,8 @@ namespace Parallel
         {
             MPI_Request req;
             if ( Type_MPI<K>::must_be_packed() ) {
-                MPI_Irecv(rcvbuff, nbItems*sizeof(K), MPI_BYTE,
-                         sender, tag, m_communicator, &req);
+                large_irecv(rcvbuff, nbItems*sizeof(K), MPI_BYTE,
+                            sender, tag, m_communicator, &req);
             }
             else {
 #               if defined(TRACE)
@@ -285,8 +720,8 @@ namespace Parallel
                           << " contenant " << nbItems << " éléments"
                           << std::endl;
 #               endif
-                MPI_Irecv(rcvbuff, nbItems, Type_MPI<K>::mpi_type(),
-                         sender, tag, m_communicator, &req );
+                large_irecv(rcvbuff, nbItems, Type_MPI<K>::mpi_type(),
+                            sender, tag, m_communicator, &req );
             }
             return Request(req);
         }
@@ -295,6 +730,40 @@ namespace Parallel
         return Communication<K,is_container<K>::value>::irecv(m_communicator,
                                                               rcvobj, sender, tag);
       }
+      // Persistent point to point communications :
+      template<typename K> Request send_init( std::size_t nbItems, const K* sndbuff,
+                                              int dest, int tag ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Persistent send of " << nbItems << " objects to " << dest
+                 << " with tag " << tag << std::endl;
+#       endif
+        MPI_Request req;
+        MPI_Send_init(sndbuff, nbItems*mpi_item_size<K>(), mpi_data_type<K>(),
+                      dest, tag, m_communicator, &req);
+        return Request::persistent(req);
+      }
+      template<typename K> Request send_init( const K& snd, int dest, int tag ) const
+      {
+        return Communication<K,is_container<K>::value>::send_init(m_communicator, snd, dest, tag);
+      }
+      template<typename K> Request recv_init( std::size_t nbItems, K* rcvbuff,
+                                              int sender, int tag ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Persistent receive of " << nbItems << " objects from " << sender
+                 << " with tag " << tag << std::endl;
+#       endif
+        MPI_Request req;
+        MPI_Recv_init(rcvbuff, nbItems*mpi_item_size<K>(), mpi_data_type<K>(),
+                      sender, tag, m_communicator, &req);
+        return Request::persistent(req);
+      }
+      template<typename K> Request recv_init( K& rcvobj, int sender, int tag ) const
+      {
+        return Communication<K,is_container<K>::value>::recv_init(m_communicator, rcvobj,
+                                                                  sender, tag);
+      }
 
       // Broadcast :
       template<typename K> void 
@@ -313,11 +782,11 @@ namespace Parallel
             std::copy_n( bufsnd, nbItems, bufrcv );
         }
         if ( Type_MPI<K>::must_be_packed() ) {
-          MPI_Bcast(bufrcv, nbItems*sizeof(K), MPI_BYTE, 
-                    root, m_communicator );
+          large_bcast(bufrcv, nbItems*sizeof(K), MPI_BYTE, 
+                      root, m_communicator );
         } else {
-          MPI_Bcast(bufrcv, nbItems, Type_MPI<K>::mpi_type(),
-                    root, m_communicator );
+          large_bcast(bufrcv, nbItems, Type_MPI<K>::mpi_type(),
+                      root, m_communicator );
         }
       }
       
@@ -337,16 +806,43 @@ namespace Parallel
           if ( bufsnd != bufrcv )
             std::copy_n( bufsnd, nbItems, bufrcv );
         }
-        Request req;
-        MPI_Ibcast( bufrcv, nbItems, Type_MPI<K>::mpi_type(),
-                    root, m_communicator, &req );
-        return req;
+        MPI_Request req;
+        large_ibcast( bufrcv, nbItems*mpi_item_size<K>(), mpi_data_type<K>(),
+                      root, m_communicator, &req );
+        return Request(req);
+      }
+      
+      template<typename K> Request ibroadcast( const K* obj_snd, K& obj_rcv, int root ) const
+      {
+        return Communication<K,is_container<K>::value>::ibroadcast(m_communicator, obj_snd,
+                                                                   obj_rcv, root);
       }
         // .............................................................        
         void barrier() const
         {
             MPI_Barrier(m_communicator);
         }
+        // .............................................................        
+        Request ibarrier() const
+        {
+            MPI_Request req;
+            MPI_Ibarrier(m_communicator, &req);
+            return Request(req);
+        }
+        // .............................................................        
+        Request barrier_init() const
+        {
+            MPI_Comm com = m_communicator;
+#           if MPI_VERSION >= 4
+            MPI_Request req;
+            MPI_Barrier_init(com, MPI_INFO_NULL, &req);
+            return Request::persistent(req);
+#           else
+            return Request::persistent(MPI_REQUEST_NULL, [com] (MPI_Request& r) {
+                MPI_Ibarrier(com, &r);
+              });
+#           endif
+        }
         // .............................................................
         template<typename K> void
         reduce( std::size_t nbItems, const K* objs, K* res, Operation op,
@@ -356,13 +852,15 @@ namespace Parallel
             if (root == getRank()) {
                 assert(res != nullptr);
                 if ( objs == res ) {
-                    MPI_Reduce( MPI_IN_PLACE, res, nbItems, 
-                                Type_MPI<K>::mpi_type(), op, root, m_communicator);
+                    large_reduce( MPI_IN_PLACE, res, nbItems, 
+                                  Type_MPI<K>::mpi_type(), op, root, m_communicator);
                 } else {
-                    MPI_Reduce( objs, res, nbItems, 
-                                Type_MPI<K>::mpi_type(), op, root, m_communicator);                    
+                    large_reduce( objs, res, nbItems, 
+                                  Type_MPI<K>::mpi_type(), op, root, m_communicator);                    
                 }
-            }
+            } else
+                large_reduce( objs, res, nbItems, 
+                              Type_MPI<K>::mpi_type(), op, root, m_communicator);                    
         }
         // .............................................................
         template<typename K, typename F> void
@@ -370,26 +868,20 @@ namespace Parallel
                 const F& fct, bool commute, int root )
         {
             assert(objs != nullptr);
-            reduce_functor<K> = std::function<K(const K&, const K&)>(fct);
-
-            MPI_Op op;
-            // On prend par défaut que l'opérateur commute.
-            // Il faudra sinon créer un opérateur exprès à passer
-            // avec la méthode précédente.
-            MPI_Op_create( reduce_user_function<K>, (commute ? 1 : 0), &op);
-            
+            Operator<K,F> oper(fct, commute);
+            MPI_Op op = oper.mpi_op();
             if (root == getRank()) {
                 assert(res != nullptr);
                 if ( objs == res ) {
-                    MPI_Reduce( MPI_IN_PLACE, res, nbItems, 
-                                Type_MPI<K>::mpi_type(), op, root, m_communicator);
+                    large_reduce( MPI_IN_PLACE, res, nbItems, 
+                                  Type_MPI<K>::mpi_type(), op, root, m_communicator);
                 } else {
-                    MPI_Reduce( objs, res, nbItems, 
-                                Type_MPI<K>::mpi_type(), op, root, m_communicator);                    
+                    large_reduce( objs, res, nbItems, 
+                                  Type_MPI<K>::mpi_type(), op, root, m_communicator);                    
                 }
             } else
-                MPI_Reduce( objs, res, nbItems, 
-                            Type_MPI<K>::mpi_type(), op, root, m_communicator);                    
+                large_reduce( objs, res, nbItems, 
+                              Type_MPI<K>::mpi_type(), op, root, m_communicator);                    
             
         }
       template<typename K> void reduce( const K& loc, K* glob, const Operation& op,
@@ -397,220 +889,608 @@ namespace Parallel
       {
         Communication<K,is_container<K>::value>::reduce(m_communicator, loc, glob, op, root);
       }
-
-    private:
-        MPI_Comm m_communicator;
-    };
-    // -----------------------------------------------------------------
-  template<typename K>
-  struct Communicator::Implementation::Communication<K,true>
-  {
-    static void send( const MPI_Comm& com, const K& snd_arr, int dest, int tag )
-    {
-      std::vector<typename K::value_type,typename K::allocator_type>* snd;
-      if ( std::is_base_of<std::vector<typename K::value_type,
-                                       typename K::allocator_type>,K>::value ) {
-        snd = (std::vector<typename K::value_type,typename K::allocator_type>*)&snd_arr;
-      } else {
-#       if defined(DEBUG)            
-        LogTrace << "Copy container data inside a vector" << std::endl;
-#       endif        
-        snd = new std::vector<typename K::value_type,typename K::allocator_type>(snd_arr.size());
-        std::copy(snd_arr.begin(), snd_arr.end(), snd->begin());
+      // .............................................................
+      // inout = in op inout, element by element on the current process
+      template<typename K> void
+      reduce_local( std::size_t nbItems, const K* in, K* inout, Operation op ) const
+      {
+        assert( nbItems <= max_count );
+        MPI_Reduce_local( in, inout, int(nbItems), Type_MPI<K>::mpi_type(), op );
       }
-      
-      if ( Type_MPI<typename K::value_type>::must_be_packed() ) {
-        
-          MPI_Send(snd->data(), snd->size()*sizeof(typename K::value_type),
-                   MPI_BYTE, dest, tag, com );
-      } else {
-        MPI_Send(snd->data(), snd->size(), Type_MPI<typename K::value_type>::mpi_type(),
-                 dest, tag, com );
+      // .............................................................
+      // False for the operators created as non commutative ( see Operator )
+      static bool isCommutative( Operation op )
+      {
+        int commute;
+        MPI_Op_commutative( op, &commute );
+        return ( commute != 0 );
       }
-#     if defined(DEBUG)            
-      LogTrace << "Send a container with " << snd->size() << " elements to " << dest
-               << " with tag " << tag << std::endl;
-#     endif
-      if ( !std::is_base_of<std::vector<typename K::value_type,
-                                       typename K::allocator_type>,K>::value ) {
-#       if defined(DEBUG)            
-        LogTrace << "Delete temporary vector" << std::endl;
-#       endif        
-        delete snd;
+      // .............................................................
+      template<typename K> Request
+      ireduce( std::size_t nbItems, const K* objs, K* res, Operation op, int root ) const
+      {
+        assert(objs != nullptr);
+#       if defined(DEBUG)
+        LogTrace << "Asynchronous reduce operation on " << nbItems << " objects with root = "
+                 << root << std::endl;
+#       endif
+        MPI_Request req;
+        if ( (root == getRank()) && (objs == res) )
+          MPI_Ireduce( MPI_IN_PLACE, res, nbItems, Type_MPI<K>::mpi_type(), op, root,
+                       m_communicator, &req );
+        else
+          MPI_Ireduce( objs, res, nbItems, Type_MPI<K>::mpi_type(), op, root,
+                       m_communicator, &req );
+        return Request(req);
       }
-    }
-    // .......................................................................................
-    static Request isend( const MPI_Comm& com, const K& snd_obj, int dest, int tag )
-    {
-      std::vector<typename K::value_type,typename K::allocator_type>* snd;
-      if ( std::is_base_of<std::vector<typename K::value_type,
-                                       typename K::allocator_type>,K>::value ) {
-        snd = (std::vector<typename K::value_type,typename K::allocator_type>*)&snd_obj;
-      } else {
-#       if defined(DEBUG)            
-        LogTrace << "Copy container data inside a vector" << std::endl;
-#       endif        
-        snd = new std::vector<typename K::value_type,typename K::allocator_type>(snd_obj.size());
-        std::copy(snd_obj.begin(), snd_obj.end(), snd->begin());
+      // .............................................................
+      template<typename K> Request ireduce( const K& loc, K* glob, const Operation& op,
+                                            int root ) const
+      {
+        return Communication<K,is_container<K>::value>::ireduce(m_communicator, loc, glob, op, root);
       }
-
-      MPI_Request m_req;
-      if ( Type_MPI<typename K::value_type>::must_be_packed() ) {
-        MPI_Isend(snd->data(), snd->size()*sizeof(typename K::value_type),
-                  MPI_BYTE, dest, tag, com,  &m_req);
-      } else {
-        MPI_Isend(snd->data(), snd->size(), Type_MPI<typename K::value_type>::mpi_type(),
-                  dest, tag, com, &m_req );
+      // .............................................................
+      template<typename K> Request
+      iallreduce( std::size_t nbItems, const K* objs, K* res, Operation op ) const
+      {
+        assert(res != nullptr);
+#       if defined(DEBUG)
+        LogTrace << "Asynchronous allreduce operation on " << nbItems << " objects" << std::endl;
+#       endif
+        MPI_Request req;
+        if ( objs == res )
+          MPI_Iallreduce( MPI_IN_PLACE, res, nbItems, Type_MPI<K>::mpi_type(), op,
+                          m_communicator, &req );
+        else
+          MPI_Iallreduce( objs, res, nbItems, Type_MPI<K>::mpi_type(), op,
+                          m_communicator, &req );
+        return Request(req);
       }
-#     if defined(DEBUG)            
-      LogTrace << "Asynchrone send for a container with " << snd_obj.size() << " elements  to "
-               << dest << " with tag " << tag << std::endl;
-#     endif        
-      
-      if ( !std::is_base_of<std::vector<typename K::value_type,
-                                        typename K::allocator_type>,K>::value ) {
-#       if defined(DEBUG)            
-        LogTrace << "Delete temporary vector" << std::endl;
-#       endif        
-        delete snd;
+      // .............................................................
+      template<typename K> Request iallreduce( const K& loc, K& glob, const Operation& op ) const
+      {
+        return Communication<K,is_container<K>::value>::iallreduce(m_communicator, loc, glob, op);
       }
-      return Request(m_req);            
-    }
-    // .......................................................................................
-    static Status recv( const MPI_Comm& com, K& rcvobj, int sender, int tag )
-    {
-      MPI_Status status;
-      MPI_Probe(sender, tag, com, &status);
-      int szMsg;
-      MPI_Get_count(&status, Type_MPI<typename K::value_type>::mpi_type(), &szMsg);
-      std::vector<typename K::value_type,typename K::allocator_type>* rcv;
-      if ( std::is_base_of<std::vector<typename K::value_type,
-                                        typename K::allocator_type>,K>::value ) {
-        rcv = (std::vector<typename K::value_type,typename K::allocator_type>*)&rcvobj;
-        if ( rcv->size() < szMsg ) {
-#         if defined(DEBUG)            
-          LogTrace << "Realloc rcv vector to match receive size message" << std::endl;
-#         endif
-          std::vector<typename K::value_type,typename K::allocator_type>(szMsg).swap(*rcv);
-        }
-      } else {
+      // .............................................................
+      template<typename K> Request
+      iallgather( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+        assert(bufrcv != nullptr);
 #       if defined(DEBUG)
-        LogTrace << "Create container data to receive" << std::endl;
+        LogTrace << "Asynchronous allgather of " << nbItems << " objects per process" << std::endl;
 #       endif
-        rcv = new std::vector<typename K::value_type,typename K::allocator_type>(szMsg);
-      }
-#     if defined(DEBUG)
-      LogTrace << "Receive a container with " << rcv->size() << " elements  from " <<sender
-               << " with tag " << tag << std::endl;
-#     endif
-      if ( Type_MPI<typename K::value_type>::must_be_packed() ) {
-        MPI_Recv(rcv->data(), rcv->size()*sizeof(typename K::value_type), MPI_BYTE,
-                 sender, tag, com, &status);
-      } else {
-        MPI_Recv(rcv->data(), rcv->size(), Type_MPI<typename K::value_type>::mpi_type(),
-                 sender, tag, com, &status );
+        int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Request req;
+        if ( bufsnd == bufrcv + getRank()*nbItems )
+          MPI_Iallgather( MPI_IN_PLACE, count, mpi_data_type<K>(),
+                          bufrcv, count, mpi_data_type<K>(), m_communicator, &req );
+        else
+          MPI_Iallgather( bufsnd, count, mpi_data_type<K>(),
+                          bufrcv, count, mpi_data_type<K>(), m_communicator, &req );
+        return Request(req);
       }
-#     if defined(DEBUG)      
-      LogTrace << "OK, receive done !" << std::endl;
-#     endif      
-      if ( !std::is_base_of<std::vector<typename K::value_type,
-                                        typename K::allocator_type>,K>::value ) {
-#       if defined(DEBUG)      
-        LogTrace << "Copy temporary vector inside the container passed as parameter." << std::endl;
-#       endif        
-        rcvobj = K(rcv->begin(),rcv->end());
-        delete rcv;
+      // .............................................................
+      template<typename K, typename R> Request iallgather( const K& obj, R& res ) const
+      {
+        return Communication<K,is_container<K>::value>::iallgather(m_communicator, obj, res);
       }
-      return Status(status);
-    }
-    // .......................................................................................
-    static Request irecv( const MPI_Comm& com, K& rcvobj, int sender, int tag )
-    {
-#     if defined(DEBUG)
-      LogTrace << "Asynchronous receive of a container with " << rcvobj.size()
-               << " elements from " << sender << " with tag " << tag << std::endl;
-#     endif
-      std::vector<typename K::value_type,typename K::allocator_type>* rcv;
-      if ( std::is_base_of<std::vector<typename K::value_type,
-                                       typename K::allocator_type>,K>::value ) {
-        rcv = (std::vector<typename K::value_type,typename K::allocator_type>*)&rcvobj;
-      } else {
+      // .............................................................
+      template<typename K> Request
+      ialltoall( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+        assert(bufsnd != nullptr);
+        assert(bufrcv != nullptr);
 #       if defined(DEBUG)
-        LogTrace << "Create container data to receive" << std::endl;
+        LogTrace << "Asynchronous alltoall of " << nbItems << " objects per process" << std::endl;
 #       endif
-        rcv = new std::vector<typename K::value_type,typename K::allocator_type>(rcvobj.size());
+        int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Request req;
+        MPI_Ialltoall( bufsnd, count, mpi_data_type<K>(),
+                       bufrcv, count, mpi_data_type<K>(), m_communicator, &req );
+        return Request(req);
       }
-      
-      MPI_Request req;
-      if ( Type_MPI<typename K::value_type>::must_be_packed() ) {
-        MPI_Irecv(rcv->data(), rcv->size()*sizeof(typename K::value_type), MPI_BYTE,
-                  sender, tag, com, &req);
-      } else {
-        MPI_Irecv(rcv->data(), rcv->size(), Type_MPI<typename K::value_type>::mpi_type(),
-                  sender, tag, com, &req );
+      // .............................................................
+      template<typename K> Request ialltoall( const K& snd, K& rcv ) const
+      {
+        return Communication<K,is_container<K>::value>::ialltoall(m_communicator, snd, rcv);
       }
-
-      if ( !std::is_base_of<std::vector<typename K::value_type,
-                                       typename K::allocator_type>,K>::value ) {
-#       if defined(DEBUG)
-        LogTrace << "Copy temporary vector inside the container passed as parameter." << std::endl;
-#       endif        
-        std::copy(rcvobj.begin(), rcvobj.end(), rcv->begin());
-        delete rcv;
+      // .............................................................
+      // Persistent collective operations. Before MPI 4, the persistent collective
+      // operations are emulated with the non blocking collective operations.
+      template<typename K> Request
+      broadcast_init( std::size_t nbItems, const K* bufsnd, K* bufrcv, int root ) const
+      {
+        assert( bufrcv != nullptr );
+        bool copy = ( (root == getRank()) && (bufsnd != bufrcv) );
+        assert( !copy || (bufsnd != nullptr) );
+        int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Datatype type = mpi_data_type<K>();
+        MPI_Comm com = m_communicator;
+#       if MPI_VERSION >= 4
+        MPI_Request req;
+        MPI_Bcast_init( bufrcv, count, type, root, com, MPI_INFO_NULL, &req );
+        if ( !copy ) return Request::persistent(req);
+        return Request::persistent(req, [=] (MPI_Request& r) {
+            std::copy_n( bufsnd, nbItems, bufrcv );
+            MPI_Start(&r);
+          });
+#       else
+        return Request::persistent(MPI_REQUEST_NULL, [=] (MPI_Request& r) {
+            if ( copy ) std::copy_n( bufsnd, nbItems, bufrcv );
+            MPI_Ibcast( bufrcv, count, type, root, com, &r );
+          });
+#       endif
       }
-      
-      return Request(req);
-    }
-    // .......................................................................................
-    static void broadcast( const MPI_Comm& com, const K* obj_snd, K& obj_rcv, int root )
-    {
-      std::size_t szMsg = ( obj_snd != nullptr ? obj_snd->size() : obj_rcv.size() );
-#     if defined(DEBUG)
-      LogTrace << "Broadcast of a container with " << szMsg
-               << " elements with root = " << root << std::endl;
-#     endif      
-      std::vector<typename K::value_type,typename K::allocator_type>* rcv;
-      if ( std::is_base_of<std::vector<typename K::value_type,
-                                       typename K::allocator_type>,K>::value ) {
-        rcv = (std::vector<typename K::value_type,typename K::allocator_type>*)&obj_rcv;
-        if (szMsg > rcv->size()) {
-#         if defined(DEBUG)
-          LogTrace << "Realloc rcv vector to match broadcast size message" << std::endl;
-#         endif
-          std::vector<typename K::value_type,
-                      typename K::allocator_type>(obj_snd->size()).swap(*rcv);            
-        }
-      } else {
+      // .............................................................
+      template<typename K> Request
+      reduce_init( std::size_t nbItems, const K* objs, K* res, Operation op, int root ) const
+      {
+        assert(objs != nullptr);
+        const void* snd = ( (root == getRank()) && (objs == res) ? MPI_IN_PLACE : objs );
+        int count = int(nbItems);
+        MPI_Datatype type = Type_MPI<K>::mpi_type();
+        MPI_Comm com = m_communicator;
+#       if MPI_VERSION >= 4
+        MPI_Request req;
+        MPI_Reduce_init( snd, res, count, type, op, root, com, MPI_INFO_NULL, &req );
+        return Request::persistent(req);
+#       else
+        return Request::persistent(MPI_REQUEST_NULL, [=] (MPI_Request& r) {
+            MPI_Ireduce( snd, res, count, type, op, root, com, &r );
+          });
+#       endif
+      }
+      // .............................................................
+      template<typename K> Request
+      allreduce_init( std::size_t nbItems, const K* objs, K* res, Operation op ) const
+      {
+        assert(res != nullptr);
+        const void* snd = ( objs == res ? MPI_IN_PLACE : objs );
+        int count = int(nbItems);
+        MPI_Datatype type = Type_MPI<K>::mpi_type();
+        MPI_Comm com = m_communicator;
+#       if MPI_VERSION >= 4
+        MPI_Request req;
+        MPI_Allreduce_init( snd, res, count, type, op, com, MPI_INFO_NULL, &req );
+        return Request::persistent(req);
+#       else
+        return Request::persistent(MPI_REQUEST_NULL, [=] (MPI_Request& r) {
+            MPI_Iallreduce( snd, res, count, type, op, com, &r );
+          });
+#       endif
+      }
+      // .............................................................
+      template<typename K> Request
+      allgather_init( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+        assert(bufrcv != nullptr);
+        const void* snd = ( bufsnd == bufrcv + getRank()*nbItems ? MPI_IN_PLACE : bufsnd );
+        int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Datatype type = mpi_data_type<K>();
+        MPI_Comm com = m_communicator;
+#       if MPI_VERSION >= 4
+        MPI_Request req;
+        MPI_Allgather_init( snd, count, type, bufrcv, count, type, com, MPI_INFO_NULL, &req );
+        return Request::persistent(req);
+#       else
+        return Request::persistent(MPI_REQUEST_NULL, [=] (MPI_Request& r) {
+            MPI_Iallgather( snd, count, type, bufrcv, count, type, com, &r );
+          });
+#       endif
+      }
+      // .............................................................
+      template<typename K> Request
+      alltoall_init( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+        assert(bufsnd != nullptr);
+        assert(bufrcv != nullptr);
+        int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Datatype type = mpi_data_type<K>();
+        MPI_Comm com = m_communicator;
+#       if MPI_VERSION >= 4
+        MPI_Request req;
+        MPI_Alltoall_init( bufsnd, count, type, bufrcv, count, type, com, MPI_INFO_NULL, &req );
+        return Request::persistent(req);
+#       else
+        return Request::persistent(MPI_REQUEST_NULL, [=] (MPI_Request& r) {
+            MPI_Ialltoall( bufsnd, count, type, bufrcv, count, type, com, &r );
+          });
+#       endif
+      }
+      // .............................................................
+      template<typename K> void
+      allreduce( std::size_t nbItems, const K* objs, K* res, Operation op ) const
+      {
+        assert(res != nullptr);
 #       if defined(DEBUG)
-        LogTrace << "Create container data to receive" << std::endl;
+        LogTrace << "Allreduce operation on " << nbItems << " objects" << std::endl;
 #       endif
-        rcv = new std::vector<typename K::value_type,typename K::allocator_type>(szMsg);
+        if ( objs == res )
+          large_allreduce( MPI_IN_PLACE, res, nbItems, Type_MPI<K>::mpi_type(), op, m_communicator );
+        else {
+          assert(objs != nullptr);
+          large_allreduce( objs, res, nbItems, Type_MPI<K>::mpi_type(), op, m_communicator );
+        }
       }
-      
-      int rank;
-      MPI_Comm_rank(com, &rank);
-      if ( (root == rank) && (&obj_rcv != obj_snd) ) {
-        assert(obj_snd != nullptr);
-        std::copy(obj_snd->begin(), obj_snd->end(), obj_rcv.begin());
+      // .............................................................
+      template<typename K, typename F> void
+      allreduce( std::size_t nbItems, const K* objs, K* res,
+                 const F& fct, bool commute ) const
+      {
+        assert(objs != nullptr);
+        assert(res  != nullptr);
+        Operator<K,F> oper(fct, commute);
+        MPI_Op op = oper.mpi_op();
+        if ( objs == res )
+          large_allreduce( MPI_IN_PLACE, res, nbItems, Type_MPI<K>::mpi_type(), op, m_communicator );
+        else
+          large_allreduce( objs, res, nbItems, Type_MPI<K>::mpi_type(), op, m_communicator );
       }
-      if ( Type_MPI<typename K::value_type>::must_be_packed() ) {
-        MPI_Bcast(rcv->data(), rcv->size()*sizeof(typename K::value_type), MPI_BYTE, root, com );
-      } else {
-        MPI_Bcast(rcv->data(), rcv->size(), Type_MPI<typename K::value_type>::mpi_type(),
-                  root, com );
+      // .............................................................
+      template<typename K> void allreduce( const K& loc, K& glob, const Operation& op ) const
+      {
+        Communication<K,is_container<K>::value>::allreduce(m_communicator, loc, glob, op);
       }
-#     if defined(DEBUG)
-      LogTrace << "End of broadcasting" << std::endl;
-#     endif      
-      if ( !std::is_base_of<std::vector<typename K::value_type,
-                                        typename K::allocator_type>,K>::value ) {
+      // .............................................................
+      template<typename K> void
+      allgather( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+        assert(bufrcv != nullptr);
+#       if defined(DEBUG)
+        LogTrace << "Allgather of " << nbItems << " objects per process" << std::endl;
+#       endif
+        int count = int(nbItems)*mpi_item_size<K>();
+        if ( bufsnd == bufrcv + getRank()*nbItems )
+          MPI_Allgather( MPI_IN_PLACE, count, mpi_data_type<K>(),
+                         bufrcv, count, mpi_data_type<K>(), m_communicator );
+        else
+          MPI_Allgather( bufsnd, count, mpi_data_type<K>(),
+                         bufrcv, count, mpi_data_type<K>(), m_communicator );
+      }
+      // .............................................................
+      template<typename K> void
+      allgatherv( std::size_t nbItems, const K* bufsnd, const std::vector<int>& counts,
+                  K* bufrcv ) const
+      {
+        assert(bufrcv != nullptr);
+        assert(counts.size() == std::size_t(getSize()));
 #       if defined(DEBUG)
-        LogTrace << "Copy temporary vector inside the container passed as parameter." << std::endl;
+        LogTrace << "Allgatherv of " << nbItems << " objects" << std::endl;
 #       endif
-        std::copy(obj_rcv.begin(), obj_rcv.end(), rcv->begin());
-        delete rcv;
+        std::vector<int> mpi_cnts = mpi_counts<K>(counts);
+        std::vector<int> displs   = mpi_displacements(mpi_cnts);
+        MPI_Allgatherv( bufsnd, int(nbItems)*mpi_item_size<K>(), mpi_data_type<K>(),
+                        bufrcv, mpi_cnts.data(), displs.data(), mpi_data_type<K>(),
+                        m_communicator );
+      }
+      // .............................................................
+      template<typename K, typename R> void allgather( const K& obj, R& res ) const
+      {
+        Communication<K,is_container<K>::value>::allgather(m_communicator, obj, res);
+      }
+      // .............................................................
+      template<typename K> void allgatherv( const K& obj, K& res, std::vector<int>& counts ) const
+      {
+        Communication<K,is_container<K>::value>::allgatherv(m_communicator, obj, res, counts);
+      }
+      // .............................................................
+      template<typename K> void
+      gather( std::size_t nbItems, const K* bufsnd, K* bufrcv, int root ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Gather of " << nbItems << " objects per process with root = "
+                 << root << std::endl;
+#       endif
+        int count = int(nbItems)*mpi_item_size<K>();
+        if ( (root == getRank()) && (bufsnd == bufrcv + root*nbItems) )
+          MPI_Gather( MPI_IN_PLACE, count, mpi_data_type<K>(),
+                      bufrcv, count, mpi_data_type<K>(), root, m_communicator );
+        else
+          MPI_Gather( bufsnd, count, mpi_data_type<K>(),
+                      bufrcv, count, mpi_data_type<K>(), root, m_communicator );
+      }
+      // .............................................................
+      template<typename K> void
+      gatherv( std::size_t nbItems, const K* bufsnd, const std::vector<int>& counts,
+               K* bufrcv, int root ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Gatherv of " << nbItems << " objects with root = " << root << std::endl;
+#       endif
+        std::vector<int> mpi_cnts, displs;
+        if ( root == getRank() ) {
+          assert(counts.size() == std::size_t(getSize()));
+          assert(bufrcv != nullptr);
+          mpi_cnts = mpi_counts<K>(counts);
+          displs   = mpi_displacements(mpi_cnts);
+        }
+        MPI_Gatherv( bufsnd, int(nbItems)*mpi_item_size<K>(), mpi_data_type<K>(),
+                     bufrcv, mpi_cnts.data(), displs.data(), mpi_data_type<K>(),
+                     root, m_communicator );
+      }
+      // .............................................................
+      template<typename K, typename R> void gather( const K& obj, R& res, int root ) const
+      {
+        Communication<K,is_container<K>::value>::gather(m_communicator, obj, res, root);
+      }
+      // .............................................................
+      template<typename K> void gatherv( const K& obj, K& res, int root ) const
+      {
+        Communication<K,is_container<K>::value>::gatherv(m_communicator, obj, res, root);
+      }
+      // .............................................................
+      template<typename K> void
+      scatter( std::size_t nbItems, const K* bufsnd, K* bufrcv, int root ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Scatter of " << nbItems << " objects per process with root = "
+                 << root << std::endl;
+#       endif
+        int count = int(nbItems)*mpi_item_size<K>();
+        if ( (root == getRank()) && (bufrcv == bufsnd + root*nbItems) )
+          MPI_Scatter( bufsnd, count, mpi_data_type<K>(),
+                       MPI_IN_PLACE, count, mpi_data_type<K>(), root, m_communicator );
+        else
+          MPI_Scatter( bufsnd, count, mpi_data_type<K>(),
+                       bufrcv, count, mpi_data_type<K>(), root, m_communicator );
+      }
+      // .............................................................
+      template<typename K> void
+      scatterv( const K* bufsnd, const std::vector<int>& counts, std::size_t nbItems,
+                K* bufrcv, int root ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Scatterv of " << nbItems << " objects with root = " << root << std::endl;
+#       endif
+        std::vector<int> mpi_cnts, displs;
+        if ( root == getRank() ) {
+          assert(counts.size() == std::size_t(getSize()));
+          assert(bufsnd != nullptr);
+          mpi_cnts = mpi_counts<K>(counts);
+          displs   = mpi_displacements(mpi_cnts);
+        }
+        MPI_Scatterv( bufsnd, mpi_cnts.data(), displs.data(), mpi_data_type<K>(),
+                      bufrcv, int(nbItems)*mpi_item_size<K>(), mpi_data_type<K>(),
+                      root, m_communicator );
+      }
+      // .............................................................
+      template<typename S, typename K> void scatter( const S& snd, K& obj, int root ) const
+      {
+        Communication<K,is_container<K>::value>::scatter(m_communicator, snd, obj, root);
+      }
+      // .............................................................
+      template<typename K> void
+      scatterv( const K& snd, const std::vector<int>& counts, K& obj, int root ) const
+      {
+        Communication<K,is_container<K>::value>::scatterv(m_communicator, snd, counts, obj, root);
+      }
+      // .............................................................
+      template<typename K> void
+      alltoall( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+        assert(bufsnd != nullptr);
+        assert(bufrcv != nullptr);
+#       if defined(DEBUG)
+        LogTrace << "Alltoall of " << nbItems << " objects per process" << std::endl;
+#       endif
+        int count = int(nbItems)*mpi_item_size<K>();
+        if ( bufsnd == bufrcv )
+          MPI_Alltoall( MPI_IN_PLACE, count, mpi_data_type<K>(),
+                        bufrcv, count, mpi_data_type<K>(), m_communicator );
+        else
+          MPI_Alltoall( bufsnd, count, mpi_data_type<K>(),
+                        bufrcv, count, mpi_data_type<K>(), m_communicator );
+      }
+      // .............................................................
+      template<typename K> void
+      alltoallv( const K* bufsnd, const std::vector<int>& sndCounts,
+                 K* bufrcv, const std::vector<int>& rcvCounts ) const
+      {
+        assert(sndCounts.size() == std::size_t(getSize()));
+        assert(rcvCounts.size() == std::size_t(getSize()));
+#       if defined(DEBUG)
+        LogTrace << "Alltoallv" << std::endl;
+#       endif
+        std::vector<int> snd_cnts = mpi_counts<K>(sndCounts);
+        std::vector<int> snd_dspl = mpi_displacements(snd_cnts);
+        std::vector<int> rcv_cnts = mpi_counts<K>(rcvCounts);
+        std::vector<int> rcv_dspl = mpi_displacements(rcv_cnts);
+        MPI_Alltoallv( bufsnd, snd_cnts.data(), snd_dspl.data(), mpi_data_type<K>(),
+                       bufrcv, rcv_cnts.data(), rcv_dspl.data(), mpi_data_type<K>(),
+                       m_communicator );
+      }
+      // .............................................................
+      template<typename K> void alltoall( const K& snd, K& rcv ) const
+      {
+        Communication<K,is_container<K>::value>::alltoall(m_communicator, snd, rcv);
+      }
+      // .............................................................
+      template<typename K> void
+      alltoallv( const K& snd, const std::vector<int>& sndCounts, K& rcv,
+                 std::vector<int>& rcvCounts ) const
+      {
+        Communication<K,is_container<K>::value>::alltoallv(m_communicator, snd, sndCounts,
+                                                           rcv, rcvCounts);
+      }
+      // .............................................................
+      template<typename K> void
+      neighbor_allgather( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Neighbor allgather of " << nbItems << " objects per process" << std::endl;
+#       endif
+        int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Neighbor_allgather( bufsnd, count, mpi_data_type<K>(),
+                                bufrcv, count, mpi_data_type<K>(), m_communicator );
+      }
+      // .............................................................
+      template<typename K> void neighbor_allgather( const K& obj, std::vector<K>& res ) const
+      {
+        std::vector<int> sources, destinations;
+        neighbors( sources, destinations );
+        if ( res.size() != sources.size() ) std::vector<K>(sources.size()).swap(res);
+        neighbor_allgather( 1, &obj, res.data() );
+      }
+      // .............................................................
+      template<typename K> void
+      neighbor_alltoall( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Neighbor alltoall of " << nbItems << " objects per neighbor" << std::endl;
+#       endif
+        int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Neighbor_alltoall( bufsnd, count, mpi_data_type<K>(),
+                               bufrcv, count, mpi_data_type<K>(), m_communicator );
+      }
+      // .............................................................
+      template<typename K> void
+      neighbor_alltoallv( const K* bufsnd, const std::vector<int>& sndCounts,
+                          K* bufrcv, const std::vector<int>& rcvCounts ) const
+      {
+#       if defined(DEBUG)
+        LogTrace << "Neighbor alltoallv" << std::endl;
+#       endif
+        std::vector<int> snd_cnts = mpi_counts<K>(sndCounts);
+        std::vector<int> snd_dspl = mpi_displacements(snd_cnts);
+        std::vector<int> rcv_cnts = mpi_counts<K>(rcvCounts);
+        std::vector<int> rcv_dspl = mpi_displacements(rcv_cnts);
+        MPI_Neighbor_alltoallv( bufsnd, snd_cnts.data(), snd_dspl.data(), mpi_data_type<K>(),
+                                bufrcv, rcv_cnts.data(), rcv_dspl.data(), mpi_data_type<K>(),
+                                m_communicator );
+      }
+      // .............................................................
+      template<typename K> void neighbor_alltoall( const K& snd, K& rcv ) const
+      {
+        typedef Communication<K,true> Container;
+        typedef typename Container::value_type value_type;
+        std::vector<int> sources, destinations;
+        neighbors( sources, destinations );
+        std::size_t chunk = ( destinations.empty() ? 0 : snd.size()/destinations.size() );
+        assert(chunk*destinations.size() == snd.size());
+        typename Container::vector_type tmp_snd, tmp_rcv;
+        const value_type* pt_snd = Container::contiguous(snd, tmp_snd, &snd == &rcv);
+        value_type* pt_rcv = Container::storage(rcv, chunk*sources.size(), tmp_rcv);
+        neighbor_alltoall( chunk, pt_snd, pt_rcv );
+        Container::store(rcv, tmp_rcv);
+      }
+      // .............................................................
+      template<typename K> void
+      neighbor_alltoallv( const K& snd, const std::vector<int>& sndCounts, K& rcv,
+                          std::vector<int>& rcvCounts ) const
+      {
+        typedef Communication<K,true> Container;
+        typedef typename Container::value_type value_type;
+        std::vector<int> sources, destinations;
+        neighbors( sources, destinations );
+        assert(sndCounts.size() == destinations.size());
+        std::vector<int>(sources.size(), 0).swap(rcvCounts);
+        neighbor_alltoall( 1, sndCounts.data(), rcvCounts.data() );
+        std::size_t total = 0;
+        for ( int cnt : rcvCounts ) total += cnt;
+        typename Container::vector_type tmp_snd, tmp_rcv;
+        const value_type* pt_snd = Container::contiguous(snd, tmp_snd, &snd == &rcv);
+        value_type* pt_rcv = Container::storage(rcv, total, tmp_rcv);
+        neighbor_alltoallv( pt_snd, sndCounts, pt_rcv, rcvCounts );
+        Container::store(rcv, tmp_rcv);
       }
 
+    private:
+        MPI_Comm m_communicator;
+        mutable std::once_flag    m_worldRanksTranslated;
+        mutable std::vector<int>  m_worldRanks;
+    };
+    // -----------------------------------------------------------------
+  template<typename K>
+  struct Communicator::Implementation::Communication<K,true>
+  {
+    typedef typename K::value_type value_type;
+    typedef std::vector<value_type,typename container_allocator<K>::type> vector_type;
+    static constexpr bool is_vector = std::is_base_of<vector_type,K>::value;
+    static constexpr bool is_contiguous = is_contiguous_container<K>::value;
+    // .......................................................................................
+    static void send( const MPI_Comm& com, const K& snd_obj, int dest, int tag )
+    {
+      vector_type tmp;
+      const value_type* snd = contiguous(snd_obj, tmp);
+#     if defined(DEBUG)            
+      LogTrace << "Send a container with " << snd_obj.size() << " elements to " << dest
+               << " with tag " << tag << std::endl;
+#     endif
+      large_send(snd, snd_obj.size()*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                 dest, tag, com );
+    }
+    // .......................................................................................
+    static Request isend( const MPI_Comm& com, const K& snd_obj, int dest, int tag )
+    {
+      vector_type tmp;
+      const value_type* snd = contiguous(snd_obj, tmp);
+      MPI_Request m_req;
+      large_isend(snd, snd_obj.size()*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                  dest, tag, com, &m_req);
+#     if defined(DEBUG)            
+      LogTrace << "Asynchrone send for a container with " << snd_obj.size() << " elements  to "
+               << dest << " with tag " << tag << std::endl;
+#     endif        
+      return pending(m_req, std::move(tmp), vector_type(), nullptr);
+    }
+    // .......................................................................................
+    static Status recv( const MPI_Comm& com, K& rcvobj, int sender, int tag )
+    {
+      MPI_Status status;
+      MPI_Probe(sender, tag, com, &status);
+      std::size_t szMsg = large_count(status, mpi_data_type<value_type>())/mpi_item_size<value_type>();
+      vector_type tmp;
+      // A vector is only reallocated if it is too small to receive the message :
+      std::size_t nbItems = ( is_vector ? std::max(rcvobj.size(), szMsg) : szMsg );
+      value_type* rcv = storage(rcvobj, nbItems, tmp);
+#     if defined(DEBUG)
+      LogTrace << "Receive a container with " << szMsg << " elements  from " <<sender
+               << " with tag " << tag << std::endl;
+#     endif
+      large_recv(rcv, szMsg*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                 status.MPI_SOURCE, status.MPI_TAG, com, &status);
+#     if defined(DEBUG)      
+      LogTrace << "OK, receive done !" << std::endl;
+#     endif      
+      store(rcvobj, tmp);
+      return Status(status);
+    }
+    // .......................................................................................
+    static Request irecv( const MPI_Comm& com, K& rcvobj, int sender, int tag )
+    {
+#     if defined(DEBUG)
+      LogTrace << "Asynchronous receive of a container with " << rcvobj.size()
+               << " elements from " << sender << " with tag " << tag << std::endl;
+#     endif
+      vector_type tmp;
+      value_type* rcv = storage(rcvobj, rcvobj.size(), tmp);
+      MPI_Request req;
+      large_irecv(rcv, rcvobj.size()*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                  sender, tag, com, &req);
+      return pending(req, vector_type(), std::move(tmp), &rcvobj);
+    }
+    // .......................................................................................
+    static void broadcast( const MPI_Comm& com, const K* obj_snd, K& obj_rcv, int root )
+    {
+      int rank;
+      MPI_Comm_rank(com, &rank);
+      std::size_t szMsg = ( (rank == root) && (obj_snd != nullptr) ? obj_snd->size() : obj_rcv.size() );
+#     if defined(DEBUG)
+      LogTrace << "Broadcast of a container with " << szMsg
+               << " elements with root = " << root << std::endl;
+#     endif      
+      vector_type tmp;
+      value_type* rcv = storage(obj_rcv, szMsg, tmp);
+      // Without send object, the root broadcasts the content of obj_rcv :
+      if ( (rank == root) && (obj_snd != nullptr) && (&obj_rcv != obj_snd) ) {
+        std::copy(obj_snd->begin(), obj_snd->end(), rcv);
+      } else if ( (rank == root) && !tmp.empty() )
+        std::copy(obj_rcv.begin(), obj_rcv.end(), rcv);
+      large_bcast(rcv, szMsg*mpi_item_size<value_type>(), mpi_data_type<value_type>(), root, com );
+#     if defined(DEBUG)
+      LogTrace << "End of broadcasting" << std::endl;
+#     endif      
+      store(obj_rcv, tmp);
     }
     // .......................................................................................
     static void reduce( const MPI_Comm& com, const K& loc, K* glob,
@@ -622,51 +1502,526 @@ namespace Parallel
       LogTrace << "Reduce operation on one container with " << szMsg
                << " elements with root = " << root << std::endl;
 #     endif
-      std::vector<typename K::value_type,typename K::allocator_type>* glb;
-      std::vector<typename K::value_type,typename K::allocator_type>* lc;
-      if ( std::is_base_of<std::vector<typename K::value_type,
-                                       typename K::allocator_type>,K>::value ) {
-        glb = (std::vector<typename K::value_type,typename K::allocator_type>*)glob;
-        lc  = (const std::vector<typename K::value_type,typename K::allocator_type>*)&loc;
-        if ( glb != nullptr ) {
-          if (szMsg > glb->size()) {
-#           if defined(DEBUG)
-            LogTrace << "Realloc glb vector to match reduce size message" << std::endl;
-#           endif
-            std::vector<typename K::value_type,
-                        typename K::allocator_type>(szMsg).swap(*glb);
-          }
-        }
-      } else {
-#       if defined(DEBUG)
-        LogTrace << "Create container data to compute" << std::endl;
-#       endif
-        if ( rank == root )
-          glb = new std::vector<typename K::value_type,typename K::allocator_type>(szMsg);
-        else
-          glb = nullptr;
-        lc  = new std::vector<typename K::value_type,typename K::allocator_type>(szMsg);
-        std::copy(loc.begin(), loc.end(), lc->begin());
-      }
-      if ( glb != nullptr )
-        MPI_Reduce( lc->data(), glb->data(), szMsg, Type_MPI<typename K::value_type>::mpi_type(),
-                    op, root, com );
-      else
-        MPI_Reduce( lc->data(), nullptr, szMsg, Type_MPI<typename K::value_type>::mpi_type(),
-                    op, root, com );
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* snd = contiguous(loc, tmp_snd, (rank == root) && (&loc == glob));
+      value_type* rcv = nullptr;
+      if ( rank == root ) {
+        assert(glob != nullptr);
+        rcv = storage(*glob, szMsg, tmp_rcv);
+      }
+      large_reduce( snd, rcv, szMsg, Type_MPI<value_type>::mpi_type(), op, root, com );
 #     if defined(DEBUG)
       LogTrace << "End of reduction" << std::endl;
 #     endif
-      if ( rank == root )
-        if ( !std::is_base_of<std::vector<typename K::value_type,
-                                          typename K::allocator_type>,K>::value ) {
-          std::copy( glb->begin(), glb->end(), glob->begin() );
-          delete glb;
-          delete lc;
-        }
+      if ( rank == root ) store(*glob, tmp_rcv);
+    }
+    // .......................................................................................
+    // Contiguous data of the container ( copy in tmp if the container isn't contiguous
+    // or if the container is also used to receive data )
+    static const value_type* contiguous( const K& obj, vector_type& tmp, bool aliased = false )
+    {
+      if ( is_contiguous && !aliased ) return data(obj, std::integral_constant<bool,is_contiguous>());
+#     if defined(DEBUG)
+      LogTrace << "Copy container data inside a vector" << std::endl;
+#     endif
+      tmp.assign(obj.begin(), obj.end());
+      return tmp.data();
+    }
+    // Contiguous storage of nbItems elements to receive data in the container. The data are
+    // received directly in a vector ( resized if needed ) or in a contiguous container with
+    // the right size, else in tmp.
+    static value_type* storage( K& obj, std::size_t nbItems, vector_type& tmp )
+    {
+      if ( is_vector ) {
+        vector_type& rcv = (vector_type&)obj;
+        if ( rcv.size() != nbItems ) rcv.resize(nbItems);
+        return rcv.data();
+      }
+      if ( is_contiguous && (obj.size() == nbItems) )
+        return const_cast<value_type*>(data(obj, std::integral_constant<bool,is_contiguous>()));
+      tmp.resize(nbItems);
+      // Nothing will be copied from an empty tmp :
+      if ( nbItems == 0 ) assign(obj, tmp, std::is_constructible<K, typename vector_type::const_iterator,
+                                                                    typename vector_type::const_iterator>());
+      return tmp.data();
+    }
+    // Copy received data inside the container if they weren't received directly inside it
+    static void store( K& obj, const vector_type& tmp )
+    {
+      if ( is_vector || (is_contiguous && tmp.empty()) ) return;
+#     if defined(DEBUG)
+      LogTrace << "Copy temporary vector inside the container passed as parameter." << std::endl;
+#     endif
+      assign(obj, tmp, std::is_constructible<K, typename vector_type::const_iterator,
+                                             typename vector_type::const_iterator>());
+    }
+    // Only the containers with begin() and end() members come here ( not std::valarray,
+    // which must be exchanged as a buffer : size() and &v[0] )
+    static const value_type* data( const K& obj, std::true_type ) { return obj.data(); }
+    static const value_type* data( const K&, std::false_type ) { return nullptr; }
+    static void assign( K& obj, const vector_type& tmp, std::true_type )
+    {
+      obj = K(tmp.begin(), tmp.end());
+    }
+    // Containers with a fixed size ( std::array by example ) :
+    static void assign( K& obj, const vector_type& tmp, std::false_type )
+    {
+      std::copy_n(tmp.begin(), std::min(tmp.size(), std::size_t(obj.size())), obj.begin());
+    }
+    // Request keeping the temporary buffers alive until the completion of the communication
+    // and copying the received data inside the container ( if rcvobj isn't null )
+    static Request pending( MPI_Request req, vector_type&& tmp_snd, vector_type&& tmp_rcv,
+                            K* rcvobj )
+    {
+      if ( is_contiguous && tmp_snd.empty() && tmp_rcv.empty() ) return Request(req);
+      auto buffers = std::make_shared<std::pair<vector_type,vector_type>>(std::move(tmp_snd),
+                                                                          std::move(tmp_rcv));
+      return Request(req, [buffers, rcvobj] () {
+          if ( rcvobj != nullptr ) store(*rcvobj, buffers->second);
+        });
+    }
+    // .......................................................................................
+    static void allreduce( const MPI_Comm& com, const K& loc, K& glob, const Operation& op )
+    {
+#     if defined(DEBUG)
+      LogTrace << "Allreduce operation on one container with " << loc.size()
+               << " elements" << std::endl;
+#     endif
+      std::size_t szMsg = loc.size();
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* snd = contiguous(loc, tmp_snd, &loc == &glob);
+      value_type* rcv = storage(glob, szMsg, tmp_rcv);
+      large_allreduce( snd, rcv, szMsg, Type_MPI<value_type>::mpi_type(), op, com );
+      store(glob, tmp_rcv);
+    }
+    // .......................................................................................
+    static void allgather( const MPI_Comm& com, const K& snd, K& rcv )
+    {
+      int size;
+      MPI_Comm_size(com, &size);
+      std::size_t szMsg = snd.size();
+#     if defined(DEBUG)
+      LogTrace << "Allgather of a container with " << szMsg << " elements" << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, &snd == &rcv);
+      value_type* pt_rcv = storage(rcv, size*szMsg, tmp_rcv);
+      int count = int(szMsg)*mpi_item_size<value_type>();
+      MPI_Allgather( pt_snd, count, mpi_data_type<value_type>(),
+                     pt_rcv, count, mpi_data_type<value_type>(), com );
+      store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static void allgatherv( const MPI_Comm& com, const K& snd, K& rcv, std::vector<int>& counts )
+    {
+      int size;
+      MPI_Comm_size(com, &size);
+      int szMsg = int(snd.size());
+      std::vector<int>(size).swap(counts);
+      MPI_Allgather( &szMsg, 1, MPI_INT, counts.data(), 1, MPI_INT, com );
+#     if defined(DEBUG)
+      LogTrace << "Allgatherv of a container with " << szMsg << " elements" << std::endl;
+#     endif
+      std::vector<int> mpi_cnts = mpi_counts<value_type>(counts);
+      std::vector<int> displs   = mpi_displacements(mpi_cnts);
+      std::size_t total = ( size > 0 ? (displs.back() + mpi_cnts.back())/mpi_item_size<value_type>() : 0 );
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, &snd == &rcv);
+      value_type* pt_rcv = storage(rcv, total, tmp_rcv);
+      MPI_Allgatherv( pt_snd, szMsg*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                      pt_rcv, mpi_cnts.data(), displs.data(), mpi_data_type<value_type>(), com );
+      store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static void gather( const MPI_Comm& com, const K& snd, K& rcv, int root )
+    {
+      int rank, size;
+      MPI_Comm_rank(com, &rank);
+      MPI_Comm_size(com, &size);
+      std::size_t szMsg = snd.size();
+#     if defined(DEBUG)
+      LogTrace << "Gather of a container with " << szMsg << " elements with root = "
+               << root << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, (rank == root) && (&snd == &rcv));
+      value_type* pt_rcv = nullptr;
+      if ( rank == root ) {
+        pt_rcv = storage(rcv, size*szMsg, tmp_rcv);
+      }
+      int count = int(szMsg)*mpi_item_size<value_type>();
+      MPI_Gather( pt_snd, count, mpi_data_type<value_type>(),
+                  pt_rcv, count, mpi_data_type<value_type>(), root, com );
+      if ( rank == root ) store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static void gatherv( const MPI_Comm& com, const K& snd, K& rcv, int root )
+    {
+      int rank, size;
+      MPI_Comm_rank(com, &rank);
+      MPI_Comm_size(com, &size);
+      int szMsg = int(snd.size());
+      std::vector<int> counts( rank == root ? size : 0 );
+      MPI_Gather( &szMsg, 1, MPI_INT, counts.data(), 1, MPI_INT, root, com );
+#     if defined(DEBUG)
+      LogTrace << "Gatherv of a container with " << szMsg << " elements with root = "
+               << root << std::endl;
+#     endif
+      std::vector<int> mpi_cnts = mpi_counts<value_type>(counts);
+      std::vector<int> displs   = mpi_displacements(mpi_cnts);
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, (rank == root) && (&snd == &rcv));
+      value_type* pt_rcv = nullptr;
+      if ( rank == root ) {
+        std::size_t total = (displs.back() + mpi_cnts.back())/mpi_item_size<value_type>();
+        pt_rcv = storage(rcv, total, tmp_rcv);
+      }
+      MPI_Gatherv( pt_snd, szMsg*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                   pt_rcv, mpi_cnts.data(), displs.data(), mpi_data_type<value_type>(),
+                   root, com );
+      if ( rank == root ) store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static void scatter( const MPI_Comm& com, const K& snd, K& rcv, int root )
+    {
+      int rank;
+      MPI_Comm_rank(com, &rank);
+      std::size_t szMsg = rcv.size();
+#     if defined(DEBUG)
+      LogTrace << "Scatter of containers with " << szMsg << " elements with root = "
+               << root << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = nullptr;
+      if ( rank == root ) {
+        pt_snd = contiguous(snd, tmp_snd, &snd == &rcv);
+      }
+      value_type* pt_rcv = storage(rcv, szMsg, tmp_rcv);
+      int count = int(szMsg)*mpi_item_size<value_type>();
+      MPI_Scatter( pt_snd, count, mpi_data_type<value_type>(),
+                   pt_rcv, count, mpi_data_type<value_type>(), root, com );
+      store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static void scatterv( const MPI_Comm& com, const K& snd, const std::vector<int>& counts,
+                          K& rcv, int root )
+    {
+      int rank, size;
+      MPI_Comm_rank(com, &rank);
+      MPI_Comm_size(com, &size);
+      int szMsg;
+      MPI_Scatter( counts.data(), 1, MPI_INT, &szMsg, 1, MPI_INT, root, com );
+#     if defined(DEBUG)
+      LogTrace << "Scatterv of a container with " << szMsg << " elements with root = "
+               << root << std::endl;
+#     endif
+      std::vector<int> mpi_cnts, displs;
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = nullptr;
+      if ( rank == root ) {
+        assert(counts.size() == std::size_t(size));
+        mpi_cnts = mpi_counts<value_type>(counts);
+        displs   = mpi_displacements(mpi_cnts);
+        pt_snd   = contiguous(snd, tmp_snd, &snd == &rcv);
+      }
+      value_type* pt_rcv = storage(rcv, szMsg, tmp_rcv);
+      MPI_Scatterv( pt_snd, mpi_cnts.data(), displs.data(), mpi_data_type<value_type>(),
+                    pt_rcv, szMsg*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                    root, com );
+      store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static void alltoall( const MPI_Comm& com, const K& snd, K& rcv )
+    {
+      int size;
+      MPI_Comm_size(com, &size);
+      std::size_t szMsg = snd.size();
+      assert(szMsg % size == 0);
+#     if defined(DEBUG)
+      LogTrace << "Alltoall of a container with " << szMsg << " elements" << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, &snd == &rcv);
+      value_type* pt_rcv = storage(rcv, szMsg, tmp_rcv);
+      int count = int(szMsg/size)*mpi_item_size<value_type>();
+      MPI_Alltoall( pt_snd, count, mpi_data_type<value_type>(),
+                    pt_rcv, count, mpi_data_type<value_type>(), com );
+      store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static void alltoallv( const MPI_Comm& com, const K& snd, const std::vector<int>& sndCounts,
+                           K& rcv, std::vector<int>& rcvCounts )
+    {
+      int size;
+      MPI_Comm_size(com, &size);
+      assert(sndCounts.size() == std::size_t(size));
+      std::vector<int>(size).swap(rcvCounts);
+      MPI_Alltoall( sndCounts.data(), 1, MPI_INT, rcvCounts.data(), 1, MPI_INT, com );
+#     if defined(DEBUG)
+      LogTrace << "Alltoallv of a container with " << snd.size() << " elements" << std::endl;
+#     endif
+      std::vector<int> snd_cnts = mpi_counts<value_type>(sndCounts);
+      std::vector<int> snd_dspl = mpi_displacements(snd_cnts);
+      std::vector<int> rcv_cnts = mpi_counts<value_type>(rcvCounts);
+      std::vector<int> rcv_dspl = mpi_displacements(rcv_cnts);
+      std::size_t total = (rcv_dspl.back() + rcv_cnts.back())/mpi_item_size<value_type>();
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, &snd == &rcv);
+      value_type* pt_rcv = storage(rcv, total, tmp_rcv);
+      MPI_Alltoallv( pt_snd, snd_cnts.data(), snd_dspl.data(), mpi_data_type<value_type>(),
+                     pt_rcv, rcv_cnts.data(), rcv_dspl.data(), mpi_data_type<value_type>(), com );
+      store(rcv, tmp_rcv);
+    }
+    // .......................................................................................
+    static Request send_init( const MPI_Comm& com, const K& snd_obj, int dest, int tag )
+    {
+      std::size_t szMsg = snd_obj.size();
+#     if defined(DEBUG)
+      LogTrace << "Persistent send for a container with " << szMsg << " elements to "
+               << dest << " with tag " << tag << std::endl;
+#     endif
+      MPI_Request req;
+      int count = int(szMsg)*mpi_item_size<value_type>();
+      if ( is_contiguous ) {
+        MPI_Send_init(data(snd_obj, std::integral_constant<bool,is_contiguous>()), count,
+                      mpi_data_type<value_type>(), dest, tag, com, &req);
+        return Request::persistent(req);
+      }
+      // The temporary buffer is updated with the container data at each start :
+      auto tmp = std::make_shared<vector_type>(szMsg);
+      MPI_Send_init(tmp->data(), count, mpi_data_type<value_type>(), dest, tag, com, &req);
+      const K* obj = &snd_obj;
+      return Request::persistent(req, [tmp, obj] (MPI_Request& r) {
+          std::copy(obj->begin(), obj->end(), tmp->begin());
+          MPI_Start(&r);
+        });
+    }
+    // .......................................................................................
+    static Request recv_init( const MPI_Comm& com, K& rcvobj, int sender, int tag )
+    {
+      std::size_t szMsg = rcvobj.size();
+#     if defined(DEBUG)
+      LogTrace << "Persistent receive of a container with " << szMsg << " elements from "
+               << sender << " with tag " << tag << std::endl;
+#     endif
+      MPI_Request req;
+      int count = int(szMsg)*mpi_item_size<value_type>();
+      if ( is_contiguous ) {
+        MPI_Recv_init(const_cast<value_type*>(data(rcvobj, std::integral_constant<bool,is_contiguous>())),
+                      count, mpi_data_type<value_type>(), sender, tag, com, &req);
+        return Request::persistent(req);
+      }
+      // The received data are copied in the container at each completion :
+      auto tmp = std::make_shared<vector_type>(szMsg);
+      MPI_Recv_init(tmp->data(), count, mpi_data_type<value_type>(), sender, tag, com, &req);
+      K* obj = &rcvobj;
+      return Request::persistent(req, Request::Starter(), [tmp, obj] () {
+          std::copy(tmp->begin(), tmp->end(), obj->begin());
+        });
+    }
+    // .......................................................................................
+    static Request ibroadcast( const MPI_Comm& com, const K* obj_snd, K& obj_rcv, int root )
+    {
+      int rank;
+      MPI_Comm_rank(com, &rank);
+      std::size_t szMsg = ( (rank == root) && (obj_snd != nullptr) ? obj_snd->size() : obj_rcv.size() );
+#     if defined(DEBUG)
+      LogTrace << "Asynchronous broadcast of a container with " << szMsg
+               << " elements with root = " << root << std::endl;
+#     endif
+      vector_type tmp;
+      value_type* rcv = storage(obj_rcv, szMsg, tmp);
+      // Without send object, the root broadcasts the content of obj_rcv :
+      if ( (rank == root) && (obj_snd != nullptr) && (&obj_rcv != obj_snd) ) {
+        std::copy(obj_snd->begin(), obj_snd->end(), rcv);
+      } else if ( (rank == root) && !tmp.empty() )
+        std::copy(obj_rcv.begin(), obj_rcv.end(), rcv);
+      MPI_Request req;
+      large_ibcast( rcv, szMsg*mpi_item_size<value_type>(), mpi_data_type<value_type>(),
+                    root, com, &req );
+      return pending(req, vector_type(), std::move(tmp), &obj_rcv);
+    }
+    // .......................................................................................
+    static Request ireduce( const MPI_Comm& com, const K& loc, K* glob,
+                            const Operation& op, int root )
+    {
+      int rank;
+      MPI_Comm_rank(com, &rank);
+      std::size_t szMsg = loc.size();
+#     if defined(DEBUG)
+      LogTrace << "Asynchronous reduce operation on one container with " << szMsg
+               << " elements with root = " << root << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* snd = contiguous(loc, tmp_snd, &loc == glob);
+      value_type* rcv = nullptr;
+      if ( rank == root ) {
+        assert(glob != nullptr);
+        rcv = storage(*glob, szMsg, tmp_rcv);
+      }
+      MPI_Request req;
+      MPI_Ireduce( snd, rcv, szMsg, Type_MPI<value_type>::mpi_type(), op, root, com, &req );
+      return pending(req, std::move(tmp_snd), std::move(tmp_rcv), (rank == root ? glob : nullptr));
+    }
+    // .......................................................................................
+    static Request iallreduce( const MPI_Comm& com, const K& loc, K& glob, const Operation& op )
+    {
+      std::size_t szMsg = loc.size();
+#     if defined(DEBUG)
+      LogTrace << "Asynchronous allreduce operation on one container with " << szMsg
+               << " elements" << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* snd = contiguous(loc, tmp_snd, &loc == &glob);
+      value_type* rcv = storage(glob, szMsg, tmp_rcv);
+      MPI_Request req;
+      MPI_Iallreduce( snd, rcv, szMsg, Type_MPI<value_type>::mpi_type(), op, com, &req );
+      return pending(req, std::move(tmp_snd), std::move(tmp_rcv), &glob);
+    }
+    // .......................................................................................
+    static Request iallgather( const MPI_Comm& com, const K& snd, K& rcv )
+    {
+      int size;
+      MPI_Comm_size(com, &size);
+      std::size_t szMsg = snd.size();
+#     if defined(DEBUG)
+      LogTrace << "Asynchronous allgather of a container with " << szMsg << " elements" << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, &snd == &rcv);
+      value_type* pt_rcv = storage(rcv, size*szMsg, tmp_rcv);
+      int count = int(szMsg)*mpi_item_size<value_type>();
+      MPI_Request req;
+      MPI_Iallgather( pt_snd, count, mpi_data_type<value_type>(),
+                      pt_rcv, count, mpi_data_type<value_type>(), com, &req );
+      return pending(req, std::move(tmp_snd), std::move(tmp_rcv), &rcv);
+    }
+    // .......................................................................................
+    static Request ialltoall( const MPI_Comm& com, const K& snd, K& rcv )
+    {
+      int size;
+      MPI_Comm_size(com, &size);
+      std::size_t szMsg = snd.size();
+      assert(szMsg % size == 0);
+#     if defined(DEBUG)
+      LogTrace << "Asynchronous alltoall of a container with " << szMsg << " elements" << std::endl;
+#     endif
+      vector_type tmp_snd, tmp_rcv;
+      const value_type* pt_snd = contiguous(snd, tmp_snd, &snd == &rcv);
+      value_type* pt_rcv = storage(rcv, szMsg, tmp_rcv);
+      int count = int(szMsg/size)*mpi_item_size<value_type>();
+      MPI_Request req;
+      MPI_Ialltoall( pt_snd, count, mpi_data_type<value_type>(),
+                     pt_rcv, count, mpi_data_type<value_type>(), com, &req );
+      return pending(req, std::move(tmp_snd), std::move(tmp_rcv), &rcv);
     }
-    // Continue for reduce and reduce_all
   };      
+  // -----------------------------------------------------------------
+  // Strided views are exchanged with a MPI vector datatype ( without copy ). The datatype
+  // can be freed as soon as the communication is posted.
+  template<typename K>
+  struct Communicator::Implementation::Communication<StridedView<K>,false>
+  {
+    typedef typename std::remove_const<K>::type value_type;
+    static MPI_Datatype datatype( const StridedView<K>& view )
+    {
+      MPI_Datatype type;
+      MPI_Type_vector( int(view.nbBlocks()), int(view.blockLength()), int(view.stride()),
+                       Type_MPI<value_type>::mpi_type(), &type );
+      MPI_Type_commit( &type );
+      return type;
+    }
+    // .......................................................................................
+    static void send( const MPI_Comm& com, const StridedView<K>& view, int dest, int tag )
+    {
+#     if defined(DEBUG)
+      LogTrace << "Send a strided view with " << view.size() << " elements to " << dest
+               << " with tag " << tag << std::endl;
+#     endif
+      MPI_Datatype type = datatype(view);
+      MPI_Send( view.data(), 1, type, dest, tag, com );
+      MPI_Type_free( &type );
+    }
+    // .......................................................................................
+    static Request isend( const MPI_Comm& com, const StridedView<K>& view, int dest, int tag )
+    {
+      MPI_Datatype type = datatype(view);
+      MPI_Request req;
+      MPI_Isend( view.data(), 1, type, dest, tag, com, &req );
+      MPI_Type_free( &type );
+      return Request(req);
+    }
+    // .......................................................................................
+    static Status recv( const MPI_Comm& com, const StridedView<K>& view, int sender, int tag )
+    {
+#     if defined(DEBUG)
+      LogTrace << "Receive a strided view with " << view.size() << " elements from " << sender
+               << " with tag " << tag << std::endl;
+#     endif
+      MPI_Datatype type = datatype(view);
+      Status status;
+      MPI_Recv( view.data(), 1, type, sender, tag, com, &status.status );
+      MPI_Type_free( &type );
+      return status;
+    }
+    // .......................................................................................
+    static Request irecv( const MPI_Comm& com, const StridedView<K>& view, int sender, int tag )
+    {
+      MPI_Datatype type = datatype(view);
+      MPI_Request req;
+      MPI_Irecv( view.data(), 1, type, sender, tag, com, &req );
+      MPI_Type_free( &type );
+      return Request(req);
+    }
+    // .......................................................................................
+    static Request send_init( const MPI_Comm& com, const StridedView<K>& view, int dest, int tag )
+    {
+      MPI_Datatype type = datatype(view);
+      MPI_Request req;
+      MPI_Send_init( view.data(), 1, type, dest, tag, com, &req );
+      MPI_Type_free( &type );
+      return Request::persistent(req);
+    }
+    // .......................................................................................
+    static Request recv_init( const MPI_Comm& com, const StridedView<K>& view, int sender, int tag )
+    {
+      MPI_Datatype type = datatype(view);
+      MPI_Request req;
+      MPI_Recv_init( view.data(), 1, type, sender, tag, com, &req );
+      MPI_Type_free( &type );
+      return Request::persistent(req);
+    }
+    // .......................................................................................
+    static void broadcast( const MPI_Comm& com, const StridedView<K>* snd, const StridedView<K>& view,
+                           int root )
+    {
+      int rank;
+      MPI_Comm_rank(com, &rank);
+      if ( (rank == root) && (snd != nullptr) && (snd->data() != view.data()) ) {
+        assert(snd->size() == view.size());
+        for ( std::size_t i = 0; i < view.size(); ++i ) view[i] = (*snd)[i];
+      }
+      MPI_Datatype type = datatype(view);
+      NodeHierarchy::bcast( view.data(), 1, type, root, com );
+      MPI_Type_free( &type );
+    }
+    // .......................................................................................
+    static Request ibroadcast( const MPI_Comm& com, const StridedView<K>* snd,
+                               const StridedView<K>& view, int root )
+    {
+      int rank;
+      MPI_Comm_rank(com, &rank);
+      if ( (rank == root) && (snd != nullptr) && (snd->data() != view.data()) ) {
+        assert(snd->size() == view.size());
+        for ( std::size_t i = 0; i < view.size(); ++i ) view[i] = (*snd)[i];
+      }
+      MPI_Datatype type = datatype(view);
+      MPI_Request req;
+      MPI_Ibcast( view.data(), 1, type, root, com, &req );
+      MPI_Type_free( &type );
+      return Request(req);
+    }
+  };
 
 }
 
@@ -11,96 +11,1110 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
-// Stub for parallel library ( to work on standalone computer by example )
+// Stub for parallel library ( to work on standalone computer by example ) :
+// the processes are simulated by the threads of a ThreadGroup ( one thread
+// by default, see Context::launch to run several threads ).
+#ifndef _PARALLEL_COMMUNICATOR_STUB_HPP_
+#  define _PARALLEL_COMMUNICATOR_STUB_HPP_
 # include <algorithm>
+# include <functional>
 # include <iostream>
+# include <memory>
+# include <stdexcept>
+# include <thread>
+# include <type_traits>
+# include <vector>
 # include "Parallel/Status.hpp"
 # include "Parallel/Constantes.hpp"
+# include "Parallel/DetectContainer.hpp"
+# include "Parallel/StridedView.hpp"
+# include "Parallel/ThreadGroup.hpp"
 namespace Parallel
 {
+    namespace
+    {
+        // Items of an object to exchange : a scalar is one item, the items of a
+        // container or of a strided view are copied one by one.
+        template<typename K, bool is_cont = is_container<K>::value> struct Items
+        {
+            typedef K value_type;
+            static std::size_t size( const K& ) { return 1; }
+            static void copy( const K& obj, value_type* items ) { *items = obj; }
+            static void assign( K& obj, const value_type* items, std::size_t nbItems )
+            {
+                if ( nbItems > 0 ) obj = *items;
+            }
+            static void set( K& obj, const K& src ) { obj = src; }
+        };
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> struct Items<K,true>
+        {
+            typedef typename std::remove_const<typename K::value_type>::type value_type;
+            static std::size_t size( const K& obj ) { return obj.size(); }
+            static void copy( const K& obj, value_type* items ) { std::copy( obj.begin(), obj.end(), items ); }
+            static void assign( K& obj, const value_type* items, std::size_t nbItems )
+            {
+                assign( obj, items, nbItems,
+                        std::is_constructible<K, const value_type*, const value_type*>() );
+            }
+            static void assign( K& obj, const value_type* items, std::size_t nbItems, std::true_type )
+            {
+                obj = K( items, items + nbItems );
+            }
+            // Container with a fixed size ( std::array by example ) :
+            static void assign( K& obj, const value_type* items, std::size_t nbItems, std::false_type )
+            {
+                std::copy_n( items, std::min(nbItems, std::size_t(obj.size())), obj.begin() );
+            }
+            static void set( K& obj, const K& src ) { obj = src; }
+        };
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> struct Items<StridedView<K>,false>
+        {
+            typedef typename std::remove_const<K>::type value_type;
+            static std::size_t size( const StridedView<K>& view ) { return view.size(); }
+            static void copy( const StridedView<K>& view, value_type* items )
+            {
+                for ( std::size_t i = 0; i < view.size(); ++i ) items[i] = view[i];
+            }
+            static void assign( StridedView<K>& view, const value_type* items, std::size_t nbItems )
+            {
+                for ( std::size_t i = 0; i < std::min(nbItems, view.size()); ++i ) view[i] = items[i];
+            }
+            static void set( StridedView<K>& view, const StridedView<K>& src )
+            {
+                for ( std::size_t i = 0; i < std::min(view.size(), src.size()); ++i ) view[i] = src[i];
+            }
+        };
+        // .............................................................
+        // Predefined operations. An operation not defined for a type throws an exception.
+#       define PARALLEL_STUB_OPERATION(name, expr) \
+        template<typename K> auto name( const K& a, const K& b, int ) -> decltype(K(expr)) \
+        { return K(expr); } \
+        template<typename K> K name( const K& a, const K&, long ) \
+        { throw std::invalid_argument("Parallel : operation not defined for this type"); return a; }
+        PARALLEL_STUB_OPERATION(op_max, a < b ? b : a)
+        PARALLEL_STUB_OPERATION(op_min, b < a ? b : a)
+        PARALLEL_STUB_OPERATION(op_sum, a + b)
+        PARALLEL_STUB_OPERATION(op_prod, a * b)
+        PARALLEL_STUB_OPERATION(op_land, a && b)
+        PARALLEL_STUB_OPERATION(op_band, a & b)
+        PARALLEL_STUB_OPERATION(op_lor, a || b)
+        PARALLEL_STUB_OPERATION(op_bor, a | b)
+        PARALLEL_STUB_OPERATION(op_lxor, bool(a) != bool(b))
+        PARALLEL_STUB_OPERATION(op_bxor, a ^ b)
+#       undef PARALLEL_STUB_OPERATION
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> K apply( Operation op, const K& a, const K& b )
+        {
+            switch(op) {
+            case max:         return op_max (a, b, 0);
+            case min:         return op_min (a, b, 0);
+            case sum:         return op_sum (a, b, 0);
+            case prod:        return op_prod(a, b, 0);
+            case logical_and: return op_land(a, b, 0);
+            case binary_and:  return op_band(a, b, 0);
+            case logical_or:  return op_lor (a, b, 0);
+            case binary_or:   return op_bor (a, b, 0);
+            case logical_xor: return op_lxor(a, b, 0);
+            case binary_xor:  return op_bxor(a, b, 0);
+            case replace:     return b;
+            case no_op:       return a;
+            default:
+                throw std::invalid_argument("Parallel : operation not supported without MPI");
+            }
+        }
+    }
+    // =================================================================
     struct Communicator::Implementation
     {
-        Implementation() : m_pt_sendbuffer(nullptr)
-        {}
-        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
+        Implementation() : m_group(ThreadGroup::world()),
+                           m_rank(ThreadGroup::worldRank()),
+                           m_worldRanks(m_group->size())
+        {
+            for ( int r = 0; r < m_group->size(); ++r ) m_worldRanks[r] = r;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
         Implementation( const Implementation& impl, int color, int key ) :
-                            m_pt_sendbuffer(nullptr)
-        {}
-        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
+                            m_rank(undefined)
+        {
+            impl.split( color, key, m_group, m_rank, m_worldRanks );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // All the threads share the memory :
+        Implementation( const Implementation& impl, Communicator::split_type, int key ) :
+                            m_rank(undefined)
+        {
+            impl.split( 0, key, m_group, m_rank, m_worldRanks );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // The duplicated communicator keeps the topology :
         Implementation( const Implementation& impl ) :
-                            m_pt_sendbuffer(nullptr)
-        {}
+                            m_rank(undefined), m_dims(impl.m_dims), m_periods(impl.m_periods),
+                            m_sources(impl.m_sources), m_destinations(impl.m_destinations),
+                            m_cartesian(impl.m_cartesian)
+        {
+            impl.split( 0, impl.m_rank, m_group, m_rank, m_worldRanks );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // The threads are never reordered :
+        Implementation( const Implementation& impl, const std::vector<int>& dims,
+                        const std::vector<bool>& periods, bool ) :
+                            m_rank(undefined), m_dims(dims), m_periods(periods), m_cartesian(true)
+        {
+            impl.split( 0, impl.m_rank, m_group, m_rank, m_worldRanks );
+            cartesian_neighbors();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // The processes with the same coordinates in the removed dimensions are grouped
+        Implementation( const Implementation& cart, const std::vector<bool>& remainDims ) :
+                            m_rank(undefined), m_cartesian(true)
+        {
+            std::vector<int> coords = cart.coordinates( cart.m_rank );
+            int color = 0;
+            for ( std::size_t d = 0; d < cart.m_dims.size(); ++d ) {
+                if ( remainDims[d] ) {
+                    m_dims.push_back( cart.m_dims[d] );
+                    m_periods.push_back( cart.m_periods[d] );
+                }
+                else color = color*cart.m_dims[d] + coords[d];
+            }
+            cart.split( color, cart.m_rank, m_group, m_rank, m_worldRanks );
+            cartesian_neighbors();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        Implementation( const Implementation& impl, const std::vector<int>& sources,
+                        const std::vector<int>& destinations, bool ) :
+                            m_rank(undefined), m_sources(sources), m_destinations(destinations)
+        {
+            impl.split( 0, impl.m_rank, m_group, m_rank, m_worldRanks );
+        }
         // .............................................................
         Implementation( const Ext_Communicator& com ) :
-                            m_pt_sendbuffer(nullptr)
-        {}
-        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
+                            m_rank(undefined)
+        {
+            Implementation().split( 0, ThreadGroup::worldRank(), m_group, m_rank, m_worldRanks );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
         ~Implementation() {}
         // .............................................................
-        int getRank() const { return 0; }
-        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
-        int getSize() const { return 1; }
+        int getRank() const { return m_rank; }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        int getSize() const { return ( m_group ? m_group->size() : 0 ); }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        int worldRank( int rank ) const { return m_worldRanks[rank]; }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // All the threads share the same memory : there is only one node.
+        void setHierarchical( bool hierarchical ) { m_hierarchical = hierarchical; }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        bool isHierarchical() const { return m_hierarchical; }
         // .............................................................
+        // Cartesian topology : the coordinates are ordered by rank, the last
+        // dimension varying first ( as with MPI ).
+        int nbDimensions() const { return int(m_dims.size()); }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        void cartesian( std::vector<int>& dims, std::vector<bool>& periods,
+                        std::vector<int>& coords ) const
+        {
+            dims    = m_dims;
+            periods = m_periods;
+            coords  = coordinates( m_rank );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        std::vector<int> coordinates( int rank ) const
+        {
+            std::vector<int> coords( m_dims.size() );
+            for ( std::size_t d = m_dims.size(); d > 0; --d ) {
+                coords[d-1] = rank % m_dims[d-1];
+                rank /= m_dims[d-1];
+            }
+            return coords;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Coordinates outside a non periodic dimension give no_process
+        int rankOf( const std::vector<int>& coords ) const
+        {
+            int rank = 0;
+            for ( std::size_t d = 0; d < m_dims.size(); ++d ) {
+                int c = coords[d];
+                if ( m_periods[d] ) c = ( (c % m_dims[d]) + m_dims[d] ) % m_dims[d];
+                else if ( (c < 0) || (c >= m_dims[d]) ) return no_process;
+                rank = rank*m_dims[d] + c;
+            }
+            return rank;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        std::pair<int,int> shift( int direction, int displacement ) const
+        {
+            std::vector<int> coords = coordinates( m_rank );
+            coords[direction] -= displacement;
+            int source = rankOf( coords );
+            coords[direction] += 2*displacement;
+            return std::make_pair( source, rankOf( coords ) );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // The prime factors of the number of processes are given to the free
+        // dimensions, the largest factor to the smallest dimension.
+        static std::vector<int> dimensions( int nbProcs, const std::vector<int>& dims )
+        {
+            std::vector<int> res(dims);
+            std::vector<std::size_t> free;
+            int remain = nbProcs;
+            for ( std::size_t d = 0; d < res.size(); ++d ) {
+                if ( res[d] > 0 ) remain /= res[d];
+                else {
+                    free.push_back(d);
+                    res[d] = 1;
+                }
+            }
+            if ( free.empty() ) return res;
+            std::vector<int> factors;
+            for ( int f = 2; f*f <= remain; ++f )
+                while ( remain % f == 0 ) { factors.push_back(f); remain /= f; }
+            if ( remain > 1 ) factors.push_back(remain);
+            for ( auto f = factors.rbegin(); f != factors.rend(); ++f ) {
+                std::size_t smallest = free[0];
+                for ( std::size_t d : free ) if ( res[d] < res[smallest] ) smallest = d;
+                res[smallest] *= *f;
+            }
+            std::vector<int> values;
+            for ( std::size_t d : free ) values.push_back(res[d]);
+            std::sort( values.begin(), values.end(), std::greater<int>() );
+            for ( std::size_t i = 0; i < free.size(); ++i ) res[free[i]] = values[i];
+            return res;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        void neighbors( std::vector<int>& sources, std::vector<int>& destinations ) const
+        {
+            sources      = m_sources;
+            destinations = m_destinations;
+        }
+        // .............................................................
+        // Point to point : the sends are buffered ( the data are copied in the
+        // mailbox of the receiver ) and never block.
         template<typename K> error send( std::size_t nbItems, const K* sndbuff,
                                          int dest, int tag ) const
         {
-            if (dest != 0) return error::rank;
-            if ( sndbuff == nullptr ) return error::buffer;
-            m_nbItems = nbItems;
-            m_pt_sendbuffer = new K[nbItems];
-            std::copy_n(sndbuff, nbItems, (K*)(m_pt_sendbuffer));
-            return error::success;
+            if ( (sndbuff == nullptr) && (nbItems > 0) ) return error::buffer;
+            return post<K>( dest, tag, nbItems,
+                            [=] ( K* items ) { std::copy_n( sndbuff, nbItems, items ); } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> error send( const K& obj, int dest, int tag ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            return post<value_type>( dest, tag, Items<K>::size(obj),
+                                     [&obj] ( value_type* items ) { Items<K>::copy( obj, items ); } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request isend( std::size_t nbItems, const K* sndbuff,
+                                            int dest, int tag ) const
+        {
+            send( nbItems, sndbuff, dest, tag );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request isend( const K& obj, int dest, int tag ) const
+        {
+            send( obj, dest, tag );
+            return Request();
         }
         // .............................................................
         template<typename K> Status recv( std::size_t nbItems, K* rcvbuff,
                                         int sender, int tag ) const
         {
-            if ( m_pt_sendbuffer == nullptr ) {
-                return Status{.m_count = 0, .m_tag = 0, .m_error = error::buffer};
-            }
-            Status stat;
-            if ( m_nbItems < nbItems ) {
-                stat = Status{.m_count = int(m_nbItems), .m_tag = 0, .m_error = error::count};
-                nbItems = m_nbItems;
-            }
-            else 
-                stat = Status{.m_count = int(nbItems), .m_tag = tag, .m_error = error::success};
-            if ( m_pt_sendbuffer != rcvbuff )
-                std::copy_n( static_cast<const K*>(m_pt_sendbuffer), 
-                             nbItems, rcvbuff );
-            delete [] (K*)m_pt_sendbuffer;
-            m_pt_sendbuffer = nullptr;
-            return stat;
+            return wait( receiver( sender, tag, unpacker( nbItems, rcvbuff ) ) );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Status recv( K& obj, int sender, int tag ) const
+        {
+            return wait( receiver( sender, tag, unpacker( obj ) ) );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request irecv( std::size_t nbItems, K* rcvbuff,
+                                            int sender, int tag ) const
+        {
+            return Request( receiver( sender, tag, unpacker( nbItems, rcvbuff ) ) );
         }
-        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request irecv( K& obj, int sender, int tag ) const
+        {
+            return Request( receiver( sender, tag, unpacker( obj ) ) );
+        }
+        // .............................................................
+        // Persistent requests : the communication is done at each start
+        template<typename K> Request send_init( std::size_t nbItems, const K* sndbuff,
+                                                int dest, int tag ) const
+        {
+            return Request::persistent( [=] () {
+                send( nbItems, sndbuff, dest, tag );
+                return Request::Progress();
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request send_init( const K& obj, int dest, int tag ) const
+        {
+            return Request::persistent( [=, &obj] () {
+                send( obj, dest, tag );
+                return Request::Progress();
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request recv_init( std::size_t nbItems, K* rcvbuff,
+                                                int sender, int tag ) const
+        {
+            Request::Progress progress = receiver( sender, tag, unpacker( nbItems, rcvbuff ) );
+            return Request::persistent( [progress] () { return progress; } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request recv_init( K& obj, int sender, int tag ) const
+        {
+            Request::Progress progress = receiver( sender, tag, unpacker( obj ) );
+            return Request::persistent( [progress] () { return progress; } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
         Status probe( int src, int tag ) const
         {
-            return Status{.m_count = int(m_nbItems), .m_tag = tag, .m_error = error::success};
+            const ThreadGroup::Message* msg;
+            while ( (msg = m_group->peek( m_rank, src, tag )) == nullptr )
+                std::this_thread::yield();
+            return Status{msg->data.size(), msg->tag, error::success, msg->source};
         }
-        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
-        template<typename K> void broadcast( std::size_t nbItems, 
+        // =============================================================
+        // Collective operations : each thread publishes the addresses of its
+        // buffers and reads directly the buffers of the other threads.
+        template<typename K> void broadcast( std::size_t nbItems,
                                              const K* bufsnd, K* bufrcv,
                                              int root ) const
         {
-            if ( bufsnd != bufrcv )
-                std::copy_n( bufsnd, nbItems, bufrcv );
+            collective( Slot{(bufsnd != nullptr ? bufsnd : bufrcv), nullptr, nbItems, nullptr},
+                        [&] () {
+                const K* src = static_cast<const K*>(slot(root).snd);
+                if ( src != bufrcv ) std::copy_n( src, nbItems, bufrcv );
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void broadcast( const K* obj_snd, K& obj_rcv, int root ) const
+        {
+            collective( Slot{(obj_snd != nullptr ? obj_snd : &obj_rcv), nullptr, 1, nullptr},
+                        [&] () {
+                const K* src = static_cast<const K*>(slot(root).snd);
+                if ( src != &obj_rcv ) Items<K>::set( obj_rcv, *src );
+            } );
         }
-        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .        
-        template<typename K> Request ibroadcast( std::size_t nbItems, 
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request ibroadcast( std::size_t nbItems,
                                                  const K* bufsnd, K* bufrcv,
                                                  int root ) const
         {
-            if ( bufsnd != bufrcv )
-                std::copy_n( bufsnd, nbItems, bufrcv     );
-            return Request(1);
+            broadcast( nbItems, bufsnd, bufrcv, root );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request ibroadcast( const K* obj_snd, K& obj_rcv, int root ) const
+        {
+            broadcast( obj_snd, obj_rcv, root );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        void barrier() const { m_group->barrier( m_rank ); }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        Request ibarrier() const { barrier(); return Request(); }
+        // .............................................................
+        template<typename K> void reduce( std::size_t nbItems, const K* objs, K* res,
+                                          Operation op, int root ) const
+        {
+            reduction( nbItems, objs, res,
+                       [op] ( const K& a, const K& b ) { return apply( op, a, b ); }, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K, typename F> void reduce( std::size_t nbItems, const K* objs, K* res,
+                                                      const F& fct, bool, int root ) const
+        {
+            reduction( nbItems, objs, res, fct, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void reduce( const K& obj, K* res, Operation op, int root ) const
+        {
+            reduce_object( obj, res, op, root, is_container<K>() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // inout = in op inout, element by element on the current thread
+        template<typename K> void reduce_local( std::size_t nbItems, const K* in, K* inout,
+                                                Operation op ) const
+        {
+            for ( std::size_t i = 0; i < nbItems; ++i ) inout[i] = apply( op, in[i], inout[i] );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // All the predefined operations are commutative :
+        static bool isCommutative( Operation ) { return true; }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void allreduce( std::size_t nbItems, const K* objs, K* res,
+                                             Operation op ) const
+        {
+            reduce( nbItems, objs, res, op, undefined );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K, typename F> void allreduce( std::size_t nbItems, const K* objs, K* res,
+                                                         const F& fct, bool ) const
+        {
+            reduction( nbItems, objs, res, fct, undefined );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void allreduce( const K& obj, K& res, Operation op ) const
+        {
+            reduce_object( obj, &res, op, undefined, is_container<K>() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // The predefined operations are values of an enumeration here, so the
+        // Communicator takes them for functors :
+        template<typename K> void reduce( std::size_t nbItems, const K* objs, K* res,
+                                          operation op, bool commute, int root ) const
+        {
+            reduce_operation( nbItems, objs, res, op, root, is_container<K>() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void allreduce( std::size_t nbItems, const K* objs, K* res,
+                                             operation op, bool commute ) const
+        {
+            reduce_operation( nbItems, objs, res, op, undefined, is_container<K>() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request ireduce( std::size_t nbItems, const K* objs, K* res,
+                                              Operation op, int root ) const
+        {
+            reduce( nbItems, objs, res, op, root );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request ireduce( const K& obj, K* res, Operation op, int root ) const
+        {
+            reduce( obj, res, op, root );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request iallreduce( std::size_t nbItems, const K* objs, K* res,
+                                                 Operation op ) const
+        {
+            allreduce( nbItems, objs, res, op );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request iallreduce( const K& obj, K& res, Operation op ) const
+        {
+            allreduce( obj, res, op );
+            return Request();
+        }
+        // .............................................................
+        template<typename K> void allgather( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+        {
+            gathering( nbItems, bufsnd, [bufrcv] ( std::size_t ) { return bufrcv; }, nullptr, undefined );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K, typename R> void allgather( const K& obj, R& res ) const
+        {
+            gather( obj, res, undefined );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K, typename R> Request iallgather( const K& obj, R& res ) const
+        {
+            allgather( obj, res );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request iallgather( std::size_t nbItems, const K* bufsnd,
+                                                 K* bufrcv ) const
+        {
+            allgather( nbItems, bufsnd, bufrcv );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void allgatherv( std::size_t nbItems, const K* bufsnd,
+                                              const std::vector<int>& counts, K* bufrcv ) const
+        {
+            allgather( nbItems, bufsnd, bufrcv );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void allgatherv( const K& obj, K& res, std::vector<int>& counts ) const
+        {
+            gather_items( obj, res, counts, undefined );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void gather( std::size_t nbItems, const K* bufsnd, K* bufrcv,
+                                          int root ) const
+        {
+            gathering( nbItems, bufsnd, [bufrcv] ( std::size_t ) { return bufrcv; }, nullptr, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K, typename R> void gather( const K& obj, R& res, int root ) const
+        {
+            gather_object( obj, res, root, std::is_same<R, std::vector<K>>() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void gatherv( std::size_t nbItems, const K* bufsnd,
+                                           const std::vector<int>& counts, K* bufrcv, int root ) const
+        {
+            gather( nbItems, bufsnd, bufrcv, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void gatherv( const K& obj, K& res, int root ) const
+        {
+            std::vector<int> counts;
+            gather_items( obj, res, counts, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void scatter( std::size_t nbItems, const K* bufsnd, K* bufrcv,
+                                           int root ) const
+        {
+            scattering( bufsnd, nullptr, nbItems, [bufrcv] ( std::size_t ) { return bufrcv; }, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename S, typename K> void scatter( const S& objs, K& res, int root ) const
+        {
+            scatter_object( objs, res, root, std::is_same<S, std::vector<K>>() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void scatterv( const K* bufsnd, const std::vector<int>& counts,
+                                            std::size_t nbItems, K* bufrcv, int root ) const
+        {
+            scattering( bufsnd, counts.data(), nbItems,
+                        [bufrcv] ( std::size_t ) { return bufrcv; }, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void scatterv( const K& objs, const std::vector<int>& counts,
+                                            K& res, int root ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> snd, rcv;
+            if ( m_rank == root ) {
+                snd.resize( Items<K>::size(objs) );
+                Items<K>::copy( objs, snd.data() );
+            }
+            scattering( snd.data(), counts.data(), 0,
+                        [&rcv] ( std::size_t n ) { rcv.resize(n); return rcv.data(); }, root );
+            Items<K>::assign( res, rcv.data(), rcv.size() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void alltoall( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+        {
+            exchanging( bufsnd, nullptr, nbItems, [bufrcv] ( std::size_t ) { return bufrcv; }, nullptr );
         }
         // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
-        void barrier() const {}        
+        template<typename K> void alltoall( const K& snd, K& rcv ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> items( Items<K>::size(snd) ), rcv_items;
+            Items<K>::copy( snd, items.data() );
+            exchanging( items.data(), nullptr, items.size()/getSize(),
+                        [&rcv_items] ( std::size_t n ) { rcv_items.resize(n); return rcv_items.data(); },
+                        nullptr );
+            Items<K>::assign( rcv, rcv_items.data(), rcv_items.size() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request ialltoall( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+        {
+            alltoall( nbItems, bufsnd, bufrcv );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request ialltoall( const K& snd, K& rcv ) const
+        {
+            alltoall( snd, rcv );
+            return Request();
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void alltoallv( const K* bufsnd, const std::vector<int>& sndCounts,
+                                             K* bufrcv, const std::vector<int>& rcvCounts ) const
+        {
+            exchanging( bufsnd, sndCounts.data(), 0, [bufrcv] ( std::size_t ) { return bufrcv; }, nullptr );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void alltoallv( const K& snd, const std::vector<int>& sndCounts,
+                                             K& rcv, std::vector<int>& rcvCounts ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> items( Items<K>::size(snd) ), rcv_items;
+            Items<K>::copy( snd, items.data() );
+            exchanging( items.data(), sndCounts.data(), 0,
+                        [&rcv_items] ( std::size_t n ) { rcv_items.resize(n); return rcv_items.data(); },
+                        &rcvCounts );
+            Items<K>::assign( rcv, rcv_items.data(), rcv_items.size() );
+        }
+        // .............................................................
+        template<typename K> void neighbor_allgather( std::size_t nbItems, const K* bufsnd,
+                                                      K* bufrcv ) const
+        {
+            std::vector<int> rcvCounts( m_sources.size(), int(nbItems) );
+            neighboring( bufsnd, nullptr, nbItems, true, [bufrcv] ( std::size_t ) { return bufrcv; },
+                         rcvCounts );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void neighbor_allgather( const K& obj, std::vector<K>& res ) const
+        {
+            if ( res.size() != m_sources.size() ) std::vector<K>( m_sources.size() ).swap(res);
+            neighbor_allgather( 1, &obj, res.data() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void neighbor_alltoall( std::size_t nbItems, const K* bufsnd,
+                                                     K* bufrcv ) const
+        {
+            std::vector<int> rcvCounts( m_sources.size(), int(nbItems) );
+            neighboring( bufsnd, nullptr, nbItems, false, [bufrcv] ( std::size_t ) { return bufrcv; },
+                         rcvCounts );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void neighbor_alltoall( const K& snd, K& rcv ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> items( Items<K>::size(snd) ), rcv_items;
+            Items<K>::copy( snd, items.data() );
+            std::size_t chunk = ( m_destinations.empty() ? 0 : items.size()/m_destinations.size() );
+            std::vector<int> rcvCounts( m_sources.size(), int(chunk) );
+            neighboring( items.data(), nullptr, chunk, false,
+                         [&rcv_items] ( std::size_t n ) { rcv_items.resize(n); return rcv_items.data(); },
+                         rcvCounts );
+            Items<K>::assign( rcv, rcv_items.data(), rcv_items.size() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void neighbor_alltoallv( const K* bufsnd, const std::vector<int>& sndCounts,
+                                                      K* bufrcv, const std::vector<int>& rcvCounts ) const
+        {
+            std::vector<int> counts( rcvCounts );
+            neighboring( bufsnd, sndCounts.data(), 0, false, [bufrcv] ( std::size_t ) { return bufrcv; },
+                         counts );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void neighbor_alltoallv( const K& snd, const std::vector<int>& sndCounts,
+                                                      K& rcv, std::vector<int>& rcvCounts ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> items( Items<K>::size(snd) ), rcv_items;
+            Items<K>::copy( snd, items.data() );
+            std::vector<int>( m_sources.size(), 0 ).swap(rcvCounts);
+            neighboring( items.data(), sndCounts.data(), 0, false,
+                         [&rcv_items] ( std::size_t n ) { rcv_items.resize(n); return rcv_items.data(); },
+                         rcvCounts );
+            Items<K>::assign( rcv, rcv_items.data(), rcv_items.size() );
+        }
+        // .............................................................
+        // Persistent collective operations : the operation is done at each start
+        Request barrier_init() const
+        {
+            return Request::persistent( [this] () { barrier(); return Request::Progress(); } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request broadcast_init( std::size_t nbItems, const K* bufsnd, K* bufrcv,
+                                                     int root ) const
+        {
+            return Request::persistent( [=] () {
+                broadcast( nbItems, bufsnd, bufrcv, root );
+                return Request::Progress();
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request reduce_init( std::size_t nbItems, const K* objs, K* res,
+                                                  Operation op, int root ) const
+        {
+            return Request::persistent( [=] () {
+                reduce( nbItems, objs, res, op, root );
+                return Request::Progress();
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request allreduce_init( std::size_t nbItems, const K* objs, K* res,
+                                                     Operation op ) const
+        {
+            return reduce_init( nbItems, objs, res, op, undefined );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request allgather_init( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+        {
+            return Request::persistent( [=] () {
+                allgather( nbItems, bufsnd, bufrcv );
+                return Request::Progress();
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> Request alltoall_init( std::size_t nbItems, const K* bufsnd, K* bufrcv ) const
+        {
+            return Request::persistent( [=] () {
+                alltoall( nbItems, bufsnd, bufrcv );
+                return Request::Progress();
+            } );
+        }
         // .............................................................
     private:
-        mutable std::size_t m_nbItems;
-        mutable const void* m_pt_sendbuffer;        
+        typedef std::function<void(const ThreadGroup::Message&, Status&)> Unpacker;
+        // Addresses and sizes published by a thread for a collective operation
+        struct Slot
+        {
+            const void* snd;
+            void*       rcv;
+            std::size_t count;
+            const int*  counts;
+        };
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K, typename F> error post( int dest, int tag, std::size_t nbItems,
+                                                     const F& fill ) const
+        {
+            if ( dest == no_process ) return error::success;
+            if ( (dest < 0) || (dest >= getSize()) ) return error::rank;
+            std::unique_ptr<ThreadGroup::Message> msg( new ThreadGroup::Message{
+                    m_rank, tag, std::vector<char>(nbItems*sizeof(K)), nullptr} );
+            fill( reinterpret_cast<K*>(msg->data.data()) );
+            m_group->post( dest, std::move(msg) );
+            return error::success;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> static Unpacker unpacker( std::size_t nbItems, K* rcvbuff )
+        {
+            return [=] ( const ThreadGroup::Message& msg, Status& status ) {
+                std::size_t n = msg.data.size()/sizeof(K);
+                if ( n > nbItems ) {
+                    status.m_error = error::count;
+                    n = nbItems;
+                }
+                std::copy_n( reinterpret_cast<const K*>(msg.data.data()), n, rcvbuff );
+            };
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> static Unpacker unpacker( K& obj )
+        {
+            return [&obj] ( const ThreadGroup::Message& msg, Status& ) {
+                typedef typename Items<K>::value_type value_type;
+                Items<K>::assign( obj, reinterpret_cast<const value_type*>(msg.data.data()),
+                                  msg.data.size()/sizeof(value_type) );
+            };
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> static Unpacker unpacker( StridedView<K>& view )
+        {
+            return [view] ( const ThreadGroup::Message& msg, Status& ) mutable {
+                Items<StridedView<K>>::assign( view, reinterpret_cast<const K*>(msg.data.data()),
+                                               msg.data.size()/sizeof(K) );
+            };
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // The progress function of a reception takes the first matching message if any
+        Request::Progress receiver( int sender, int tag, const Unpacker& unpack ) const
+        {
+            std::shared_ptr<ThreadGroup> group = m_group;
+            int rank = m_rank;
+            return [=] ( Status& status ) {
+                if ( sender == no_process ) {
+                    status = Status{0, any_tag, error::success, no_process};
+                    return true;
+                }
+                std::unique_ptr<ThreadGroup::Message> msg = group->take( rank, sender, tag );
+                if ( !msg ) return false;
+                status = Status{msg->data.size(), msg->tag, error::success, msg->source};
+                unpack( *msg, status );
+                return true;
+            };
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        static Status wait( const Request::Progress& progress )
+        {
+            Status status;
+            while ( !progress(status) ) std::this_thread::yield();
+            return status;
+        }
+        // .............................................................
+        const Slot& slot( int rank ) const { return m_group->slot<Slot>(rank); }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Publish the slot, wait all the threads, do the work reading the slots
+        // of the other threads and wait all the threads again
+        template<typename F> void collective( const Slot& mine, const F& work ) const
+        {
+            m_group->publish( m_rank, const_cast<Slot*>(&mine) );
+            m_group->barrier( m_rank );
+            work();
+            m_group->barrier( m_rank );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Each thread reduces a part of the items in the order of the ranks, then
+        // writes its part in the result of root ( of all the threads if root is undefined )
+        template<typename K, typename F> void reduction( std::size_t nbItems, const K* objs, K* res,
+                                                         const F& fct, int root ) const
+        {
+            const int size = getSize();
+            const std::size_t beg = (nbItems*m_rank)/size, end = (nbItems*(m_rank+1))/size;
+            std::vector<K> part;
+            part.reserve(end-beg);
+            Slot mine{objs, res, nbItems, nullptr};
+            m_group->publish( m_rank, &mine );
+            m_group->barrier( m_rank );
+            for ( std::size_t i = beg; i < end; ++i ) {
+                K val = static_cast<const K*>(slot(0).snd)[i];
+                for ( int p = 1; p < size; ++p )
+                    val = fct( val, static_cast<const K*>(slot(p).snd)[i] );
+                part.push_back(val);
+            }
+            m_group->barrier( m_rank );
+            for ( int p = 0; p < size; ++p ) {
+                if ( (root != undefined) && (p != root) ) continue;
+                std::copy( part.begin(), part.end(), static_cast<K*>(slot(p).rcv) + beg );
+            }
+            m_group->barrier( m_rank );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void reduce_object( const K& obj, K* res, Operation op, int root,
+                                                 std::false_type ) const
+        {
+            reduce( 1, &obj, res, op, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void reduce_object( const K& obj, K* res, Operation op, int root,
+                                                 std::true_type ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> items( Items<K>::size(obj) ), rcv_items( items.size() );
+            Items<K>::copy( obj, items.data() );
+            reduce( items.size(), items.data(), rcv_items.data(), op, root );
+            if ( (root == undefined) || (root == m_rank) )
+                Items<K>::assign( *res, rcv_items.data(), rcv_items.size() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void reduce_operation( std::size_t nbItems, const K* objs, K* res,
+                                                    Operation op, int root, std::false_type ) const
+        {
+            reduce( nbItems, objs, res, op, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Containers are reduced item by item :
+        template<typename K> void reduce_operation( std::size_t nbItems, const K* objs, K* res,
+                                                    Operation op, int root, std::true_type ) const
+        {
+            for ( std::size_t i = 0; i < nbItems; ++i )
+                reduce_object( objs[i], (res != nullptr ? res+i : nullptr), op, root, std::true_type() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Concatenation of the items of all the threads in root ( in all the threads if
+        // root is undefined ). allocate(n) returns the buffer receiving the n items.
+        template<typename K, typename A> void gathering( std::size_t nbItems, const K* bufsnd,
+                                                         const A& allocate, std::vector<int>* counts,
+                                                         int root ) const
+        {
+            collective( Slot{bufsnd, nullptr, nbItems, nullptr}, [&] () {
+                if ( (root != undefined) && (root != m_rank) ) return;
+                std::size_t total = 0;
+                if ( counts != nullptr ) counts->resize( getSize() );
+                for ( int p = 0; p < getSize(); ++p ) {
+                    total += slot(p).count;
+                    if ( counts != nullptr ) (*counts)[p] = int(slot(p).count);
+                }
+                K* dst = allocate(total);
+                for ( int p = 0; p < getSize(); ++p )
+                    dst = std::copy_n( static_cast<const K*>(slot(p).snd), slot(p).count, dst );
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void gather_items( const K& obj, K& res, std::vector<int>& counts,
+                                                int root ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> items( Items<K>::size(obj) ), rcv_items;
+            Items<K>::copy( obj, items.data() );
+            gathering( items.size(), items.data(),
+                       [&rcv_items] ( std::size_t n ) { rcv_items.resize(n); return rcv_items.data(); },
+                       &counts, root );
+            if ( (root == undefined) || (root == m_rank) )
+                Items<K>::assign( res, rcv_items.data(), rcv_items.size() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // One object by thread :
+        template<typename K> void gather_object( const K& obj, std::vector<K>& res, int root,
+                                                 std::true_type ) const
+        {
+            gathering( 1, &obj, [&res] ( std::size_t n ) { res.resize(n); return res.data(); },
+                       nullptr, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Concatenation of the items of containers :
+        template<typename K> void gather_object( const K& obj, K& res, int root, std::false_type ) const
+        {
+            std::vector<int> counts;
+            gather_items( obj, res, counts, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Each thread copies its part of the items of root. Without counts, each
+        // thread receives the number of items given by root.
+        template<typename K, typename A> void scattering( const K* bufsnd, const int* counts,
+                                                          std::size_t nbItems, const A& allocate,
+                                                          int root ) const
+        {
+            collective( Slot{bufsnd, nullptr, nbItems, counts}, [&] () {
+                const Slot& src = slot(root);
+                std::size_t offset = m_rank*src.count, n = src.count;
+                if ( src.counts != nullptr ) {
+                    offset = 0;
+                    for ( int p = 0; p < m_rank; ++p ) offset += src.counts[p];
+                    n = src.counts[m_rank];
+                }
+                std::copy_n( static_cast<const K*>(src.snd) + offset, n, allocate(n) );
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void scatter_object( const std::vector<K>& objs, K& res, int root,
+                                                  std::true_type ) const
+        {
+            scattering( objs.data(), nullptr, 1, [&res] ( std::size_t ) { return &res; }, root );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        template<typename K> void scatter_object( const K& objs, K& res, int root, std::false_type ) const
+        {
+            typedef typename Items<K>::value_type value_type;
+            std::vector<value_type> snd, rcv( Items<K>::size(res) );
+            if ( m_rank == root ) {
+                snd.resize( Items<K>::size(objs) );
+                Items<K>::copy( objs, snd.data() );
+            }
+            scattering( snd.data(), nullptr, rcv.size(), [&rcv] ( std::size_t ) { return rcv.data(); },
+                        root );
+            Items<K>::assign( res, rcv.data(), rcv.size() );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Each thread copies the part of each thread which is sended to it
+        template<typename K, typename A> void exchanging( const K* bufsnd, const int* sndCounts,
+                                                          std::size_t nbItems, const A& allocate,
+                                                          std::vector<int>* rcvCounts ) const
+        {
+            collective( Slot{bufsnd, nullptr, nbItems, sndCounts}, [&] () {
+                const int size = getSize();
+                std::size_t total = 0;
+                if ( rcvCounts != nullptr ) rcvCounts->resize(size);
+                for ( int p = 0; p < size; ++p ) {
+                    const Slot& src = slot(p);
+                    std::size_t n = ( src.counts != nullptr ? std::size_t(src.counts[m_rank]) : src.count );
+                    if ( rcvCounts != nullptr ) (*rcvCounts)[p] = int(n);
+                    total += n;
+                }
+                K* dst = allocate(total);
+                for ( int p = 0; p < size; ++p ) {
+                    const Slot& src = slot(p);
+                    std::size_t offset = m_rank*src.count, n = src.count;
+                    if ( src.counts != nullptr ) {
+                        offset = 0;
+                        for ( int q = 0; q < m_rank; ++q ) offset += src.counts[q];
+                        n = src.counts[m_rank];
+                    }
+                    dst = std::copy_n( static_cast<const K*>(src.snd) + offset, n, dst );
+                }
+            } );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Neighbors of each dimension : the process in the negative direction,
+        // then the process in the positive direction
+        void cartesian_neighbors()
+        {
+            m_sources.clear();
+            for ( int d = 0; d < nbDimensions(); ++d ) {
+                std::pair<int,int> nghbs = shift( d, 1 );
+                m_sources.push_back( nghbs.first );
+                m_sources.push_back( nghbs.second );
+            }
+            m_destinations = m_sources;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Index of the chunk of the source sended to the current thread received
+        // as its i-th source. With a graph, the k-th occurrence of a source in
+        // the sources matches the k-th occurrence of the current thread in the
+        // destinations of the source. With a Cartesian topology, the process in
+        // the negative direction sends its chunk for its positive direction.
+        std::size_t matching_chunk( const Implementation& src, std::size_t i ) const
+        {
+            if ( m_cartesian ) return i ^ 1;
+            int k = int( std::count( m_sources.begin(), m_sources.begin() + i, m_sources[i] ) );
+            std::size_t j = 0;
+            for ( ; j < src.m_destinations.size(); ++j )
+                if ( (src.m_destinations[j] == m_rank) && (k-- == 0) ) break;
+            return j;
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Each thread copies the chunk sended to it by each of its sources ( the whole
+        // buffer with gather ). rcvCounts gives the size of the chunks received from
+        // no_process ( left unchanged ) and returns the size of the received chunks.
+        template<typename K, typename A> void neighboring( const K* bufsnd, const int* sndCounts,
+                                                           std::size_t nbItems, bool gather,
+                                                           const A& allocate,
+                                                           std::vector<int>& rcvCounts ) const
+        {
+            struct Neighbor
+            {
+                const K* snd;
+                const int* counts;
+                std::size_t count;
+                const Implementation* impl;
+            } mine{bufsnd, sndCounts, nbItems, this};
+            m_group->publish( m_rank, &mine );
+            m_group->barrier( m_rank );
+            std::vector<const K*> chunks( m_sources.size(), nullptr );
+            std::size_t total = 0;
+            for ( std::size_t i = 0; i < m_sources.size(); ++i ) {
+                if ( m_sources[i] != no_process ) {
+                    const Neighbor& src = m_group->slot<Neighbor>( m_sources[i] );
+                    std::size_t j = ( gather ? 0 : matching_chunk( *src.impl, i ) ), offset = j*src.count;
+                    std::size_t n = src.count;
+                    if ( src.counts != nullptr ) {
+                        offset = 0;
+                        for ( std::size_t q = 0; q < j; ++q ) offset += src.counts[q];
+                        n = src.counts[j];
+                    }
+                    chunks[i] = src.snd + offset;
+                    rcvCounts[i] = int(n);
+                }
+                total += rcvCounts[i];
+            }
+            K* dst = allocate(total);
+            for ( std::size_t i = 0; i < m_sources.size(); ++i ) {
+                if ( chunks[i] != nullptr ) std::copy_n( chunks[i], rcvCounts[i], dst );
+                dst += rcvCounts[i];
+            }
+            m_group->barrier( m_rank );
+        }
+        // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+        // Collective creation of the groups of the threads with the same color,
+        // ordered by key ( and by rank for the same key ).
+        void split( int color, int key, std::shared_ptr<ThreadGroup>& group, int& rank,
+                    std::vector<int>& worldRanks ) const
+        {
+            struct Split
+            {
+                int color, key;
+                std::shared_ptr<ThreadGroup> group;
+            } mine{color, key, nullptr};
+            m_group->publish( m_rank, &mine );
+            m_group->barrier( m_rank );
+            std::vector<int> members;
+            for ( int p = 0; p < getSize(); ++p )
+                if ( m_group->slot<Split>(p).color == color ) members.push_back(p);
+            std::stable_sort( members.begin(), members.end(), [this] ( int p, int q ) {
+                return m_group->slot<Split>(p).key < m_group->slot<Split>(q).key;
+            } );
+            // The first member creates the group :
+            if ( (color != undefined) && (members[0] == m_rank) )
+                mine.group = std::make_shared<ThreadGroup>( int(members.size()) );
+            m_group->barrier( m_rank );
+            if ( color != undefined ) {
+                group = m_group->slot<Split>(members[0]).group;
+                rank  = int( std::find( members.begin(), members.end(), m_rank ) - members.begin() );
+                worldRanks.resize( members.size() );
+                for ( std::size_t m = 0; m < members.size(); ++m ) worldRanks[m] = m_worldRanks[members[m]];
+            }
+            m_group->barrier( m_rank );
+        }
+        // .............................................................
+        std::shared_ptr<ThreadGroup> m_group;
+        int m_rank;
+        std::vector<int> m_worldRanks; // Rank in the world of each thread of the group
+        bool m_hierarchical = false;
+        // Topology :
+        std::vector<int>  m_dims;
+        std::vector<bool> m_periods;
+        std::vector<int>  m_sources, m_destinations;
+        bool m_cartesian = false;
     };
     // -----------------------------------------------------------------
-    
+
 }
+#endif
@@ -14,12 +14,20 @@
 // Constantes utilisées par le parallélisme :
 #ifndef _PARALLEL_CONSTANTES_HPP_
 # define _PARALLEL_CONSTANTES_HPP_
+# include <array>
+# include <complex>
+# include <cstddef>
+# include <mutex>
+# include <type_traits>
+# include <utility>
+# include <vector>
 namespace Parallel
 {
 # if defined (USE_MPI)
   const int any_tag    = MPI_ANY_TAG;
   const int any_source = MPI_ANY_SOURCE;
   const int undefined  = MPI_UNDEFINED;
+  const int no_process = MPI_PROC_NULL;
 
   enum error { success    = MPI_SUCCESS,
                count      = MPI_ERR_COUNT,
@@ -45,13 +53,153 @@ namespace Parallel
   const Operation minloc      = MPI_MINLOC;
   const Operation maxloc      = MPI_MAXLOC;
   const Operation replace     = MPI_REPLACE;
+  const Operation no_op       = MPI_NO_OP;
 
   typedef MPI_Comm Ext_Communicator; 
-  
+
+  template<typename K> struct Type_MPI;
+  /*!
+   *  \brief Builder of committed MPI derived datatypes
+   *
+   *  Each derived datatype is built once ( the first time it is needed ) and cached
+   *  by the Type_MPI trait of the type. The datatype is freed when MPI is finalized.
+   */
+  struct Derived_type_MPI
+  {
+    /*!
+     *  \brief Commit a datatype whose extent is resized to the size of the C++ type
+     */
+    static MPI_Datatype commit( MPI_Datatype type, std::size_t extent )
+    {
+      MPI_Datatype resized;
+      MPI_Type_create_resized( type, 0, MPI_Aint(extent), &resized );
+      MPI_Type_free( &type );
+      MPI_Type_commit( &resized );
+      free_at_finalize( resized );
+      return resized;
+    }
+    // .................................................................
+    /*!
+     *  \brief Datatype of count contiguous elements of type ( an array by example )
+     */
+    static MPI_Datatype contiguous( int count, MPI_Datatype type, std::size_t extent )
+    {
+      MPI_Datatype array;
+      MPI_Type_contiguous( count, type, &array );
+      return commit( array, extent );
+    }
+    // .................................................................
+    /*!
+     *  \brief Datatype of a structure given by the list of the members to exchange
+     *
+     *  The displacements of the members are computed on an uninitialized object, so
+     *  K needn't be default constructible. The types of the members must have a
+     *  Type_MPI trait ( builtin, registered or packed types ).
+     */
+    template<typename K, typename... M> static MPI_Datatype structure( M K::*... members )
+    {
+      typename std::aligned_storage<sizeof(K), alignof(K)>::type storage;
+      K* obj = reinterpret_cast<K*>(&storage);
+      MPI_Aint displs[] = { displacement( obj, &(obj->*members) )... };
+      MPI_Datatype types[] = { Type_MPI<M>::mpi_type()... };
+      int lengths[sizeof...(M)];
+      for ( auto& lgth : lengths ) lgth = 1;
+      MPI_Datatype type;
+      MPI_Type_create_struct( int(sizeof...(M)), lengths, displs, types, &type );
+      return commit( type, sizeof(K) );
+    }
+  private:
+    template<typename K, typename M> static MPI_Aint displacement( K* obj, M* member )
+    {
+      return MPI_Aint( reinterpret_cast<const char*>(member) - reinterpret_cast<const char*>(obj) );
+    }
+    // The datatypes committed by the process, freed when the attribute of MPI_COMM_SELF
+    // holding them is deleted at the beginning of MPI_Finalize
+    struct Committed_types
+    {
+      std::mutex                mutex;
+      std::vector<MPI_Datatype> types;
+    };
+    static Committed_types& committed_types()
+    {
+      static Committed_types& committed = [] () -> Committed_types& {
+        static Committed_types list;
+        int keyval;
+        MPI_Comm_create_keyval( MPI_COMM_NULL_COPY_FN, free_types, &keyval, nullptr );
+        MPI_Comm_set_attr( MPI_COMM_SELF, keyval, &list );
+        // The key stays valid until the attribute is deleted
+        MPI_Comm_free_keyval( &keyval );
+        return list;
+      }();
+      return committed;
+    }
+    static void free_at_finalize( MPI_Datatype type )
+    {
+      Committed_types& committed = committed_types();
+      std::lock_guard<std::mutex> lock( committed.mutex );
+      committed.types.push_back( type );
+    }
+    static int free_types( MPI_Comm, int, void* attr, void* )
+    {
+      Committed_types* committed = static_cast<Committed_types*>(attr);
+      std::lock_guard<std::mutex> lock( committed->mutex );
+      for ( MPI_Datatype& type : committed->types ) MPI_Type_free( &type );
+      committed->types.clear();
+      return MPI_SUCCESS;
+    }
+  };
+  /*!
+   *  \brief Trait giving the MPI datatype of a C++ type
+   *
+   *  Types without specialization are packed : they are exchanged as raw bytes, and
+   *  their datatype is a contiguous sequence of sizeof(K) bytes ( used by the reductions
+   *  with user functions ). Structures can be described with PARALLEL_MPI_STRUCT to be
+   *  exchanged with a derived datatype. The pre-defined reduction operations apply only
+   *  to the builtin types : derived datatypes must be reduced with user functions.
+   */
   template<typename K> struct Type_MPI
   {
     static bool must_be_packed() { return true; }
-    static MPI_Datatype mpi_type() {return MPI_PACKED;}
+    static MPI_Datatype mpi_type()
+    {
+      static const MPI_Datatype type = Derived_type_MPI::contiguous( int(sizeof(K)), MPI_BYTE, sizeof(K) );
+      return type;
+    }
+  };
+  //
+  template<typename K> struct Type_MPI<const K> : public Type_MPI<K>
+  {};
+  //
+  template<typename K, std::size_t N> struct Type_MPI<K[N]>
+  {
+    static bool must_be_packed() { return false; }
+    static MPI_Datatype mpi_type()
+    {
+      static const MPI_Datatype type = Derived_type_MPI::contiguous( int(N), Type_MPI<K>::mpi_type(), sizeof(K[N]) );
+      return type;
+    }
+  };
+  //
+  template<typename K, std::size_t N> struct Type_MPI<std::array<K,N>>
+  {
+    static bool must_be_packed() { return false; }
+    static MPI_Datatype mpi_type()
+    {
+      static const MPI_Datatype type = Derived_type_MPI::contiguous( int(N), Type_MPI<K>::mpi_type(),
+                                                                     sizeof(std::array<K,N>) );
+      return type;
+    }
+  };
+  //
+  template<typename K1, typename K2> struct Type_MPI<std::pair<K1,K2>>
+  {
+    static bool must_be_packed() { return false; }
+    static MPI_Datatype mpi_type()
+    {
+      static const MPI_Datatype type = Derived_type_MPI::structure( &std::pair<K1,K2>::first,
+                                                                    &std::pair<K1,K2>::second );
+      return type;
+    }
   };
   //
   template<> struct Type_MPI<short>
@@ -113,16 +261,85 @@ namespace Parallel
     static bool must_be_packed() { return false;}
     static MPI_Datatype mpi_type() { return MPI_UNSIGNED_LONG;}
   };
+  //
+  template<> struct Type_MPI<signed char>
+  {
+    static bool must_be_packed() { return false;}
+    static MPI_Datatype mpi_type() { return MPI_SIGNED_CHAR;}
+  };
+  //
+  template<> struct Type_MPI<long long>
+  {
+    static bool must_be_packed() { return false;}
+    static MPI_Datatype mpi_type() { return MPI_LONG_LONG;}
+  };
+  //
+  template<> struct Type_MPI<unsigned long long>
+  {
+    static bool must_be_packed() { return false;}
+    static MPI_Datatype mpi_type() { return MPI_UNSIGNED_LONG_LONG;}
+  };
+  //
+  template<> struct Type_MPI<bool>
+  {
+    static bool must_be_packed() { return false;}
+    static MPI_Datatype mpi_type() { return MPI_CXX_BOOL;}
+  };
+  //
+  template<> struct Type_MPI<long double>
+  {
+    static bool must_be_packed() { return false; }
+    static MPI_Datatype mpi_type() { return MPI_LONG_DOUBLE; }
+  };
+  //
+  template<> struct Type_MPI<std::complex<float>>
+  {
+    static bool must_be_packed() { return false; }
+    static MPI_Datatype mpi_type() { return MPI_CXX_FLOAT_COMPLEX; }
+  };
+  //
+  template<> struct Type_MPI<std::complex<double>>
+  {
+    static bool must_be_packed() { return false; }
+    static MPI_Datatype mpi_type() { return MPI_CXX_DOUBLE_COMPLEX; }
+  };
+  //
+  template<> struct Type_MPI<std::complex<long double>>
+  {
+    static bool must_be_packed() { return false; }
+    static MPI_Datatype mpi_type() { return MPI_CXX_LONG_DOUBLE_COMPLEX; }
+  };
   
+/*!
+ *  \brief Describe the members of a structure to exchange it with a MPI derived datatype
+ *
+ *  Must be used outside of any namespace, after the definition of the structure :
+ *
+ *      struct Particle { double pos[3]; double mass; int id; };
+ *      PARALLEL_MPI_STRUCT(Particle, &Particle::pos, &Particle::mass, &Particle::id)
+ *
+ *  The members which aren't listed aren't exchanged.
+ */
+#   define PARALLEL_MPI_STRUCT(K, ...) \
+    namespace Parallel { \
+      template<> struct Type_MPI<K> \
+      { \
+        static bool must_be_packed() { return false; } \
+        static MPI_Datatype mpi_type() \
+        { \
+          static const MPI_Datatype type = Derived_type_MPI::structure( __VA_ARGS__ ); \
+          return type; \
+        } \
+      }; \
+    }
 # else
   const int any_tag    = -1; /*!< Constant to receive from any tag */
   const int any_source = -1; /*!< Constant to receive from any source */
   const int undefined  = -1; /*!< Constant for undefined parameter */
+  const int no_process = -2; /*!< Rank of a missing neighbor : the communications with it do nothing */
 
   typedef int Ext_Communicator;
   
-  typedef int Operation;
-  
   enum operation {
       null = 0,
       max,
@@ -137,8 +354,10 @@ namespace Parallel
       binary_xor,
       minloc,
       maxloc,
-      replace
+      replace,
+      no_op
   };
+  typedef operation Operation;
   /*!
    * \enum error
    * \brief To manage error coming for parallel calls
@@ -150,6 +369,8 @@ namespace Parallel
                buffer,        /*!< Problems with the used buffer (null ? )*/
                unknown        /*!< Unknown problem */
   };
+  // Without parallel library, the objects are only copied :
+#   define PARALLEL_MPI_STRUCT(K, ...)
 # endif
 }
 #endif
@@ -24,8 +24,11 @@
 # include <sstream>
 # include <iostream>
 # include <fstream>
+# include <functional>
+# include "Parallel/Chrono.hpp"
 # include "Parallel/Communicator.hpp"
 # include "Parallel/Logger.hpp"
+# include "Parallel/Progress.hpp"
 
 /*!  \namespace Parallel
  * 
@@ -90,7 +93,9 @@ namespace Parallel
     Context(int& nargc, char* argv[], thread_support thread_level_support);
  
     /*!
-     *    Destructor. Synchronize all processes and destroy the parallel context.
+     *    Destructor. Stop the progress engine, synchronize all processes, report the statistics of the
+     *    communications ( if the Profiler is enabled ) and of the timers ( if a
+     *    region was timed ) and destroy the parallel context.
      */
     ~Context();
     /*!
@@ -100,9 +105,39 @@ namespace Parallel
     {
       return m_provided;
     }
+    /*!
+     *     Return the progress engine of the process ( it can be started only with
+     *     MPI and the Multiple thread support )
+     */
+    ProgressEngine& progress()
+    {
+      return m_progress;
+    }
+    /*!
+     *     Run the parallel part of the program on each process
+     *
+     *     With MPI, parallel_main is only called by the current process. Without
+     *     MPI, the processes are simulated by threads sharing the memory :
+     *     parallel_main is called by PARALLEL_NB_PROCS threads ( environment
+     *     variable, one thread by default ) and each thread creates its own Context.
+     *
+     *     \param   nargc Number of arguments
+     *     \param   argv  Argument vector
+     *     \param   parallel_main The parallel part of the program
+     *     \return  The value returned by parallel_main for the process 0
+     */
+    static int launch(int& nargc, char* argv[],
+                      const std::function<int(int&, char*[])>& parallel_main);
+# if defined(USE_MPI)
     static Logger logger;
+    static TimerLog timers; /*!< Timers of the regions ( see TimeRegion ) */
+# else
+    static thread_local Logger logger; /*!< One logger for each simulated process */
+    static thread_local TimerLog timers; /*!< Timers of the regions of each simulated process */
+# endif
   private:
     thread_support m_provided; /*!< Actual multithread level support */ 
+    ProgressEngine m_progress; /*!< Thread progressing the communications */
   };
 
 }
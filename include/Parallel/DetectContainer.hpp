@@ -13,6 +13,9 @@
 // limitations under the License.
 # ifndef _PARALLEL_DETECTCONTAINER_HPP_
 # define _PARALLEL_DETECTCONTAINER_HPP_
+# include <memory>
+# include <type_traits>
+# include <utility>
 
 template<typename T>
 struct has_const_iterator
@@ -50,5 +53,33 @@ template<typename T>
 struct is_container : std::integral_constant<bool, has_const_iterator<T>::value && has_begin_end<T>::beg_value && has_begin_end<T>::end_value> 
 { };
 
+/*
+ * Container storing its elements in a contiguous buffer ( data() returns a pointer
+ * on the size() elements : std::vector, std::array, std::string, ... )
+ */
+template<typename T>
+struct is_contiguous_container
+{
+private:
+  template<typename C> static char (&f(typename std::enable_if<
+                                       std::is_same<decltype(std::declval<const C&>().data()),
+                                       const typename C::value_type*>::value, void>::type*))[1];
+  template<typename C> static char (&f(...))[2];
+public:
+  static bool const value = ( sizeof(f<T>(0)) == 1 );
+};
+/*
+ * Allocator of the container if it has one, else the default allocator
+ */
+template<typename T>
+struct container_allocator
+{
+private:
+  template<typename C> static typename C::allocator_type f(typename C::allocator_type*);
+  template<typename C> static std::allocator<typename C::value_type> f(...);
+public:
+  typedef decltype(f<T>(0)) type;
+};
+
 
 #endif
@@ -0,0 +1,182 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    LocalGemm.hpp
+ *    \brief   Product of dense matrices stored by columns on the current process
+ */
+#ifndef _PARALLEL_LOCALGEMM_HPP_
+# define _PARALLEL_LOCALGEMM_HPP_
+# include <algorithm>
+# include <cstddef>
+# include <thread>
+# include <vector>
+
+namespace Parallel
+{
+    namespace gemm_details
+    {
+        /*!
+         *   \brief Micro kernel : product of a packed sliver of mr rows of A by a packed sliver
+         *          of nr columns of B
+         *
+         *   The kernel computes the mr x nr block AB = A(:,0:kc).B(0:kc,:) where the
+         *   sliver of A is stored by columns ( mr values by column ) and the sliver of B
+         *   by rows ( nr values by row ). AB is stored by columns.
+         */
+        template<typename K> struct Kernel
+        {
+            const char*  name;
+            std::size_t  mr, nr;
+            void (*compute)( std::size_t kc, const K* Ap, const K* Bp, K* AB );
+        };
+        // Kernel without vectorization, used for any type of coefficients
+        template<typename K, std::size_t MR, std::size_t NR> void
+        generic_kernel( std::size_t kc, const K* Ap, const K* Bp, K* AB )
+        {
+            K acc[MR*NR];
+            std::fill( acc, acc + MR*NR, K(0) );
+            for ( std::size_t l = 0; l < kc; ++l, Ap += MR, Bp += NR )
+                for ( std::size_t j = 0; j < NR; ++j ) {
+                    const K b = Bp[j];
+                    for ( std::size_t i = 0; i < MR; ++i ) acc[i + j*MR] += Ap[i]*b;
+                }
+            std::copy( acc, acc + MR*NR, AB );
+        }
+        // Dimensions of the blocks kept in cache : the packed panel of A ( mc x kc ) stays in
+        // the L2 cache and a sliver of the packed panel of B ( kc x nr ) in the L1 cache.
+        constexpr std::size_t kc_block = 256, mc_block = 128, nc_block = 4096;
+        // -------------------------------------------------------------
+        // Copy the block A(0:mc,0:kc) in slivers of mr rows, completed by zeros
+        template<typename K> void
+        packA( std::size_t mc, std::size_t kc, const K* A, std::size_t lda, std::size_t mr, K* Ap )
+        {
+            for ( std::size_t i0 = 0; i0 < mc; i0 += mr ) {
+                const std::size_t ib = std::min( mr, mc - i0 );
+                for ( std::size_t l = 0; l < kc; ++l, Ap += mr ) {
+                    const K* col = A + i0 + l*lda;
+                    std::copy( col, col + ib, Ap );
+                    std::fill( Ap + ib, Ap + mr, K(0) );
+                }
+            }
+        }
+        // Copy the block B(0:kc,0:nc) in slivers of nr columns, completed by zeros
+        template<typename K> void
+        packB( std::size_t kc, std::size_t nc, const K* B, std::size_t ldb, std::size_t nr, K* Bp )
+        {
+            for ( std::size_t j0 = 0; j0 < nc; j0 += nr ) {
+                const std::size_t jb = std::min( nr, nc - j0 );
+                for ( std::size_t l = 0; l < kc; ++l, Bp += nr ) {
+                    for ( std::size_t j = 0; j < jb; ++j ) Bp[j] = B[l + (j0+j)*ldb];
+                    std::fill( Bp + jb, Bp + nr, K(0) );
+                }
+            }
+        }
+        // -------------------------------------------------------------
+        // C = C + alpha.A.B by blocks held in cache on one thread
+        template<typename K> void
+        blocked_gemm( const Kernel<K>& kernel, std::size_t m, std::size_t n, std::size_t k,
+                      const K& alpha, const K* A, std::size_t lda, const K* B, std::size_t ldb,
+                      K* C, std::size_t ldc )
+        {
+            const std::size_t mr = kernel.mr, nr = kernel.nr;
+            const std::size_t mc = ( mc_block + mr - 1 )/mr*mr, nc = ( nc_block + nr - 1 )/nr*nr;
+            std::vector<K> Ap( mc*kc_block ), Bp( kc_block*std::min( nc, ( n + nr - 1 )/nr*nr ) );
+            std::vector<K> AB( mr*nr );
+            for ( std::size_t jc = 0; jc < n; jc += nc ) {
+                const std::size_t ncb = std::min( nc, n - jc );
+                for ( std::size_t pc = 0; pc < k; pc += kc_block ) {
+                    const std::size_t kcb = std::min( kc_block, k - pc );
+                    packB( kcb, ncb, B + pc + jc*ldb, ldb, nr, Bp.data() );
+                    for ( std::size_t ic = 0; ic < m; ic += mc ) {
+                        const std::size_t mcb = std::min( mc, m - ic );
+                        packA( mcb, kcb, A + ic + pc*lda, lda, mr, Ap.data() );
+                        for ( std::size_t jr = 0; jr < ncb; jr += nr ) {
+                            const std::size_t jb = std::min( nr, ncb - jr );
+                            for ( std::size_t ir = 0; ir < mcb; ir += mr ) {
+                                const std::size_t ib = std::min( mr, mcb - ir );
+                                kernel.compute( kcb, Ap.data() + ir*kcb, Bp.data() + jr*kcb, AB.data() );
+                                K* Cij = C + ic + ir + ( jc + jr )*ldc;
+                                for ( std::size_t j = 0; j < jb; ++j )
+                                    for ( std::size_t i = 0; i < ib; ++i )
+                                        Cij[i + j*ldc] += alpha*AB[i + j*mr];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        // -------------------------------------------------------------
+        // The columns of C are shared between the threads by slivers of nr columns
+        template<typename K> void
+        threaded_gemm( const Kernel<K>& kernel, std::size_t m, std::size_t n, std::size_t k,
+                       const K& alpha, const K* A, std::size_t lda, const K* B, std::size_t ldb,
+                       K* C, std::size_t ldc, int nbThreads )
+        {
+            const std::size_t nbSlivers = ( n + kernel.nr - 1 )/kernel.nr;
+            const std::size_t nbWorkers = std::max( std::size_t(1), std::min( std::size_t(nbThreads), nbSlivers ) );
+            auto work = [&] ( std::size_t t ) {
+                const std::size_t beg = std::min( n, ( nbSlivers*t/nbWorkers )*kernel.nr );
+                const std::size_t end = std::min( n, ( nbSlivers*(t+1)/nbWorkers )*kernel.nr );
+                if ( end > beg )
+                    blocked_gemm( kernel, m, end - beg, k, alpha, A, lda, B + beg*ldb, ldb, C + beg*ldc, ldc );
+            };
+            std::vector<std::thread> workers;
+            for ( std::size_t t = 1; t < nbWorkers; ++t ) workers.emplace_back( work, t );
+            work( 0 );
+            for ( std::thread& worker : workers ) worker.join();
+        }
+    }
+    // =================================================================
+    /*!
+     *   \brief Default number of threads used by local_gemm
+     *
+     *   Given by the environment variable PARALLEL_GEMM_THREADS ( 1 if not defined ).
+     */
+    int gemmThreads();
+    /*!
+     *   \brief Name of the micro kernel chosen for the double precision on this processor
+     *          ( "avx512", "avx2" or "generic" )
+     */
+    const char* gemmKernel();
+    // -----------------------------------------------------------------
+    /*!
+     *   \brief Product of two matrices stored by columns added to a third one on the current process
+     *
+     *   C = C + alpha.A.B where A is a m x k matrix, B a k x n matrix and C a m x n matrix.
+     *   lda, ldb and ldc are the distances between two columns of A, B and C.
+     *
+     *   The matrices are multiplied by blocks held in the caches, copied in contiguous
+     *   panels and multiplied by a micro kernel keeping a block of C in registers. The
+     *   columns of C are shared between nbThreads threads. For double and float
+     *   coefficients, the micro kernel uses the AVX-512 or AVX2 instructions when the
+     *   processor has them ( chosen at run time ).
+     */
+    template<typename K> void
+    local_gemm( std::size_t m, std::size_t n, std::size_t k, const K& alpha,
+                const K* A, std::size_t lda, const K* B, std::size_t ldb, K* C, std::size_t ldc,
+                int nbThreads = gemmThreads() )
+    {
+        static const gemm_details::Kernel<K> kernel{ "generic", 4, 4,
+                                                     &gemm_details::generic_kernel<K,4,4> };
+        gemm_details::threaded_gemm( kernel, m, n, k, alpha, A, lda, B, ldb, C, ldc, nbThreads );
+    }
+    void local_gemm( std::size_t m, std::size_t n, std::size_t k, const double& alpha,
+                     const double* A, std::size_t lda, const double* B, std::size_t ldb,
+                     double* C, std::size_t ldc, int nbThreads = gemmThreads() );
+    void local_gemm( std::size_t m, std::size_t n, std::size_t k, const float& alpha,
+                     const float* A, std::size_t lda, const float* B, std::size_t ldb,
+                     float* C, std::size_t ldc, int nbThreads = gemmThreads() );
+}
+
+#endif
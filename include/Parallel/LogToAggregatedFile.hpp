@@ -0,0 +1,107 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Log to files shared by groups of processes
+#ifndef _PARALLEL_LOGTOAGGREGATEDFILE_HPP_
+# define _PARALLEL_LOGTOAGGREGATEDFILE_HPP_
+# include <cstdint>
+# include <fstream>
+# include <list>
+# include <string>
+# ifdef USE_MPI
+# include <mpi.h>
+# endif
+# include "Parallel/Logger.hpp"
+# include "Parallel/Communicator.hpp"
+
+namespace Parallel
+{
+  /*!   \class LogToAggregatedFile
+   *    \brief Listener writing the messages of a group of processes in one file
+   *
+   *    The processes are split in groups ( the processes of a node or ranksPerWriter
+   *    consecutive processes ). The first process of each group is the writer : it
+   *    creates the file <filename_base><rank of the writer>.txt, where it writes its own
+   *    messages and the messages of the other processes of its group, with their rank
+   *    prefixes. So, the number of files created doesn't depend on the number of processes.
+   *
+   *    The other processes keep their messages in a buffer, sent to the writer by
+   *    non-blocking sends ( only the complete lines ) when it exceeds chunkSize or at a
+   *    flush. The writer receives the messages when it logs a message itself, at a flush
+   *    and at the close of the listener. The lines of a process keep their order, the
+   *    lines of different processes are interleaved by chunks.
+   *
+   *    The constructor and close() are collective calls on world. The context closes
+   *    the listeners of its logger at its destruction, a listener subscribed to another
+   *    logger must be closed by Logger::close() before the end of the context. After
+   *    close(), the messages are ignored.
+   *
+   *    The logger in asynchronous mode sends the messages from its background thread :
+   *    the context must be initialized with the multiple thread support.
+   */
+  class LogToAggregatedFile : public Logger::Listener
+  {
+  public:
+    /*!
+     *   \param filename_base  Beginning of the names of the files
+     *   \param flags          The modes listened
+     *   \param ranksPerWriter Number of processes by file, 0 for one file by node
+     *   \param chunkSize      Size of the buffer of a process sending its messages
+     */
+    LogToAggregatedFile( std::string const& filename_base, int flags, int ranksPerWriter = 0,
+                         std::size_t chunkSize = 65536 );
+    ~LogToAggregatedFile();
+
+    /*!
+     *   \brief True if the current process writes the file of its group
+     */
+    bool isWriter() const { return m_group.rank == 0; }
+    /*!
+     *   \brief Name of the file of the group of the current process
+     */
+    const std::string& fileName() const { return m_fileName; }
+
+    virtual void begin( int mode, const Logger::CallSite& site, int rank ) override;
+    virtual void flush() override;
+    virtual void close() override;
+  private:
+    // A chunk sent to the writer : its size then its text
+    struct Chunk
+    {
+      std::uint64_t size;
+      std::string   text;
+      Request       sizeRequest, textRequest;
+    };
+    virtual std::ostream& report() override;
+    // Send the complete lines of the buffer ( all the buffer if all is true )
+    void send( bool all );
+    // Release the chunks received by the writer
+    void release();
+    // Write the chunks received, wait for the end of all the senders if wait is true
+    void receive( bool wait );
+
+    Communicator       m_group;
+    std::string        m_fileName;
+    std::ofstream      m_file;     // Only for the writer
+    std::size_t        m_chunk_size;
+    std::string        m_text;     // Messages not sent yet
+    Logger::TextBuffer m_text_buffer;
+    std::ostream       m_text_stream;
+    std::list<Chunk>   m_chunks;   // Chunks sent, until the end of the sends
+    std::uint64_t      m_incoming; // Size of the next chunk received by the writer
+    Request            m_incoming_request;
+    int                m_nb_senders; // Processes of the group which aren't closed yet
+    bool               m_closed;
+  };
+}
+#endif
@@ -0,0 +1,110 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Log to binary file
+#ifndef _PARALLEL_LOGTOBINARYFILE_HPP_
+# define _PARALLEL_LOGTOBINARYFILE_HPP_
+# include <cstdint>
+# include <fstream>
+# include <map>
+# include <string>
+# include <tuple>
+# include <vector>
+# include "Parallel/Logger.hpp"
+
+namespace Parallel
+{
+  /*!   \class LogToBinaryFile
+   *    \brief Listener writing compact records in the file <filename_base><rank>.plog
+   *
+   *    Each message is a record with its time, its mode, the identifier of its call
+   *    site ( the file, function and line of a call site are written once, at its first
+   *    message ) and its arguments : the integers and reals are written in binary, the
+   *    other arguments as text. A message ends by a new line ( removed from the record ),
+   *    at the beginning of the next message or at a flush. The files are decoded by read()
+   *    and by the tool parallel-logdump, which merges the files of all the processes.
+   *    The integers are written in a variable number of bytes and the times relative to
+   *    the previous record. The reals are written with the byte order of the machine.
+   *
+   *    In the asynchronous mode of the logger, the messages are formatted as text by the
+   *    threads and the time of a record is the time of its writing.
+   */
+  class LogToBinaryFile : public Logger::Listener
+  {
+  public:
+    /*!
+     *   \brief A decoded message
+     */
+    struct Entry
+    {
+      std::int64_t  time; // Nanoseconds since the epoch of the system clock
+      int           mode;
+      std::uint32_t site; // Index in the sites of the file, 0 if the message has no call site
+      std::string   text;
+    };
+    struct Site
+    {
+      std::string file, function;
+      int line;
+    };
+    /*!
+     *   \brief The messages of a file and their call sites
+     */
+    struct Content
+    {
+      int rank = -1;
+      std::vector<Entry> entries;
+      std::vector<Site>  sites;
+    };
+
+    LogToBinaryFile( std::string const& filename_base, int flags);
+    ~LogToBinaryFile();
+
+    virtual void begin( int mode, const Logger::CallSite& site, int rank ) override;
+    virtual void put( long long value ) override;
+    virtual void put( unsigned long long value ) override;
+    virtual void put( double value ) override;
+    virtual void put( const char* text, std::size_t length ) override;
+    virtual void flush() override;
+    /*!
+     *   \brief Decode a file
+     *
+     *   \return False if the file can't be read or isn't a binary log
+     */
+    static bool read( const std::string& fileName, Content& content );
+    /*!
+     *   \brief The text written by LogToFile for an entry of content
+     */
+    static std::string format( const Content& content, const Entry& entry );
+  private:
+    virtual std::ostream& report() override;
+    // Write the pending text as an argument of the record
+    void putText();
+    // Write the record of the current message in the file
+    void endRecord();
+
+    std::string   m_fileName;
+    std::ofstream m_file;
+    bool          m_open_record;
+    std::int64_t  m_time;
+    std::int64_t  m_last_time; // Time of the previous record written
+    int           m_mode;
+    std::uint32_t m_site;
+    std::string   m_record;  // Arguments of the current message
+    std::string   m_text;    // Text not written yet in the arguments
+    Logger::TextBuffer m_text_buffer;
+    std::ostream  m_text_stream;
+    std::map<std::tuple<const char*, const char*, int>, std::uint32_t> m_sites;
+  };
+}
+#endif
@@ -13,16 +13,55 @@
 // limitations under the License.
 #ifndef _PARALLEL_LOGGER_HPP_
 # define _PARALLEL_LOGGER_HPP_
+# include <atomic>
 # include <mutex>
 # include <list>
+# include <memory>
 # include <iostream>
 # include <sstream>
+# include <string>
+# include <type_traits>
 
 namespace Parallel
 {
   class Logger
   {
   public:
+    /*!
+     *   \brief Place in the source of a log statement ( empty for the messages
+     *          not logged by the log macros )
+     */
+    struct CallSite
+    {
+      const char* file;
+      const char* function;
+      int         line;
+    };
+    // Stream buffer appending the characters to a string
+    class TextBuffer : public std::streambuf
+    {
+    public:
+      explicit TextBuffer( std::string& text ) : m_text(text) {}
+    protected:
+      int_type overflow( int_type c ) override
+      {
+        if ( !traits_type::eq_int_type(c, traits_type::eof()) ) m_text.push_back(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+      }
+      std::streamsize xsputn( const char* s, std::streamsize n ) override
+      {
+        m_text.append(s, std::size_t(n));
+        return n;
+      }
+    private:
+      std::string& m_text;
+    };
+    /*!
+     *   \brief Write the text beginning the messages of the log macros
+     *           ( rank, mode and call site )
+     */
+    static void writePrefix( std::ostream& out, int mode, const CallSite& site, int rank );
+
     class Listener
     {
     public:
@@ -43,41 +82,129 @@ namespace Parallel
       bool toReport( int mode ) const {
         return m_flags & mode;
       }
+      /*!
+       *   \brief Beginning of a message ( by default, the prefix of writePrefix if the
+       *          message has a call site )
+       */
+      virtual void begin( int mode, const CallSite& site, int rank )
+      {
+        if ( site.file != nullptr ) writePrefix( report(), mode, site, rank );
+      }
+      /*!
+       *   The arguments of the messages of these types are given to these functions
+       *   ( written in report() by default ), the others are written in report().
+       */
+      virtual void put( long long value )          { report() << value; }
+      virtual void put( unsigned long long value ) { report() << value; }
+      virtual void put( double value )             { report() << value; }
+      virtual void put( const char* text, std::size_t length ) { report().write(text, std::streamsize(length)); }
+      virtual void flush() { report().flush(); }
+      /*!
+       *   \brief End of the parallel session ( see Logger::close )
+       */
+      virtual void close() {}
     private:
       int m_flags;
     };
 
+    /*!
+     *   \enum overflow_policy
+     *   \brief Behaviour of the asynchronous mode when the queue of the messages is full
+     */
+    enum overflow_policy {
+      block_when_full, /*!< The thread waits until the writer made room */
+      drop_when_full   /*!< The message is lost ( and counted by dropped() ) */
+    };
+
     Logger();
     
     Logger(const Logger& log) = delete;
     Logger( Logger&& log ) = delete;
-    ~Logger() { flush(); }
+    ~Logger();
 
     Logger& operator = ( const Logger& ) = delete;
     Logger& operator = ( Logger&& ) = delete;
 
     bool subscribe  (Listener* listener);
     bool unsubscribe(Listener* listener);
+    /*!
+     *   \brief Return true if a listener reports the messages of mode
+     *
+     *   The log macros test it before evaluating their arguments.
+     */
+    bool wants( int mode ) const { return ( m_wanted.load(std::memory_order_relaxed) & mode ) != 0; }
+
+    /*!
+     *   \brief Write the messages in the listeners with a background thread
+     *
+     *   In the asynchronous mode, each thread formats its message in its own buffer.
+     *   A message ended by a new line ( or by flush() ) is pushed without lock in a
+     *   queue of capacity messages, which is emptied by a background thread writing
+     *   the messages in the listeners and flushing them after each batch. So the
+     *   messages of several threads don't interleave and the I/O don't stall the
+     *   threads. The asynchronous mode is also set by the environment variable
+     *   PARALLEL_LOG_ASYNC ( "block" or "drop" for the overflow policy ).
+     *
+     *   \param async    True to start the background thread, false to stop it
+     *                   ( after the writing of all the queued messages )
+     *   \param capacity Maximal number of messages in the queue ( rounded to a power of two )
+     *   \param policy   What to do with a message when the queue is full
+     */
+    void setAsynchronous( bool async, std::size_t capacity = 4096,
+                          overflow_policy policy = block_when_full );
+    bool isAsynchronous() const { return bool(m_writer); }
+    /*!
+     *   \brief Number of messages lost because the queue was full ( drop_when_full policy )
+     */
+    std::size_t dropped() const;
 
     Logger& operator [] ( int mode )
     {
-      m_current_mode = mode;
-      return *this;
+      return start( mode, CallSite{ nullptr, nullptr, 0 } );
     }
-    Logger& flush()
+    /*!
+     *   \brief Begin a message of mode logged at site ( see the log macros )
+     */
+    Logger& start( int mode, const CallSite& site )
     {
+      if ( m_writer ) {
+        Record& record = current();
+        if ( !record.text.empty() ) commit(record);
+        record.mode = mode;
+        record.site = site;
+        return *this;
+      }
+      m_current_mode = mode;
       for ( auto listener : m_listeners )
-        listener->report().flush();
+        if ( listener->toReport(mode) ) listener->begin( mode, site, m_rank );
       return *this;
     }
+    /*!
+     *   \brief Flush the listeners
+     *
+     *   In the asynchronous mode, the message of the calling thread is pushed and the call
+     *   returns when the background thread wrote all the messages pushed before.
+     */
+    Logger& flush();
+    /*!
+     *   \brief Flush and close the listeners ( collective call on world )
+     *
+     *   Called by the context before the end of the parallel library, for the listeners
+     *   which communicate.
+     */
+    void close();
     // ..........................................................................
     template<typename K> inline Parallel::Logger&
     operator << ( const K& obj )
     {
+      if ( m_writer ) {
+        Record& record = current();
+        record.stream << obj;
+        if ( !record.text.empty() && record.text.back() == '\n' ) commit(record);
+        return *this;
+      }
       for ( auto listener : m_listeners )
-        if ( listener->toReport(m_current_mode) ) {
-          listener->report() << obj;
-        }
+        if ( listener->toReport(m_current_mode) ) put( *listener, obj );
       return *this;
     }
 
@@ -94,43 +221,126 @@ namespace Parallel
     int m_rank;
     typedef Logger& (*Logger_manip)(Logger &);
     Logger& operator<<(Logger_manip manip) { return manip(*this); }
+    // Gives the type void to a log statement ( see PARALLEL_LOG )
+    struct Voidify
+    {
+      void operator & ( Logger& ) const {}
+    };
   private:
+    class AsyncWriter;
+    // Kinds of the arguments given to the listeners
+    enum argument_kind { other_argument, text_argument, real_argument, integer_argument };
+    template<typename K> static void put( Listener& listener, const K& obj )
+    {
+      typedef typename std::decay<K>::type T;
+      put( listener, obj, std::integral_constant<argument_kind,
+           std::is_convertible<const K&, const char*>::value ? text_argument :
+           std::is_floating_point<T>::value ? real_argument :
+           std::is_integral<T>::value && !std::is_same<T, char>::value && !std::is_same<T, bool>::value ?
+             integer_argument : other_argument>() );
+    }
+    static void put( Listener& listener, const std::string& text ) { listener.put( text.data(), text.size() ); }
+    template<typename K> static void put( Listener& listener, const K& obj,
+                                          std::integral_constant<argument_kind, other_argument> )
+    {
+      listener.report() << obj;
+    }
+    template<typename K> static void put( Listener& listener, const K& text,
+                                          std::integral_constant<argument_kind, text_argument> )
+    {
+      const char* chars = text;
+      listener.put( chars, std::char_traits<char>::length(chars) );
+    }
+    template<typename K> static void put( Listener& listener, const K& value,
+                                          std::integral_constant<argument_kind, real_argument> )
+    {
+      listener.put( double(value) );
+    }
+    template<typename K> static void put( Listener& listener, const K& value,
+                                          std::integral_constant<argument_kind, integer_argument> )
+    {
+      if ( std::is_signed<K>::value ) listener.put( static_cast<long long>(value) );
+      else listener.put( static_cast<unsigned long long>(value) );
+    }
+    // Message being formatted by a thread in the asynchronous mode
+    struct Record
+    {
+      Record() : owner(nullptr), mode(INFORMATION), site{ nullptr, nullptr, 0 }, buffer(text), stream(&buffer) {}
+      const Logger* owner;
+      int           mode;
+      CallSite      site;
+      std::string   text;
+      TextBuffer    buffer;
+      std::ostream  stream;
+    };
+    Record& current()
+    {
+      thread_local Record record;
+      if ( record.owner != this ) {
+        record.owner = this;
+        record.mode  = INFORMATION;
+        record.site  = CallSite{ nullptr, nullptr, 0 };
+        record.text.clear();
+      }
+      return record;
+    }
+    void commit( Record& record );
+
+    void updateWanted();
+
     int m_current_mode;
+    std::atomic<int> m_wanted; // Union of the flags of the listeners
     std::list<Listener*> m_listeners;
+    std::mutex m_listeners_mutex; // The background thread writes in the listeners
+    std::unique_ptr<AsyncWriter> m_writer;
   };
 
+
+  /*!
+   *   Modes compiled in the log macros : the statements of a mode greater than
+   *   PARALLEL_LOG_LEVEL are removed by the compiler. PARALLEL_LOG_LEVEL is set by the
+   *   cmake variable of the same name ( ASSERTION, ERROR, WARNING, INFORMATION or TRACE ).
+   */
+# define PARALLEL_LOG_ASSERTION   1
+# define PARALLEL_LOG_ERROR       2
+# define PARALLEL_LOG_WARNING     4
+# define PARALLEL_LOG_INFORMATION 8
+# define PARALLEL_LOG_TRACE       16
+# ifndef PARALLEL_LOG_LEVEL
+#   define PARALLEL_LOG_LEVEL PARALLEL_LOG_TRACE
+# endif
+
+  // Beginning of a log statement : the arguments are evaluated only if the mode is compiled
+  // and if a listener reports it. The statement is one expression ( the operator & of Voidify
+  // has a lower precedence than << ), so it can be the body of an if without braces.
+# define PARALLEL_LOG( mode, cond )                                      \
+  ( (mode) > PARALLEL_LOG_LEVEL || !(cond) ||                            \
+    !Parallel::Context::logger.wants(mode) ) ? (void)0 :                 \
+    Parallel::Logger::Voidify() &                                        \
+    Parallel::Context::logger.start( mode, Parallel::Logger::CallSite{ __FILE__, __FUNCTION__, __LINE__ } )
+
+  // The listeners write the rank, the mode and the call site at the beginning of the messages
+  // ( see Logger::writePrefix ). Logged if cond is false :
+# define LogAssert( cond ) PARALLEL_LOG( Parallel::Logger::ASSERTION, !(cond) )
+
+# define LogWarning PARALLEL_LOG( Parallel::Logger::WARNING, true )
+
+# define LogError PARALLEL_LOG( Parallel::Logger::ERROR, true )
+
+# define LogInformation PARALLEL_LOG( Parallel::Logger::INFORMATION, true )
   
-# define Mode (cond) \
-  ((cond) ? Parallel::Logger::ASSERTION : Parallel::Logger::NOTHING)
-
-# define LogAssert( cond )                                             \
-    Parallel::Context::logger[Mode(cond)] << Parallel::Context::logger.m_rank << " : [ [Assertion] " \
-                                    << std::string(__FILE__) << " in "                         \
-                 << std::string(__FUNCTION__) << " at " << std::to_string(__LINE__) << " ] : "
-
-# define LogWarning                                           \
-  Parallel::Context::logger[Parallel::Logger::WARNING] << Parallel::Context::logger.m_rank \
-  << " : [ [Warning] " << std::string(__FILE__)                            \
-  << " in " << std::string(__FUNCTION__) << " at " <<  std::to_string(__LINE__)  << " ] : "
-
-# define LogError \
-  Parallel::Context::logger[Parallel::Logger::ERROR] << Parallel::Context::logger.m_rank \
-  << " : [ [Error] " << std::string(__FILE__)                            \
-  << " in " << std::string(__FUNCTION__) << " at " <<  std::to_string(__LINE__)  << " ] : "
-
-# define LogInformation \
-  Parallel::Context::logger[Parallel::Logger::INFORMATION] << Parallel::Context::logger.m_rank \
-  << " : [Information] "
-  
-# define LogTrace \
-    Parallel::Context::logger[Parallel::Logger::TRACE] << Parallel::Context::logger.m_rank \
-  << " : [ [Trace] " << std::string(__FILE__)                            \
-  << " in " << std::string(__FUNCTION__) << " at " <<  std::to_string(__LINE__)  << " ] : "
+# define LogTrace PARALLEL_LOG( Parallel::Logger::TRACE, true )
 
 }
 
 namespace std {
-  inline Parallel::Logger& endl(Parallel::Logger & out) { out << "\n"; out.flush(); return out; }
+  // In the asynchronous mode, the background thread flushes the listeners after each batch
+  inline Parallel::Logger& endl(Parallel::Logger & out)
+  {
+    out << "\n";
+    if ( !out.isAsynchronous() ) out.flush();
+    return out;
+  }
 }
 
 #endif
@@ -0,0 +1,95 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    NodeHierarchy.hpp
+ *    \brief   Node aware collective operations ( MPI only )
+ */
+#ifndef _PARALLEL_NODEHIERARCHY_HPP_
+# define _PARALLEL_NODEHIERARCHY_HPP_
+# if defined(USE_MPI)
+# include <vector>
+# include <mpi.h>
+
+namespace Parallel
+{
+    /*!   \class NodeHierarchy
+     *    \brief Two levels view of a communicator : the processes of each node and
+     *           the leaders of the nodes
+     *
+     *    The hierarchy is built with MPI_Comm_split_type( MPI_COMM_TYPE_SHARED ) :
+     *    a node communicator gathers the processes sharing the memory and a leaders
+     *    communicator gathers the process of rank 0 of each node. The hierarchy is
+     *    cached as an attribute of the communicator ( and freed with it ).
+     *
+     *    The static collective functions have the signatures of their MPI
+     *    counterparts : they run in two levels if a hierarchy is attached to the
+     *    communicator, else they call directly MPI.
+     */
+    class NodeHierarchy
+    {
+    public:
+        NodeHierarchy( const NodeHierarchy& ) = delete;
+        NodeHierarchy& operator = ( const NodeHierarchy& ) = delete;
+        ~NodeHierarchy();
+        /*!
+         *   \brief Build the hierarchy of com and attach it to com ( collective call )
+         */
+        static void attach( MPI_Comm com );
+        /*!
+         *   \brief Remove the hierarchy attached to com if any
+         */
+        static void detach( MPI_Comm com );
+        /*!
+         *   \brief Hierarchy attached to com ( null pointer if none )
+         */
+        static const NodeHierarchy* get( MPI_Comm com );
+
+        static int bcast( void* buffer, int count, MPI_Datatype type, int root, MPI_Comm com );
+        /*!
+         *   \brief Reduction in two levels if the operation is commutative
+         */
+        static int reduce( const void* sndbuf, void* rcvbuf, int count, MPI_Datatype type,
+                           MPI_Op op, int root, MPI_Comm com );
+        /*!
+         *   \brief Reduction in two levels if the operation is commutative
+         */
+        static int allreduce( const void* sndbuf, void* rcvbuf, int count, MPI_Datatype type,
+                              MPI_Op op, MPI_Comm com );
+        /*!
+         *   \brief Number of nodes
+         */
+        int nbNodes() const { return m_nb_nodes; }
+    private:
+        NodeHierarchy( MPI_Comm com );
+        bool isLeader() const { return m_leaders != MPI_COMM_NULL; }
+
+        static int keyval();
+        static int free_attribute( MPI_Comm com, int keyval, void* attribute, void* extra_state );
+
+        int  hierarchical_bcast( void* buffer, int count, MPI_Datatype type, int root ) const;
+        int  hierarchical_reduce( const void* sndbuf, void* rcvbuf, int count, MPI_Datatype type,
+                                  MPI_Op op, int root ) const;
+        int  hierarchical_allreduce( const void* sndbuf, void* rcvbuf, int count,
+                                     MPI_Datatype type, MPI_Op op ) const;
+
+        MPI_Comm m_node;              /*!< Processes of the node of the current process */
+        MPI_Comm m_leaders;           /*!< Leaders of the nodes ( null if not a leader ) */
+        int m_rank;                   /*!< Rank in the communicator */
+        int m_nb_nodes;
+        std::vector<int> m_node_of;   /*!< For each rank, rank of its node in the leaders communicator */
+        std::vector<int> m_node_rank; /*!< For each rank, its rank inside its node */
+    };
+}
+# endif
+#endif
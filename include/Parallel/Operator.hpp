@@ -16,15 +16,74 @@
  */
 #ifndef _PARALLEL_OPERATOR_HPP_
 # define _PARALLEL_OPERATOR_HPP_
+# if defined(USE_MPI)
+#   include <mpi.h>
 
 namespace Parallel
 {
-    template<typename K> class Operator
+    /*!   \class OperatorRegistry
+     *    \brief Registry of the MPI operators created for the user reduction functions
+     *
+     *    The operators are created once and freed by the destruction of the
+     *    parallel context ( before MPI_Finalize ). The registry can be used
+     *    by several threads.
+     */
+    class OperatorRegistry
     {
+    public:
+        /*!
+         *   \brief Create and register a new MPI operator
+         */
+        static MPI_Op create( MPI_User_function* fct, bool commute );
+        /*!
+         *   \brief Free all the registered operators ( called by the Context destructor )
+         */
+        static void freeAll();
+    };
+    // =================================================================
+    /*!   \class Operator
+     *    \brief MPI reduction operator applying a user function of type F to objects of type K
+     *
+     *    One MPI operator is created per type of function ( and per commutativity )
+     *    and reused by all the reductions. The function object used by a reduction is
+     *    given to the operator through a thread local pointer, so several threads can
+     *    reduce with the same type of function at the same time. The Operator instance
+     *    must live until the completion of the reduction ( the reduction must be a
+     *    blocking one ).
+     */
+    template<typename K, typename F> class Operator
+    {
+    public:
+        Operator( const F& fct, bool commute ) : m_previous(s_functor), m_commute(commute)
+        {
+            s_functor = &fct;
+        }
+        Operator( const Operator& ) = delete;
+        ~Operator() { s_functor = m_previous; }
+        Operator& operator = ( const Operator& ) = delete;
+        /*!
+         *   \brief The MPI operator to use in the reduction
+         */
+        MPI_Op mpi_op() const
+        {
+            static const MPI_Op commutative     = OperatorRegistry::create( apply, true  );
+            static const MPI_Op non_commutative = OperatorRegistry::create( apply, false );
+            return ( m_commute ? commutative : non_commutative );
+        }
     private:
-        struct Implementation;
-        Implementation* m_impl;
+        static void apply( void* x, void* y, int* length, MPI_Datatype* )
+        {
+            const F& fct = *s_functor;
+            const K* ax = static_cast<const K*>(x);
+            K* ay = static_cast<K*>(y);
+            for ( int i = 0; i < *length; ++i )
+                ay[i] = fct(ax[i], ay[i]);
+        }
+        static thread_local const F* s_functor;
+        const F* m_previous; // For nested reductions ( inside a reduction function )
+        bool m_commute;
     };
+    template<typename K, typename F> thread_local const F* Operator<K,F>::s_functor = nullptr;
 }
-
+# endif
 #endif
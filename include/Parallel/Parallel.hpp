@@ -16,5 +16,11 @@
 
 # include "Parallel/Context.hpp"
 # include "Parallel/Communicator"
+# include "Parallel/Profiler.hpp"
+# include "Parallel/Trace.hpp"
+# include "Parallel/SharedArray.hpp"
+# include "Parallel/Window.hpp"
+# include "Parallel/Topology.hpp"
+# include "Parallel/BlockMatrix.hpp"
 
 #endif
@@ -0,0 +1,213 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    Profiler.hpp
+ *    \brief   Statistics of the communications of the processes
+ */
+#ifndef _PARALLEL_PROFILER_HPP_
+# define _PARALLEL_PROFILER_HPP_
+# include <array>
+# include <atomic>
+# include <chrono>
+# include <map>
+# include <mutex>
+# include <ostream>
+# include <string>
+# include <type_traits>
+# ifdef USE_MPI
+# include <mpi.h>
+# endif
+# include "Parallel/Constantes.hpp"
+# include "Parallel/DetectContainer.hpp"
+# include "Parallel/Trace.hpp"
+
+namespace Parallel
+{
+    class Communicator;
+    /*!   \class Profiler
+     *    \brief Counters of the communications of the current process
+     *
+     *    When the profiler is enabled, each call of a communication method of
+     *    Communicator is recorded : number of calls, bytes and wall time by
+     *    operation, histogram of the sizes of the messages by operation and, for
+     *    the point to point communications, the messages and bytes exchanged with
+     *    each process ( by rank in the world communicator ). The bytes are the
+     *    size of the data given to the call by the current process. The time of a
+     *    non blocking call is the time to post the communication.
+     *
+     *    The profiler is enabled by the environment variable PARALLEL_PROFILE
+     *    ( csv or json ) or by enable(), on all the processes. At the destruction
+     *    of the context, each process writes its counters in the file
+     *    Profile<rank>.csv ( or .json ), the process 0 writes the communication
+     *    matrix ( bytes sent by each process to each process ) in ProfileMatrix.csv
+     *    and a summary by operation in the logger.
+     *
+     *    Without MPI, each simulated process has its own profiler.
+     */
+    class Profiler
+    {
+    public:
+        /*!
+         *   \enum operation
+         *   \brief The profiled communications
+         */
+        enum operation {
+            send = 0, isend, recv, irecv,
+            bcast, ibcast, reduce, ireduce, allreduce, iallreduce,
+            gather, allgather, iallgather, scatter, alltoall, ialltoall,
+            neighbor, barrier, ibarrier,
+            nb_operations
+        };
+        enum format_type { csv, json };
+        /*!
+         *   \brief Number of bins of the histograms : the bin 0 counts the empty messages,
+         *          the bin b the messages of 2^(b-1) to 2^b - 1 bytes, the last bin the larger ones.
+         */
+        static constexpr int nb_bins = 42;
+
+        struct Counters
+        {
+            std::size_t calls = 0, bytes = 0;
+            double      seconds = 0.;
+            std::array<std::size_t, nb_bins> histogram{};
+        };
+        struct PeerCounters
+        {
+            std::size_t sent = 0, sentBytes = 0, received = 0, receivedBytes = 0;
+        };
+        typedef std::chrono::steady_clock clock;
+        // .............................................................
+        /*!   \class Probe
+         *    \brief Record a communication of the duration of the probe ( nothing if the
+         *           profiler and the tracer are disabled )
+         *
+         *    The communication is counted by the profiler and traced by the tracer.
+         */
+        class Probe
+        {
+        public:
+            /*!
+             *   \param com   The communicator of the call
+             *   \param op    The operation
+             *   \param peer  Rank in com of the other process ( destination, source or root ) or no_process
+             *   \param bytes Size of the data
+             */
+            Probe( const Communicator& com, operation op, int peer = no_process, std::size_t bytes = 0 ) :
+                m_profiler( current().isEnabled() ? &current() : nullptr ),
+                m_tracer( Tracer::current().isEnabled() ? &Tracer::current() : nullptr ),
+                m_com(com), m_op(op), m_peer(peer), m_bytes(bytes)
+            {
+                if ( m_tracer   != nullptr ) m_tracer->begin( name(op) );
+                if ( m_profiler != nullptr ) m_start = clock::now();
+            }
+            Probe( const Probe& ) = delete;
+            ~Probe() { if ( isActive() ) finish(); }
+            Probe& operator = ( const Probe& ) = delete;
+
+            /*!
+             *   \brief Return true if the communication is recorded
+             */
+            bool isActive() const { return m_profiler != nullptr || m_tracer != nullptr; }
+            void setPeer ( int peer ) { m_peer = peer; }
+            void setBytes( std::size_t bytes ) { m_bytes = bytes; }
+        private:
+            void finish();
+
+            Profiler*           m_profiler;
+            Tracer*             m_tracer;
+            const Communicator& m_com;
+            operation           m_op;
+            int                 m_peer;
+            std::size_t         m_bytes;
+            clock::time_point   m_start;
+        };
+        // .............................................................
+        /*!
+         *   \brief The profiler of the current process
+         */
+        static Profiler& current();
+        /*!
+         *   \brief Name of an operation
+         */
+        static const char* name( operation op );
+        /*!
+         *   \brief Size in bytes of an object or of the data of a container
+         */
+        template<typename K> static std::size_t bytes( const K& obj )
+        {
+            return bytes( obj, std::integral_constant<bool, is_container<K>::value>() );
+        }
+
+        Profiler( const Profiler& ) = delete;
+        Profiler& operator = ( const Profiler& ) = delete;
+        /*!
+         *   \brief Start to record the communications
+         *
+         *   \param format   Format of the files written at the destruction of the context
+         *   \param fileBase Beginning of the names of these files
+         */
+        void enable( format_type format = csv, const std::string& fileBase = "Profile" );
+        void disable() { m_enabled = false; }
+        bool isEnabled() const { return m_enabled; }
+        /*!
+         *   \brief Reset all the counters
+         */
+        void clear();
+        /*!
+         *   \brief Record a communication
+         *
+         *   \param op      The operation
+         *   \param peer    Rank in the world communicator of the other process or no_process
+         *   \param bytes   Size of the data
+         *   \param seconds Duration of the call
+         */
+        void record( operation op, int peer, std::size_t bytes, double seconds );
+        const Counters& counters( operation op ) const { return m_counters[op]; }
+        /*!
+         *   \brief Point to point communications with each process ( by world rank )
+         */
+        const std::map<int, PeerCounters>& peers() const { return m_peers; }
+        /*!
+         *   \brief Write the counters of the current process
+         */
+        void write( std::ostream& out, format_type format ) const;
+        /*!
+         *   \brief Write the files of the profiles and build the summary ( collective call on world )
+         *
+         *   The profiler is disabled. Nothing is done if no process enabled its profiler.
+         *
+         *   \return The summary by operation on the root process, an empty string on the others
+         */
+        std::string report( int root = 0 );
+    private:
+        Profiler();
+        template<typename K> static std::size_t bytes( const K& obj, std::true_type )
+        {
+            return obj.size()*sizeof(typename K::value_type);
+        }
+        template<typename K> static std::size_t bytes( const K&, std::false_type )
+        {
+            return sizeof(K);
+        }
+
+        std::atomic<bool> m_enabled;
+        format_type       m_format;
+        std::string       m_fileBase;
+        std::array<Counters, nb_operations> m_counters;
+        std::map<int, PeerCounters>         m_peers;
+        std::mutex        m_mutex; // Several threads can communicate at the same time
+    };
+}
+
+#endif
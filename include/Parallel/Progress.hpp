@@ -0,0 +1,145 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    Progress.hpp
+ *    \brief   Background thread driving the communications
+ */
+#ifndef _PARALLEL_PROGRESS_HPP_
+# define _PARALLEL_PROGRESS_HPP_
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <functional>
+# include <map>
+# include <mutex>
+# include <thread>
+# include <utility>
+# include <vector>
+# ifdef USE_MPI
+# include <mpi.h>
+# endif
+# include "Parallel/Request.hpp"
+
+namespace Parallel
+{
+    /*!   \class ProgressEngine
+     *    \brief Thread completing the non-blocking communications while the
+     *           process computes
+     *
+     *    Many MPI libraries progress the non-blocking communications only inside
+     *    the calls to the library. When it is started, the engine wakes up at each
+     *    poll interval ( or when a request is submitted ) and :
+     *    1. tests the requests submitted to it ( one MPI_Testsome ) and calls their
+     *       callbacks as soon as they are completed ;
+     *    2. enters the library ( MPI_Iprobe ) to progress the requests kept by the
+     *       program, which are completed later by their wait() as usual ;
+     *    3. calls the hooks registered by addHook().
+     *    The callbacks and the hooks are called by the thread of the engine.
+     *
+     *    The engine of a process is owned by its context ( see Context::progress ).
+     *    It can be started only with the multiple thread support. It is started by
+     *    start() or at the creation of the context by the environment variables
+     *    PARALLEL_PROGRESS ( poll interval in microseconds ) and PARALLEL_PROGRESS_CPU
+     *    ( core where the thread is bound ). It is stopped at the destruction of
+     *    the context.
+     *
+     *    Without MPI, the engine can't be started : the mailbox of a simulated process
+     *    is read only by the thread of the process ( see ThreadGroup ) and the sends
+     *    never block. PARALLEL_PROGRESS is ignored and the submitted requests are
+     *    completed by waitAll().
+     */
+    class ProgressEngine
+    {
+    public:
+        typedef std::function<void()> Hook;
+        typedef std::chrono::microseconds interval_type;
+
+        ProgressEngine() = default;
+        ProgressEngine( const ProgressEngine& ) = delete;
+        ~ProgressEngine();
+        ProgressEngine& operator = ( const ProgressEngine& ) = delete;
+        /*!
+         *   \brief Start the thread of the engine
+         *
+         *   \param interval Time between two polls of the communications
+         *   \param cpu      Core where the thread is bound ( none if negative )
+         *   \return         False without MPI, if the context hasn't the multiple thread
+         *                   support or if the engine is already started
+         */
+        bool start( interval_type interval = interval_type(100), int cpu = -1 );
+        /*!
+         *   \brief Stop the thread of the engine
+         *
+         *   The submitted requests not completed stay in the engine : they are
+         *   tested again after a new start or completed by waitAll().
+         */
+        void stop();
+        bool isRunning() const { return m_running; }
+        /*!
+         *   \brief Time between two polls of the communications
+         */
+        interval_type interval() const { return m_interval; }
+        /*!
+         *   \brief Give a request to the engine, which completes it
+         *
+         *   \param req      The request, moved in the engine
+         *   \param callback Function called by the engine with the status of the
+         *                   request when it is completed ( optional ). If the request
+         *                   is already completed, it is called by submit().
+         */
+        void submit( Request&& req, const RequestSet::Callback& callback = RequestSet::Callback() );
+        /*!
+         *   \brief Number of submitted requests not yet completed
+         */
+        std::size_t pending() const { return m_nb_submitted - m_nb_completed; }
+        /*!
+         *   \brief Wait the completion of all the submitted requests
+         *
+         *   If the engine isn't started, the requests are completed by the calling thread.
+         */
+        void waitAll();
+        /*!
+         *   \brief Register a function called by the engine at each poll
+         *
+         *   \return The identifier of the hook for removeHook()
+         */
+        int addHook( const Hook& hook );
+        /*!
+         *   \brief Unregister a hook. The hook isn't running anymore at the return.
+         */
+        void removeHook( int id );
+    private:
+        friend class Context;
+        // Move the submitted requests in m_requests ( m_mutex locked )
+        void takeSubmitted();
+        // One poll of the communications and of the hooks
+        void poll();
+        void run();
+
+        bool                    m_is_allowed = false; // MPI with the multiple thread support
+        std::atomic<bool>       m_running{false};
+        interval_type           m_interval{100};
+        std::thread             m_thread;
+        std::mutex              m_mutex;
+        std::condition_variable m_wakeup, m_done;
+        std::vector<std::pair<Request, RequestSet::Callback>> m_submitted; // Not yet seen by the thread
+        RequestSet              m_requests; // Only used by the thread of the engine when it runs
+        std::atomic<std::size_t> m_nb_submitted{0}, m_nb_completed{0};
+        std::mutex              m_hooks_mutex;
+        std::map<int, Hook>     m_hooks;
+        int                     m_next_hook = 0;
+    };
+}
+
+#endif
@@ -14,7 +14,13 @@
 // Request
 #ifndef _PARALLEL_REQUEST_HPP_
 # define _PARALLEL_REQUEST_HPP_ 
-# include "Parallel/Constantes.hpp"
+# include <cassert>
+# include <functional>
+# include <memory>
+# include <thread>
+# include <vector>
+# include "Parallel/Status.hpp"
+# include "Parallel/Trace.hpp"
 
 # ifdef USE_MPI
 # include <mpi.h>
@@ -23,33 +29,460 @@ namespace Parallel
     class Request
     {
     public:
-        Request( const MPI_Request& req ) : m_req(req)
+        /*!
+         *   \brief Function starting a persistent communication ( the default starter
+         *          calls MPI_Start )
+         */
+        typedef std::function<void(MPI_Request&)> Starter;
+
+        Request() : m_req(MPI_REQUEST_NULL), m_active(false)
+        {}
+        Request( const MPI_Request& req ) : m_req(req), m_active(req != MPI_REQUEST_NULL)
+        {}
+        /*!
+         *   \brief Request with an action to do when the communication is completed
+         *
+         *   The action is called once by test() or wait() when the communication
+         *   is completed ( copy of a temporary buffer inside the user container by
+         *   example ). The action can own the temporary buffers used by the
+         *   communication, so these buffers stay alive until the completion.
+         */
+        Request( const MPI_Request& req, const std::function<void()>& on_completion ) :
+            m_req(req), m_on_completion(on_completion), m_active(req != MPI_REQUEST_NULL)
         {}
+        /*!
+         *   \brief Build an inactive persistent request which can be started several times
+         *
+         *   \param req           The persistent request created by the underlying library
+         *                        ( or MPI_REQUEST_NULL if the request is emulated by the starter )
+         *   \param starter       Function starting the communication ( MPI_Start if empty )
+         *   \param on_completion Action called at each completion of the communication
+         */
+        static Request persistent( const MPI_Request& req, const Starter& starter = Starter(),
+                                   const std::function<void()>& on_completion = std::function<void()>() )
+        {
+            Request preq;
+            preq.m_req           = req;
+            preq.m_starter       = starter;
+            preq.m_on_completion = on_completion;
+            if ( req != MPI_REQUEST_NULL )
+                preq.m_persistent = std::shared_ptr<MPI_Request>( new MPI_Request(req), free_persistent );
+            preq.m_is_persistent = true;
+            return preq;
+        }
+        /*!
+         *   \brief Return true if the request is a persistent request
+         */
+        bool isPersistent() const { return m_is_persistent; }
+        /*!
+         *   \brief Start ( or restart ) a persistent request. The previous communication
+         *          of this request must be completed.
+         */
+        void start() {
+            assert(m_is_persistent && !m_active);
+            if ( m_starter ) m_starter(m_req);
+            else MPI_Start(&m_req);
+            m_active = true;
+        }
         bool test() {
+            if ( !m_active ) return true;
             int flag;
             MPI_Test( &m_req, &flag, &m_status );
+            if ( flag != 0 ) complete();
             return (flag!=0);
         }
         void wait() {
+            if ( !m_active ) return;
+            Tracer::Scope trace("wait");
             MPI_Wait( &m_req, &m_status );
+            complete();
         }
         Status status() const { return Status(m_status); }
     private:
+        void complete() {
+            m_active = false;
+            if ( m_on_completion ) {
+                if ( m_is_persistent ) m_on_completion();
+                else {
+                    std::function<void()> action;
+                    action.swap(m_on_completion);
+                    action();
+                }
+            }
+        }
+        static void free_persistent( MPI_Request* req ) {
+            int finalized;
+            MPI_Finalized(&finalized);
+            if ( !finalized && (*req != MPI_REQUEST_NULL) ) MPI_Request_free(req);
+            delete req;
+        }
+        friend class RequestSet;
         MPI_Request m_req;
         MPI_Status  m_status;
+        std::function<void()> m_on_completion;
+        Starter m_starter;
+        std::shared_ptr<MPI_Request> m_persistent;
+        bool m_active;
+        bool m_is_persistent = false;
+    };
+    // =================================================================
+    /*!   \class RequestSet
+     *    \brief A set of requests completed together
+     *
+     *    The requests are stored in a contiguous array of MPI requests, so
+     *    the set can be completed with only one call to the underlying library.
+     *    The status of each request is stored in the set and can be read
+     *    after completion. A callback can be attached to each request : it is
+     *    called as soon as the request is completed, in the completion order.
+     */
+    class RequestSet
+    {
+    public:
+        typedef std::function<void(const Status&)> Callback;
+
+        RequestSet() = default;
+        /*!
+         *   \brief Build an empty set with memory reserved for nbRequests requests
+         */
+        explicit RequestSet( std::size_t nbRequests )
+        {
+            m_requests.reserve(nbRequests);
+            m_statuses.reserve(nbRequests);
+            m_requests_data.reserve(nbRequests);
+        }
+        /*!
+         *   \brief Add a request in the set
+         *
+         *   \param req      The request to add. The request is moved in the set.
+         *   \param callback Function called with the status of the request when the
+         *                   request is completed ( optional )
+         *   \return         The index of the request in the set
+         */
+        std::size_t push_back( Request&& req, const Callback& callback = Callback() )
+        {
+            m_requests.push_back(req.m_req);
+            m_statuses.emplace_back();
+            m_requests_data.push_back(RequestData{std::move(req.m_on_completion), callback,
+                                                  std::move(req.m_starter),
+                                                  std::move(req.m_persistent),
+                                                  req.m_active, req.m_is_persistent});
+            m_has_callbacks |= bool(callback);
+            m_has_starters  |= bool(m_requests_data.back().starter);
+            if ( req.m_active ) ++ m_nb_pending;
+            req.m_req    = MPI_REQUEST_NULL;
+            req.m_active = false;
+            return m_requests.size()-1;
+        }
+        /*!
+         *   \brief Number of requests in the set
+         */
+        std::size_t size() const { return m_requests.size(); }
+        /*!
+         *   \brief Number of requests not yet completed
+         */
+        std::size_t pending() const { return m_nb_pending; }
+        /*!
+         *   \brief Remove all the requests of the set. The requests must be completed.
+         */
+        void clear()
+        {
+            m_requests.clear(); m_statuses.clear(); m_requests_data.clear(); m_indices.clear();
+            m_nb_pending = 0; m_has_callbacks = false; m_has_starters = false;
+        }
+        /*!
+         *   \brief Start ( or restart ) the i-th request of the set which must be persistent
+         */
+        void start( std::size_t i )
+        {
+            RequestData& data = m_requests_data[i];
+            assert(data.is_persistent && !data.active);
+            if ( data.starter ) data.starter(m_requests[i]);
+            else MPI_Start(&m_requests[i]);
+            data.active = true;
+            ++ m_nb_pending;
+        }
+        /*!
+         *   \brief Start ( or restart ) all the requests of the set which must be persistent
+         *
+         *   If no request is emulated, all the requests are started with only one call.
+         */
+        void startAll()
+        {
+            if ( m_has_starters ) {
+                for ( std::size_t i = 0; i < m_requests.size(); ++i ) start(i);
+                return;
+            }
+            MPI_Startall( int(m_requests.size()), m_requests.data() );
+            for ( auto& data : m_requests_data ) {
+                assert(data.is_persistent && !data.active);
+                data.active = true;
+            }
+            m_nb_pending = m_requests.size();
+        }
+        /*!
+         *   \brief Wait the completion of all the requests of the set
+         *
+         *   Without callback, all requests are completed with only one call. With
+         *   callbacks, the requests are completed by groups to call the callbacks
+         *   as soon as possible.
+         */
+        void waitAll()
+        {
+            Tracer::Scope trace("waitAll");
+            if ( m_has_callbacks ) {
+                while ( m_nb_pending > 0 ) waitSome();
+                return;
+            }
+            // MPI writes an empty status for the requests already completed : the
+            // statuses are copied only for the requests completed by this call
+            m_some_statuses.resize(m_requests.size());
+            MPI_Waitall( int(m_requests.size()), m_requests.data(), m_some_statuses.data() );
+            for ( std::size_t i = 0; i < m_requests.size(); ++i )
+                if ( m_requests_data[i].active ) {
+                    m_statuses[i].status = m_some_statuses[i];
+                    complete(i);
+                }
+        }
+        /*!
+         *   \brief Wait the completion of one request of the set
+         *
+         *   \return The index of the completed request or undefined if no request
+         *           of the set is pending.
+         */
+        int waitAny()
+        {
+            Tracer::Scope trace("waitAny");
+            int index;
+            MPI_Status status;
+            MPI_Waitany( int(m_requests.size()), m_requests.data(), &index, &status );
+            if ( index == MPI_UNDEFINED ) return undefined;
+            m_statuses[index].status = status;
+            complete(index);
+            return index;
+        }
+        /*!
+         *   \brief Wait the completion of at least one request of the set
+         *
+         *   \return The indices of the completed requests ( empty if no request of
+         *           the set is pending ). The returned vector is reused by the next call.
+         */
+        const std::vector<int>& waitSome()
+        {
+            Tracer::Scope trace("waitSome");
+            return some(true);
+        }
+        /*!
+         *   \brief Test the completion of the requests of the set without blocking
+         *
+         *   The requests already completed are finalized ( and their callbacks called ).
+         *
+         *   \return True if all the requests of the set are completed
+         */
+        bool testAll()
+        {
+            if ( m_nb_pending > 0 ) some(false);
+            return ( m_nb_pending == 0 );
+        }
+        /*!
+         *   \brief Status of the i-th request ( significant only if this request is completed )
+         */
+        const Status& status( std::size_t i ) const { return m_statuses[i]; }
+        /*!
+         *   \brief Status of all the requests of the set
+         */
+        const std::vector<Status>& statuses() const { return m_statuses; }
+    private:
+        struct RequestData
+        {
+            std::function<void()> on_completion;
+            Callback callback;
+            Request::Starter starter;
+            std::shared_ptr<MPI_Request> persistent;
+            bool active;
+            bool is_persistent;
+        };
+        const std::vector<int>& some( bool blocking )
+        {
+            int outcount;
+            m_indices.resize(m_requests.size());
+            m_some_statuses.resize(m_requests.size());
+            if ( blocking )
+                MPI_Waitsome( int(m_requests.size()), m_requests.data(), &outcount,
+                              m_indices.data(), m_some_statuses.data() );
+            else
+                MPI_Testsome( int(m_requests.size()), m_requests.data(), &outcount,
+                              m_indices.data(), m_some_statuses.data() );
+            if ( outcount == MPI_UNDEFINED ) outcount = 0;
+            m_indices.resize(outcount);
+            for ( int i = 0; i < outcount; ++i ) {
+                m_statuses[m_indices[i]].status = m_some_statuses[i];
+                complete(m_indices[i]);
+            }
+            return m_indices;
+        }
+        void complete( std::size_t index )
+        {
+            RequestData& data = m_requests_data[index];
+            if ( !data.active ) return;
+            data.active = false;
+            -- m_nb_pending;
+            if ( data.on_completion ) {
+                if ( data.is_persistent ) data.on_completion();
+                else {
+                    std::function<void()> action;
+                    action.swap(data.on_completion);
+                    action();
+                }
+            }
+            if ( data.callback ) data.callback(m_statuses[index]);
+        }
+        std::vector<MPI_Request> m_requests;
+        std::vector<Status> m_statuses;
+        std::vector<RequestData> m_requests_data;
+        std::vector<int> m_indices;
+        std::vector<MPI_Status> m_some_statuses; // Written by MPI, copied for the completed requests
+        std::size_t m_nb_pending = 0;
+        bool m_has_callbacks = false;
+        bool m_has_starters  = false;
     };
-    // Waitall to do, not so easy !
 }
 # else
+namespace Parallel
+{
+    /*!   \class Request
+     *    \brief Request of the backend without MPI
+     *
+     *    The processes are simulated by threads ( see ThreadGroup ). A pending
+     *    request owns a progress function which tries to complete the
+     *    communication without blocking and returns true when it is done.
+     */
     class Request
     {
     public:
+        /*!
+         *   \brief Try to complete the communication, fill the status and return
+         *          true if the communication is completed
+         */
+        typedef std::function<bool(Status&)> Progress;
+        /*!
+         *   \brief Function starting the communication of a persistent request and
+         *          returning its progress function ( empty if already completed )
+         */
+        typedef std::function<Progress()> Starter;
+
         Request() {}
-        bool test() { return true; }
-        void wait() {}
-        // To think about status... Some trick to do ?
-        Status status() const { return Status{.m_count=0, .m_tag = 0, .m_error = 0}; }
+        explicit Request( const Progress& progress ) : m_progress(progress)
+        {}
+        /*!
+         *   \brief Build a persistent request : the starter is called at each start
+         */
+        static Request persistent( const Starter& starter )
+        {
+            Request preq;
+            preq.m_starter = starter;
+            return preq;
+        }
+        bool isPersistent() const { return bool(m_starter); }
+        void start() { assert(isPersistent() && !m_progress); m_progress = m_starter(); }
+        bool test() {
+            if ( !m_progress ) return true;
+            if ( !m_progress(m_status) ) return false;
+            m_progress = Progress();
+            return true;
+        }
+        void wait()
+        {
+            if ( !m_progress ) return;
+            Tracer::Scope trace("wait");
+            while ( !test() ) std::this_thread::yield();
+        }
+        Status status() const { return m_status; }
+    private:
+        friend class RequestSet;
+        Progress m_progress;
+        Starter  m_starter;
+        Status   m_status{0, 0, 0, 0};
     };
+    // =================================================================
+    class RequestSet
+    {
+    public:
+        typedef std::function<void(const Status&)> Callback;
+
+        RequestSet() = default;
+        explicit RequestSet( std::size_t nbRequests )
+        {
+            m_requests.reserve(nbRequests);
+            m_callbacks.reserve(nbRequests);
+        }
+        std::size_t push_back( Request&& req, const Callback& callback = Callback() )
+        {
+            m_callbacks.push_back(callback);
+            m_requests.push_back(std::move(req));
+            if ( m_requests.back().m_progress ) ++ m_nb_pending;
+            return m_requests.size()-1;
+        }
+        std::size_t size() const { return m_requests.size(); }
+        std::size_t pending() const { return m_nb_pending; }
+        void clear() { m_callbacks.clear(); m_requests.clear(); m_indices.clear(); m_nb_pending = 0; }
+        void start( std::size_t i )
+        {
+            m_requests[i].start();
+            if ( m_requests[i].m_progress ) ++ m_nb_pending;
+            else if ( m_callbacks[i] ) m_callbacks[i](m_requests[i].m_status);
+        }
+        void startAll()
+        {
+            for ( std::size_t i = 0; i < m_requests.size(); ++i ) start(i);
+        }
+        void waitAll()
+        {
+            Tracer::Scope trace("waitAll");
+            while ( m_nb_pending > 0 ) waitSome();
+        }
+        int waitAny()
+        {
+            Tracer::Scope trace("waitAny");
+            while ( m_nb_pending > 0 ) {
+                for ( std::size_t i = 0; i < m_requests.size(); ++i )
+                    if ( progress(i) ) return int(i);
+                std::this_thread::yield();
+            }
+            return undefined;
+        }
+        const std::vector<int>& waitSome()
+        {
+            Tracer::Scope trace("waitSome");
+            some();
+            while ( m_indices.empty() && (m_nb_pending > 0) ) {
+                std::this_thread::yield();
+                some();
+            }
+            return m_indices;
+        }
+        bool testAll() { some(); return ( m_nb_pending == 0 ); }
+        Status status( std::size_t i ) const { return m_requests[i].m_status; }
+    private:
+        // Return true if the i-th request was pending and is now completed
+        bool progress( std::size_t i )
+        {
+            if ( !m_requests[i].m_progress || !m_requests[i].test() ) return false;
+            -- m_nb_pending;
+            if ( m_callbacks[i] ) m_callbacks[i](m_requests[i].m_status);
+            return true;
+        }
+        void some()
+        {
+            m_indices.clear();
+            for ( std::size_t i = 0; i < m_requests.size(); ++i )
+                if ( progress(i) ) m_indices.push_back(int(i));
+        }
+        std::vector<Callback> m_callbacks;
+        std::vector<Request> m_requests;
+        std::vector<int> m_indices;
+        std::size_t m_nb_pending = 0;
+    };
+}
 // TO DO
 # endif
 #endif
@@ -0,0 +1,158 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    SharedArray.hpp
+ *    \brief   Array shared by the processes of a same node
+ */
+#ifndef _PARALLEL_SHAREDARRAY_HPP_
+# define _PARALLEL_SHAREDARRAY_HPP_
+# include <cassert>
+# include <cstddef>
+# include "Parallel/Communicator"
+# if defined(USE_MPI)
+#   include <mpi.h>
+# else
+#   include <atomic>
+#   include <memory>
+# endif
+
+namespace Parallel
+{
+    /*!   \class SharedArray
+     *    \brief Array stored once per node and shared by all the processes of the node
+     *
+     *    The array is allocated by the first process of each node ( the owner )
+     *    in a shared memory window ( MPI_Win_allocate_shared ) and the other
+     *    processes of the node map the same memory : there is no copy and the
+     *    memory used by the node doesn't depend on the number of processes.
+     *
+     *    The owner fills the array ( or the processes fill distinct parts ), then
+     *    all the processes of the node call fence() before reading it :
+     *    \code
+     *    Parallel::SharedArray<double> coords(com, nbNodes*3);
+     *    if ( coords.isOwner() ) read_coordinates(coords.data());
+     *    coords.fence();
+     *    \endcode
+     *
+     *    The construction and the destruction are collective calls on the
+     *    communicator. The objects must be trivially copyable.
+     */
+    template<typename K> class SharedArray
+    {
+    public:
+        typedef K value_type;
+        typedef K* iterator;
+        typedef const K* const_iterator;
+        /*!
+         *   \brief Allocate an array of nbItems objects on each node ( collective call )
+         *
+         *   \param com     The processes sharing the arrays ( split by node )
+         *   \param nbItems The number of objects in the array
+         */
+        SharedArray( const Communicator& com, std::size_t nbItems );
+        SharedArray( const SharedArray& ) = delete;
+        /*!
+         *   \brief Free the array ( collective call )
+         */
+        ~SharedArray();
+        SharedArray& operator = ( const SharedArray& ) = delete;
+        /*!
+         *   \brief Return true for the process owning the array of its node
+         */
+        bool isOwner() const { return m_node.rank == 0; }
+        /*!
+         *   \brief The processes of the node sharing the array
+         */
+        const Communicator& nodeCommunicator() const { return m_node; }
+        /*!
+         *   \brief Synchronize the processes of the node : the modifications done by a
+         *          process before the fence are seen by the others after the fence
+         *          ( collective call on the node )
+         */
+        void fence() const;
+
+        std::size_t size() const { return m_size; }
+        K* data() { return m_data; }
+        const K* data() const { return m_data; }
+        K& operator [] ( std::size_t i ) { assert(i < m_size); return m_data[i]; }
+        const K& operator [] ( std::size_t i ) const { assert(i < m_size); return m_data[i]; }
+        iterator begin() { return m_data; }
+        iterator end  () { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end  () const { return m_data + m_size; }
+    private:
+        Communicator m_node;
+        std::size_t  m_size;
+        K*           m_data;
+# if defined(USE_MPI)
+        MPI_Win      m_window;
+# else
+        std::shared_ptr<K> m_storage;
+# endif
+    };
+    // =================================================================
+# if defined(USE_MPI)
+    template<typename K>
+    SharedArray<K>::SharedArray( const Communicator& com, std::size_t nbItems ) :
+        m_node(com, Communicator::shared_memory), m_size(nbItems), m_data(nullptr)
+    {
+        MPI_Aint size = ( isOwner() ? MPI_Aint(nbItems*sizeof(K)) : 0 );
+        K* local;
+        MPI_Win_allocate_shared( size, int(sizeof(K)), MPI_INFO_NULL,
+                                 m_node.m_impl->communicator(), &local, &m_window );
+        // Address of the array of the owner in the address space of the current process :
+        int dispUnit;
+        MPI_Win_shared_query( m_window, 0, &size, &dispUnit, &m_data );
+        // Passive access during all the life of the array, the fences synchronize the memory
+        MPI_Win_lock_all( MPI_MODE_NOCHECK, m_window );
+    }
+    // .................................................................
+    template<typename K> SharedArray<K>::~SharedArray()
+    {
+        MPI_Win_unlock_all( m_window );
+        MPI_Win_free( &m_window );
+    }
+    // .................................................................
+    template<typename K> void SharedArray<K>::fence() const
+    {
+        MPI_Win_sync( m_window );
+        m_node.barrier();
+        MPI_Win_sync( m_window );
+    }
+# else
+    // Without MPI, the processes are threads of the same process : the owner
+    // allocates the array and gives its address to the others.
+    template<typename K>
+    SharedArray<K>::SharedArray( const Communicator& com, std::size_t nbItems ) :
+        m_node(com, Communicator::shared_memory), m_size(nbItems), m_data(nullptr)
+    {
+        if ( isOwner() ) m_storage = std::shared_ptr<K>( new K[nbItems], std::default_delete<K[]>() );
+        m_node.bcast( m_storage, 0 );
+        m_data = m_storage.get();
+    }
+    // .................................................................
+    template<typename K> SharedArray<K>::~SharedArray()
+    {
+        m_node.barrier();
+    }
+    // .................................................................
+    template<typename K> void SharedArray<K>::fence() const
+    {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        m_node.barrier();
+    }
+# endif
+}
+
+#endif
@@ -17,6 +17,7 @@
 # ifdef USE_MPI
 # include <mpi.h>
 # endif
+# include <cstddef>
 # include "Parallel/Constantes.hpp"
 namespace Parallel
 {
@@ -47,7 +48,7 @@ namespace Parallel
         /*!
          *    \brief Return the number of objects contained in the incoming message
          */
-        template<typename K> int count() const { return m_count; }
+        template<typename K> int count() const { return int(m_count/sizeof(K)); }
         /*!
          *    \brief Return the identity tag of the incoming message
          */
@@ -55,13 +56,15 @@ namespace Parallel
         /*!
          *    \brief Return the rank of the sender of the incoming message
          */
-        int source   () const { return 0; }
+        int source   () const { return m_source; }
         /*!
          *    \brief Return the error state of the incoming message.
          */
         int error    () const { return m_error; }
         /// \privatesection
-        int m_count, m_tag,m_error;
+        std::size_t m_count; /*!< Size of the message in bytes */
+        int m_tag,m_error;
+        int m_source;       /*!< Rank of the sender */
     };
 # endif
 }
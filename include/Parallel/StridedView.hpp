@@ -0,0 +1,76 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Vue sur des blocs d'objets régulièrement espacés dans un buffer
+#ifndef _PARALLEL_STRIDEDVIEW_HPP_
+# define _PARALLEL_STRIDEDVIEW_HPP_
+# include <cassert>
+# include <cstddef>
+
+namespace Parallel
+{
+    /*!   \class StridedView
+     *    \brief View on regularly spaced blocks of objects stored in a buffer
+     *
+     *    The view describes nbBlocks blocks of blockLength objects, the beginning of
+     *    two consecutive blocks being separated by stride objects ( a row of a matrix
+     *    stored by columns by example ). A view is exchanged by the communicator
+     *    without copy, the parallel library gathering or scattering the blocks
+     *    itself ( with a MPI vector datatype ). The view doesn't own the data : the
+     *    buffer must stay alive while the view is used.
+     *
+     *    Use StridedView<const K> to send data from a constant buffer.
+     */
+    template<typename K> class StridedView
+    {
+    public:
+        typedef K value_type;
+        /*!
+         *   \brief Build a view on a buffer
+         *
+         *   \param first       Address of the first object of the first block
+         *   \param nbBlocks    Number of blocks
+         *   \param stride      Number of objects between the beginning of two consecutive blocks
+         *   \param blockLength Number of objects per block
+         */
+        StridedView( K* first, std::size_t nbBlocks, std::size_t stride, std::size_t blockLength = 1 ) :
+            m_first(first), m_nbBlocks(nbBlocks), m_stride(stride), m_blockLength(blockLength)
+        {
+            assert(blockLength <= stride);
+        }
+        /*!
+         *   \brief Address of the first object of the view
+         */
+        K* data() const { return m_first; }
+        /*!
+         *   \brief Number of objects in the view
+         */
+        std::size_t size() const { return m_nbBlocks*m_blockLength; }
+        std::size_t nbBlocks   () const { return m_nbBlocks; }
+        std::size_t stride     () const { return m_stride; }
+        std::size_t blockLength() const { return m_blockLength; }
+        /*!
+         *   \brief Access to the i-th object of the view
+         */
+        K& operator [] ( std::size_t i ) const
+        {
+            assert(i < size());
+            return m_first[(i/m_blockLength)*m_stride + i%m_blockLength];
+        }
+    private:
+        K* m_first;
+        std::size_t m_nbBlocks, m_stride, m_blockLength;
+    };
+}
+
+#endif
@@ -0,0 +1,119 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    ThreadGroup.hpp
+ *    \brief   Shared memory backend used without MPI : the processes are
+ *             simulated by threads.
+ */
+#ifndef _PARALLEL_THREADGROUP_HPP_
+# define _PARALLEL_THREADGROUP_HPP_
+# include <atomic>
+# include <functional>
+# include <list>
+# include <memory>
+# include <vector>
+
+namespace Parallel
+{
+    /*!   \class ThreadGroup
+     *    \brief Group of threads simulating the processes of a communicator
+     *
+     *    Each thread of the group has a rank and a mailbox. The messages are
+     *    pushed in the mailbox of the destination without lock ( a lock free
+     *    stack drained by the receiver, which is the only one to read its
+     *    mailbox ). The collective operations exchange the addresses of the
+     *    buffers of each rank through a board of slots synchronized by a
+     *    dissemination barrier, so the data are copied only once, directly
+     *    from the buffer of a thread to the buffer of another one.
+     */
+    class ThreadGroup
+    {
+    public:
+        /*!
+         *   \brief Message sended to a thread ( the data are copied in the message )
+         */
+        struct Message
+        {
+            int source, tag;
+            std::vector<char> data;
+            Message* next;
+        };
+
+        explicit ThreadGroup( int size );
+        ThreadGroup( const ThreadGroup& ) = delete;
+        ~ThreadGroup();
+        ThreadGroup& operator = ( const ThreadGroup& ) = delete;
+
+        int size() const { return m_size; }
+        // .............................................................
+        /*!
+         *   \brief Push a message in the mailbox of the thread dest ( never blocks )
+         */
+        void post( int dest, std::unique_ptr<Message>&& msg );
+        /*!
+         *   \brief Take the first message matching source and tag in the mailbox of rank
+         *
+         *   Return a null pointer if no message matches. any_source and any_tag
+         *   are accepted. Only the thread of rank can call this method.
+         */
+        std::unique_ptr<Message> take( int rank, int source, int tag );
+        /*!
+         *   \brief Same as take but the message stays in the mailbox
+         */
+        const Message* peek( int rank, int source, int tag );
+        // .............................................................
+        /*!
+         *   \brief Dissemination barrier ( log2(size) rounds )
+         */
+        void barrier( int rank );
+        /*!
+         *   \brief Publish the address of a local slot, readable by the other threads
+         *          between the next barrier and the following one.
+         */
+        void publish( int rank, void* slot ) { m_slots[rank] = slot; }
+        template<typename S> S& slot( int rank ) const { return *static_cast<S*>(m_slots[rank]); }
+        // .............................................................
+        /*!
+         *   \brief Group of all the threads simulating the processes
+         *
+         *   For a thread not launched by launch, a world with only one thread is created.
+         */
+        static std::shared_ptr<ThreadGroup> world();
+        /*!
+         *   \brief Rank of the current thread in the world
+         */
+        static int worldRank();
+        /*!
+         *   \brief Run fct(rank) on nbThreads threads ( the calling thread is the rank 0 )
+         *
+         *   \return The value returned by the rank 0
+         */
+        static int launch( int nbThreads, const std::function<int(int)>& fct );
+    private:
+        struct Mailbox
+        {
+            std::atomic<Message*> incoming;
+            std::list<std::unique_ptr<Message>> pending;
+        };
+        std::list<std::unique_ptr<Message>>::iterator find( int rank, int source, int tag );
+
+        int m_size;
+        std::vector<Mailbox> m_mailboxes;
+        std::vector<std::atomic<unsigned>> m_flags;
+        std::vector<unsigned> m_episodes;
+        std::vector<void*> m_slots;
+    };
+}
+
+#endif
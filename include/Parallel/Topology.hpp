@@ -0,0 +1,143 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    Topology.hpp
+ *    \brief   Communicators with a Cartesian or a graph topology
+ */
+#ifndef _PARALLEL_TOPOLOGY_HPP_
+# define _PARALLEL_TOPOLOGY_HPP_
+# include <utility>
+# include <vector>
+# include "Parallel/Communicator"
+
+namespace Parallel
+{
+    /*!   \class CartesianCommunicator
+     *    \brief Communicator whose processes are placed on a grid
+     *
+     *    The processes are placed on a grid of dimensions dims, periodic or not in
+     *    each direction. The ranks are ordered by coordinates, the last dimension
+     *    varying first. With reorder, the library can renumber the processes to
+     *    map the grid on the physical network.
+     *
+     *    \code
+     *    Parallel::CartesianCommunicator grid(com, {0, 0}, {true, true}, true);
+     *    Parallel::CartesianCommunicator rows(grid, {false, true});
+     *    std::pair<int,int> neighbors = grid.shift(0); // Upper and lower processes
+     *    \endcode
+     *
+     *    The neighbors of a process for the neighborhood collective operations are,
+     *    for each dimension, the process in the negative direction then the process
+     *    in the positive direction.
+     */
+    class CartesianCommunicator : public Communicator
+    {
+    public:
+        /*!
+         *   \brief Create a Cartesian topology with the processes of com ( collective call )
+         *
+         *   \param com     The communicator giving the processes
+         *   \param dims    Number of processes in each dimension. A null dimension is computed
+         *                  to have a grid as balanced as possible ( see dimensions ). The product
+         *                  of the dimensions must be the size of com.
+         *   \param periods For each dimension, true if the grid is periodic in this direction
+         *   \param reorder True to let the library renumber the processes
+         */
+        CartesianCommunicator( const Communicator& com, const std::vector<int>& dims,
+                               const std::vector<bool>& periods, bool reorder = false );
+        /*!
+         *   \brief Split a Cartesian communicator in sub-grids ( collective call )
+         *
+         *   \param cart       The Cartesian communicator to split
+         *   \param remainDims For each dimension, true if the dimension is kept in the
+         *                     sub-grids. For example, {false, true} gives the rows of a 2D grid.
+         */
+        CartesianCommunicator( const CartesianCommunicator& cart, const std::vector<bool>& remainDims );
+        /*!
+         *   \brief Share a Cartesian communicator with its topology ( see Communicator )
+         */
+        CartesianCommunicator( const CartesianCommunicator& cart ) = default;
+
+        int nbDimensions() const;
+        /*!
+         *   \brief Number of processes in each dimension
+         */
+        std::vector<int> dimensions() const;
+        /*!
+         *   \brief Periodicity of each dimension
+         */
+        std::vector<bool> periods() const;
+        /*!
+         *   \brief Coordinates of the current process
+         */
+        std::vector<int> coordinates() const;
+        /*!
+         *   \brief Coordinates of the process of rank rank
+         */
+        std::vector<int> coordinates( int rank ) const;
+        /*!
+         *   \brief Rank of the process with the coordinates coords
+         *
+         *   The coordinates are taken modulo the dimension in the periodic directions.
+         */
+        int rankOf( const std::vector<int>& coords ) const;
+        /*!
+         *   \brief Neighbors of the current process in a direction
+         *
+         *   \param direction    The dimension of the shift
+         *   \param displacement The shift ( > 0 : toward the upper coordinates )
+         *   \return             The pair ( source, destination ) : the process at the coordinate
+         *                       minus displacement and the process at the coordinate plus
+         *                       displacement. On the boundaries of a non periodic dimension,
+         *                       the missing neighbor is no_process.
+         */
+        std::pair<int,int> shift( int direction, int displacement = 1 ) const;
+        /*!
+         *   \brief Balanced dimensions of a grid of nbProcs processes
+         *
+         *   \param nbProcs The number of processes of the grid
+         *   \param dims    The dimensions. The null dimensions are computed ( in decreasing
+         *                  order ), the other dimensions are kept.
+         */
+        static std::vector<int> dimensions( int nbProcs, const std::vector<int>& dims );
+    };
+    // =================================================================
+    /*!   \class GraphCommunicator
+     *    \brief Communicator whose processes are the vertices of a directed graph
+     *
+     *    Each process gives its neighbors : the processes sending data to it ( sources )
+     *    and the processes receiving its data ( destinations ). The neighborhood
+     *    collective operations exchange data along the edges of the graph.
+     */
+    class GraphCommunicator : public Communicator
+    {
+    public:
+        /*!
+         *   \brief Create a distributed graph topology with the processes of com ( collective call )
+         *
+         *   \param com          The communicator giving the processes
+         *   \param sources      Ranks ( in com ) of the processes sending data to the current process
+         *   \param destinations Ranks ( in com ) of the processes receiving data from the current process
+         *   \param reorder      True to let the library renumber the processes
+         */
+        GraphCommunicator( const Communicator& com, const std::vector<int>& sources,
+                           const std::vector<int>& destinations, bool reorder = false );
+        /*!
+         *   \brief Share a graph communicator with its topology ( see Communicator )
+         */
+        GraphCommunicator( const GraphCommunicator& graph ) = default;
+    };
+}
+
+#endif
@@ -0,0 +1,180 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    Trace.hpp
+ *    \brief   Timeline of the communications and of the timed regions ( Chrome trace format )
+ */
+#ifndef _PARALLEL_TRACE_HPP_
+# define _PARALLEL_TRACE_HPP_
+# include <atomic>
+# include <chrono>
+# include <cstdint>
+# include <memory>
+# include <mutex>
+# include <ostream>
+# include <string>
+# include <vector>
+# ifdef USE_MPI
+# include <mpi.h>
+# endif
+# include "Parallel/Constantes.hpp"
+
+namespace Parallel
+{
+    /*!   \class Tracer
+     *    \brief Begin and end events of the communications and of the regions of the current process
+     *
+     *    When the tracer is enabled, the communication methods of Communicator, the
+     *    waits of the requests and the regions timed by TimeRegion record an event at
+     *    their beginning and at their end. Each thread records its events in its own
+     *    buffer without lock. At the destruction of the context, the events are written
+     *    in the Chrome trace event format ( JSON ), which can be opened by Perfetto
+     *    ( ui.perfetto.dev ) or chrome://tracing : each process writes the file
+     *    Trace<rank>.json or, with the merged layout, the process 0 writes all the
+     *    processes in Trace.json. The clocks of the processes are aligned on a
+     *    barrier done at the end of the trace.
+     *
+     *    The tracer is enabled by the environment variable PARALLEL_TRACE ( "merged"
+     *    for one file, any other value for one file by process ) or by enable(), on
+     *    all the processes.
+     *
+     *    Without MPI, each simulated process has its own tracer.
+     */
+    class Tracer
+    {
+    public:
+        enum layout_type { per_process, merged };
+        typedef std::chrono::steady_clock clock;
+
+        struct Event
+        {
+            const char*   name;  // Literal or interned string
+            std::int64_t  time;  // Nanoseconds since the creation of the tracer
+            char          phase; // 'B' ( begin ) or 'E' ( end )
+            int           peer;  // World rank of the other process or no_process
+            std::uint64_t bytes;
+        };
+        // .............................................................
+        /*!   \class Scope
+         *    \brief Trace the region name until the destruction of the scope ( nothing if
+         *           the tracer is disabled )
+         *
+         *    The name must live until the trace is written ( a string literal or a string
+         *    returned by intern() ).
+         */
+        class Scope
+        {
+        public:
+            explicit Scope( const char* name ) :
+                m_tracer( current().isEnabled() ? &current() : nullptr ), m_name(name)
+            {
+                if ( m_tracer != nullptr ) m_tracer->begin(m_name);
+            }
+            Scope( const Scope& ) = delete;
+            ~Scope() { if ( m_tracer != nullptr ) m_tracer->end(m_name); }
+            Scope& operator = ( const Scope& ) = delete;
+        private:
+            Tracer*     m_tracer;
+            const char* m_name;
+        };
+        // .............................................................
+        /*!
+         *   \brief The tracer of the current process
+         */
+        static Tracer& current();
+        /*!
+         *   \brief Copy of name living until the end of the program ( same address for the same name )
+         */
+        static const char* intern( const std::string& name );
+
+        Tracer( const Tracer& ) = delete;
+        Tracer& operator = ( const Tracer& ) = delete;
+        /*!
+         *   \brief Start to record the events
+         *
+         *   \param layout   One file by process or one file for all the processes
+         *   \param fileBase Beginning of the names of the files
+         */
+        void enable( layout_type layout = per_process, const std::string& fileBase = "Trace" );
+        void disable() { m_enabled = false; }
+        bool isEnabled() const { return m_enabled; }
+        /*!
+         *   \brief Record the beginning of name by the calling thread
+         */
+        void begin( const char* name )
+        {
+            buffer().push_back( Event{ name, now(), 'B', no_process, 0 } );
+        }
+        /*!
+         *   \brief Record the end of name by the calling thread
+         *
+         *   \param peer  World rank of the other process of a communication ( or no_process )
+         *   \param bytes Size of the data of a communication
+         */
+        void end( const char* name, int peer = no_process, std::size_t bytes = 0 )
+        {
+            buffer().push_back( Event{ name, now(), 'E', peer, bytes } );
+        }
+        /*!
+         *   \brief Forget the recorded events ( no thread must record events meanwhile )
+         */
+        void clear();
+        /*!
+         *   \brief Number of events recorded by all the threads of the process
+         */
+        std::size_t size() const;
+        /*!
+         *   \brief Write the events as Chrome trace events, separated by commas
+         *
+         *   \param pid   Identifier of the process in the trace
+         *   \param shift Nanoseconds added to the times of the events
+         */
+        void write( std::ostream& out, int pid, std::int64_t shift = 0 ) const;
+        /*!
+         *   \brief Write the files of the trace ( collective call on world )
+         *
+         *   The tracer is disabled. Nothing is done if no process enabled its tracer.
+         */
+        void report();
+    private:
+        typedef std::vector<Event> Buffer;
+
+        Tracer();
+        std::int64_t now() const
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - m_origin).count();
+        }
+        // Buffer of the calling thread, created at its first event :
+        Buffer& buffer()
+        {
+            thread_local Tracer* owner  = nullptr;
+            thread_local Buffer* events = nullptr;
+            if ( owner != this ) {
+                events = &addBuffer();
+                owner  = this;
+            }
+            return *events;
+        }
+        Buffer& addBuffer();
+
+        std::atomic<bool>  m_enabled;
+        layout_type        m_layout;
+        std::string        m_fileBase;
+        clock::time_point  m_origin;
+        std::vector<std::unique_ptr<Buffer>> m_buffers; // One buffer by thread
+        mutable std::mutex m_mutex; // Protects m_buffers when a thread records its first event
+    };
+}
+
+#endif
@@ -0,0 +1,450 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+/**
+ *    \file    Window.hpp
+ *    \brief   One-sided communications ( remote memory access )
+ */
+#ifndef _PARALLEL_WINDOW_HPP_
+# define _PARALLEL_WINDOW_HPP_
+# include <cassert>
+# include <cstddef>
+# include <type_traits>
+# include "Parallel/Communicator"
+# include "Parallel/DetectContainer.hpp"
+# if defined(USE_MPI)
+#   include <mpi.h>
+# else
+#   include <algorithm>
+#   include <atomic>
+#   include <memory>
+#   include <mutex>
+#   include <shared_mutex>
+#   include <vector>
+# endif
+
+namespace Parallel
+{
+    /*!   \class Window
+     *    \brief Memory of each process exposed to the remote accesses of the other processes
+     *
+     *    Each process of the communicator exposes an array of objects ( allocated by
+     *    the window or given by the user ). The other processes read ( get ), write
+     *    ( put ) or update ( accumulate, fetch_and_op, compare_and_swap ) this array
+     *    without any matching call of its owner. The displacements are given in
+     *    number of objects from the beginning of the array of the target.
+     *
+     *    The accesses must be enclosed by a synchronization :
+     *      - active target : all the processes call fence() before and after the accesses;
+     *      - passive target : the origin locks the target ( lock/unlock or lock_all/unlock_all )
+     *        and can complete the pending accesses with flush/flush_all.
+     *    fetch_and_op and compare_and_swap return the value read : they are only allowed in a
+     *    passive epoch on the target.
+     *
+     *    \code
+     *    Parallel::Window<long> counter(com, 1);
+     *    counter.lock(0);
+     *    long ticket = counter.fetch_and_op(1L, 0, 0, Parallel::sum);
+     *    counter.unlock(0);
+     *    \endcode
+     *
+     *    The construction and the destruction are collective calls. The objects
+     *    must be trivially copyable and the operations of accumulate, fetch_and_op
+     *    and compare_and_swap are the predefined operations on builtin types.
+     */
+    template<typename K> class Window
+    {
+    public:
+        typedef K value_type;
+        typedef K* iterator;
+        typedef const K* const_iterator;
+        /*!
+         *   \brief Allocate an exposed array of nbItems objects on each process ( collective call )
+         */
+        Window( const Communicator& com, std::size_t nbItems );
+        /*!
+         *   \brief Expose an existing buffer of nbItems objects ( collective call )
+         *
+         *   The buffer must stay alive while the window exists.
+         */
+        Window( const Communicator& com, std::size_t nbItems, K* buffer );
+        Window( const Window& ) = delete;
+        /*!
+         *   \brief Free the window ( collective call ). A buffer given by the user isn't freed
+         */
+        ~Window();
+        Window& operator = ( const Window& ) = delete;
+
+        /*! \name Local part of the window
+         */
+        //@{
+        std::size_t size() const { return m_size; }
+        K* data() { return m_data; }
+        const K* data() const { return m_data; }
+        K& operator [] ( std::size_t i ) { assert(i < m_size); return m_data[i]; }
+        const K& operator [] ( std::size_t i ) const { assert(i < m_size); return m_data[i]; }
+        iterator begin() { return m_data; }
+        iterator end  () { return m_data + m_size; }
+        const_iterator begin() const { return m_data; }
+        const_iterator end  () const { return m_data + m_size; }
+        //@}
+
+        /*! \name Synchronizations
+         */
+        //@{
+        /*!
+         *   \brief Close the current access epoch and open a new one ( collective call )
+         */
+        void fence() const;
+        /*!
+         *   \brief Start a passive access epoch on target
+         *
+         *   \param target    Rank of the target process
+         *   \param exclusive If true, no other process accesses target until unlock
+         */
+        void lock( int target, bool exclusive = false ) const;
+        /*!
+         *   \brief Complete the accesses to target and end the passive access epoch
+         */
+        void unlock( int target ) const;
+        /*!
+         *   \brief Start a shared passive access epoch on all the processes
+         */
+        void lock_all() const;
+        void unlock_all() const;
+        /*!
+         *   \brief Complete the pending accesses to target inside a passive epoch
+         */
+        void flush( int target ) const;
+        void flush_all() const;
+        //@}
+
+        /*! \name Remote accesses
+         */
+        //@{
+        /*!
+         *   \brief Write an object in the array of target at displacement disp
+         */
+        void put( const K& obj, int target, std::size_t disp ) const
+        { put( 1, &obj, target, disp ); }
+        /*!
+         *   \brief Write a buffer of objects in the array of target from displacement disp
+         */
+        void put( std::size_t nbItems, const K* buff, int target, std::size_t disp ) const;
+        /*!
+         *   \brief Write the objects of a contiguous container ( std::vector, std::array, ... )
+         */
+        template<typename C, typename = typename std::enable_if<is_contiguous_container<C>::value>::type>
+        void put( const C& container, int target, std::size_t disp ) const
+        { put( container.size(), container.data(), target, disp ); }
+        /*!
+         *   \brief Read an object of the array of target at displacement disp
+         *
+         *   The object is available after the end of the epoch ( or a flush ).
+         */
+        void get( K& obj, int target, std::size_t disp ) const
+        { get( 1, &obj, target, disp ); }
+        /*!
+         *   \brief Read nbItems objects of the array of target from displacement disp
+         */
+        void get( std::size_t nbItems, K* buff, int target, std::size_t disp ) const;
+        /*!
+         *   \brief Read as many objects as the size of the contiguous container
+         */
+        template<typename C, typename = typename std::enable_if<is_contiguous_container<C>::value>::type>
+        void get( C& container, int target, std::size_t disp ) const
+        { get( container.size(), container.data(), target, disp ); }
+        /*!
+         *   \brief Combine atomically an object with the object of target at displacement disp
+         *
+         *   \param op The operation ( Parallel::sum, Parallel::max, ..., Parallel::replace )
+         */
+        void accumulate( const K& obj, int target, std::size_t disp, Operation op = sum ) const
+        { accumulate( 1, &obj, target, disp, op ); }
+        /*!
+         *   \brief Combine atomically ( element by element ) a buffer with the array of target
+         *
+         *   The type of the buffer is deduced ( as for send ) so a target of rank 0 isn't
+         *   taken for a null buffer by accumulate( obj, 0, disp, op ).
+         */
+        template<typename T, typename = typename std::enable_if<std::is_same<T,K>::value>::type>
+        void accumulate( std::size_t nbItems, const T* buff, int target, std::size_t disp,
+                         Operation op = sum ) const;
+        /*!
+         *   \brief Combine atomically the objects of a contiguous container with the array of target
+         */
+        template<typename C, typename = typename std::enable_if<is_contiguous_container<C>::value>::type>
+        void accumulate( const C& container, int target, std::size_t disp, Operation op = sum ) const
+        { accumulate( container.size(), container.data(), target, disp, op ); }
+        /*!
+         *   \brief Combine atomically value with the object of target and return its previous value
+         *
+         *   With Parallel::no_op, the object is read atomically. Blocking call : the
+         *   operation is completed at the return of the method ( MPI_Win_flush_local ), so
+         *   target must be locked by lock or lock_all. Between two fences, use accumulate
+         *   and get instead.
+         */
+        K fetch_and_op( const K& value, int target, std::size_t disp, Operation op = sum ) const;
+        /*!
+         *   \brief Replace atomically the object of target by value if it equals compare
+         *
+         *   \return The previous value of the object of target ( blocking call )
+         *
+         *   As fetch_and_op, only allowed when target is locked by lock or lock_all.
+         */
+        K compare_and_swap( const K& value, const K& compare, int target, std::size_t disp ) const;
+        //@}
+    private:
+        std::size_t m_size;
+        K*          m_data;
+# if defined(USE_MPI)
+        MPI_Win     m_window;
+# else
+        // Locks of the processes, shared by all the processes of the window
+        struct Locks
+        {
+            Locks( int size ) : targets(size) {}
+            std::vector<std::shared_timed_mutex> targets;
+            std::mutex atomic;
+        };
+        void share( const Communicator& com );
+        K* address( int target, std::size_t disp ) const { return m_bases[target] + disp; }
+
+        Communicator             m_com;
+        std::vector<K*>          m_bases;
+        std::unique_ptr<K[]>     m_storage;
+        std::shared_ptr<Locks>   m_locks;
+        mutable std::vector<int> m_lock_mode;  // 0 : unlocked, 1 : shared, 2 : exclusive
+# endif
+    };
+    // =================================================================
+# if defined(USE_MPI)
+    template<typename K>
+    Window<K>::Window( const Communicator& com, std::size_t nbItems ) :
+        m_size(nbItems), m_data(nullptr)
+    {
+        MPI_Win_allocate( MPI_Aint(nbItems*sizeof(K)), int(sizeof(K)), MPI_INFO_NULL,
+                          com.m_impl->communicator(), &m_data, &m_window );
+    }
+    // .................................................................
+    template<typename K>
+    Window<K>::Window( const Communicator& com, std::size_t nbItems, K* buffer ) :
+        m_size(nbItems), m_data(buffer)
+    {
+        MPI_Win_create( buffer, MPI_Aint(nbItems*sizeof(K)), int(sizeof(K)), MPI_INFO_NULL,
+                        com.m_impl->communicator(), &m_window );
+    }
+    // .................................................................
+    template<typename K> Window<K>::~Window()
+    {
+        MPI_Win_free( &m_window );
+    }
+    // -----------------------------------------------------------------
+    template<typename K> void Window<K>::fence() const
+    {
+        MPI_Win_fence( 0, m_window );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::lock( int target, bool exclusive ) const
+    {
+        MPI_Win_lock( (exclusive ? MPI_LOCK_EXCLUSIVE : MPI_LOCK_SHARED), target, 0, m_window );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::unlock( int target ) const
+    {
+        MPI_Win_unlock( target, m_window );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::lock_all() const
+    {
+        MPI_Win_lock_all( 0, m_window );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::unlock_all() const
+    {
+        MPI_Win_unlock_all( m_window );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::flush( int target ) const
+    {
+        MPI_Win_flush( target, m_window );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::flush_all() const
+    {
+        MPI_Win_flush_all( m_window );
+    }
+    // -----------------------------------------------------------------
+    // The displacement unit of the window is sizeof(K), the counts are given in
+    // datatype elements ( bytes for the packed types )
+    template<typename K>
+    void Window<K>::put( std::size_t nbItems, const K* buff, int target, std::size_t disp ) const
+    {
+        const int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Put( buff, count, mpi_data_type<K>(), target, MPI_Aint(disp),
+                 count, mpi_data_type<K>(), m_window );
+    }
+    // .................................................................
+    template<typename K>
+    void Window<K>::get( std::size_t nbItems, K* buff, int target, std::size_t disp ) const
+    {
+        const int count = int(nbItems)*mpi_item_size<K>();
+        MPI_Get( buff, count, mpi_data_type<K>(), target, MPI_Aint(disp),
+                 count, mpi_data_type<K>(), m_window );
+    }
+    // .................................................................
+    template<typename K> template<typename T, typename>
+    void Window<K>::accumulate( std::size_t nbItems, const T* buff, int target, std::size_t disp,
+                                Operation op ) const
+    {
+        MPI_Accumulate( buff, int(nbItems), Type_MPI<K>::mpi_type(), target, MPI_Aint(disp),
+                        int(nbItems), Type_MPI<K>::mpi_type(), op, m_window );
+    }
+    // .................................................................
+    template<typename K>
+    K Window<K>::fetch_and_op( const K& value, int target, std::size_t disp, Operation op ) const
+    {
+        K result;
+        MPI_Fetch_and_op( &value, &result, Type_MPI<K>::mpi_type(), target, MPI_Aint(disp),
+                          op, m_window );
+        // Only valid in a passive epoch on target
+        MPI_Win_flush_local( target, m_window );
+        return result;
+    }
+    // .................................................................
+    template<typename K>
+    K Window<K>::compare_and_swap( const K& value, const K& compare, int target, std::size_t disp ) const
+    {
+        K result;
+        MPI_Compare_and_swap( &value, &compare, &result, Type_MPI<K>::mpi_type(), target,
+                              MPI_Aint(disp), m_window );
+        MPI_Win_flush_local( target, m_window );
+        return result;
+    }
+# else
+    // Without MPI, the processes are threads of the same process : the remote
+    // accesses are done directly in the memory of the target and are completed
+    // at the return of the methods. The atomic operations are serialized by a
+    // mutex shared by all the processes of the window.
+    template<typename K>
+    Window<K>::Window( const Communicator& com, std::size_t nbItems ) :
+        m_size(nbItems), m_data(nullptr), m_com(com), m_storage(new K[nbItems])
+    {
+        m_data = m_storage.get();
+        share( com );
+    }
+    // .................................................................
+    template<typename K>
+    Window<K>::Window( const Communicator& com, std::size_t nbItems, K* buffer ) :
+        m_size(nbItems), m_data(buffer), m_com(com)
+    {
+        share( com );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::share( const Communicator& com )
+    {
+        com.allgather( m_data, m_bases );
+        if ( com.rank == 0 ) m_locks = std::make_shared<Locks>( com.size );
+        com.bcast( m_locks, 0 );
+        m_lock_mode.resize( com.size, 0 );
+    }
+    // .................................................................
+    template<typename K> Window<K>::~Window()
+    {
+        m_com.barrier();
+    }
+    // -----------------------------------------------------------------
+    template<typename K> void Window<K>::fence() const
+    {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        m_com.barrier();
+    }
+    // .................................................................
+    template<typename K> void Window<K>::lock( int target, bool exclusive ) const
+    {
+        if ( exclusive ) m_locks->targets[target].lock();
+        else m_locks->targets[target].lock_shared();
+        m_lock_mode[target] = ( exclusive ? 2 : 1 );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::unlock( int target ) const
+    {
+        if ( m_lock_mode[target] == 2 ) m_locks->targets[target].unlock();
+        else m_locks->targets[target].unlock_shared();
+        m_lock_mode[target] = 0;
+    }
+    // .................................................................
+    template<typename K> void Window<K>::lock_all() const
+    {
+        for ( int target = 0; target < int(m_bases.size()); ++target ) lock( target, false );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::unlock_all() const
+    {
+        for ( int target = 0; target < int(m_bases.size()); ++target ) unlock( target );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::flush( int ) const
+    {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+    }
+    // .................................................................
+    template<typename K> void Window<K>::flush_all() const
+    {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+    }
+    // -----------------------------------------------------------------
+    template<typename K>
+    void Window<K>::put( std::size_t nbItems, const K* buff, int target, std::size_t disp ) const
+    {
+        std::copy_n( buff, nbItems, address( target, disp ) );
+    }
+    // .................................................................
+    template<typename K>
+    void Window<K>::get( std::size_t nbItems, K* buff, int target, std::size_t disp ) const
+    {
+        std::copy_n( address( target, disp ), nbItems, buff );
+    }
+    // .................................................................
+    template<typename K> template<typename T, typename>
+    void Window<K>::accumulate( std::size_t nbItems, const T* buff, int target, std::size_t disp,
+                                Operation op ) const
+    {
+        std::lock_guard<std::mutex> guard( m_locks->atomic );
+        K* items = address( target, disp );
+        for ( std::size_t i = 0; i < nbItems; ++i ) items[i] = apply( op, items[i], buff[i] );
+    }
+    // .................................................................
+    template<typename K>
+    K Window<K>::fetch_and_op( const K& value, int target, std::size_t disp, Operation op ) const
+    {
+        std::lock_guard<std::mutex> guard( m_locks->atomic );
+        K* item = address( target, disp );
+        K result = *item;
+        *item = apply( op, result, value );
+        return result;
+    }
+    // .................................................................
+    template<typename K>
+    K Window<K>::compare_and_swap( const K& value, const K& compare, int target, std::size_t disp ) const
+    {
+        std::lock_guard<std::mutex> guard( m_locks->atomic );
+        K* item = address( target, disp );
+        K result = *item;
+        if ( result == compare ) *item = value;
+        return result;
+    }
+# endif
+}
+
+#endif
@@ -0,0 +1,145 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <algorithm>
+# include <iomanip>
+# include <map>
+# include <numeric>
+# include <sstream>
+# include "Parallel/Chrono.hpp"
+# include "Parallel/Communicator"
+using namespace Parallel;
+
+namespace
+{
+    // Path of a node : the names from the root of the call tree
+    typedef std::vector<std::string> Path;
+
+    Path split( const std::string& path, char separator )
+    {
+        Path names;
+        std::istringstream stream(path);
+        std::string name;
+        while ( std::getline(stream, name, separator) ) names.push_back(name);
+        return names;
+    }
+    // Times of a region on each process
+    struct Statistics
+    {
+        std::size_t calls = 0;
+        std::vector<double> seconds;
+    };
+}
+// =====================================================================
+TimerLog::TimerLog() : m_nodes(1), m_current(0)
+{
+    m_nodes[0] = Node{ nullptr, std::string(), nullptr, -1, {}, 0, clock::duration::zero() };
+}
+// ---------------------------------------------------------------------
+int TimerLog::findOrAddNode( const char* name )
+{
+    for ( int child : m_nodes[m_current].children )
+        if ( m_nodes[child].name == name ) return child;
+    m_nodes.push_back( Node{ name, std::string(name), Tracer::intern(name), m_current, {}, 0, clock::duration::zero() } );
+    const int node = int(m_nodes.size()) - 1;
+    m_nodes[m_current].children.push_back( node );
+    return node;
+}
+// ---------------------------------------------------------------------
+void TimerLog::clear()
+{
+    m_nodes.resize(1);
+    m_nodes[0].children.clear();
+    m_current = 0;
+}
+// ---------------------------------------------------------------------
+int TimerLog::find( const std::string& path ) const
+{
+    int node = 0;
+    for ( const std::string& name : split(path, '/') ) {
+        auto it = std::find_if( m_nodes[node].children.begin(), m_nodes[node].children.end(),
+                                [&] ( int child ) { return m_nodes[child].name == name; } );
+        if ( it == m_nodes[node].children.end() ) return -1;
+        node = *it;
+    }
+    return node;
+}
+// ---------------------------------------------------------------------
+double TimerLog::seconds( const std::string& path ) const
+{
+    const int node = find(path);
+    return ( node > 0 ? std::chrono::duration<double>(m_nodes[node].elapsed).count() : 0. );
+}
+// ---------------------------------------------------------------------
+std::size_t TimerLog::calls( const std::string& path ) const
+{
+    const int node = find(path);
+    return ( node > 0 ? m_nodes[node].calls : 0 );
+}
+// ---------------------------------------------------------------------
+std::string TimerLog::report( const Communicator& com, int root ) const
+{
+    int nbRegions = int(m_nodes.size()) - 1, maxRegions;
+    com.allreduce( nbRegions, maxRegions, Parallel::max );
+    if ( maxRegions == 0 ) return std::string();
+    // Each process sends a line "path calls seconds" by region, an empty line ending its regions :
+    std::ostringstream lines;
+    lines << std::setprecision(17);
+    std::vector<std::string> paths(m_nodes.size());
+    for ( std::size_t node = 1; node < m_nodes.size(); ++node ) {
+        const Node& region = m_nodes[node];
+        paths[node] = ( region.parent > 0 ? paths[region.parent] + '/' : std::string() ) + region.name;
+        lines << paths[node] << '\t' << region.calls << '\t'
+              << std::chrono::duration<double>(region.elapsed).count() << '\n';
+    }
+    lines << '\n';
+    std::string all;
+    com.gatherv( lines.str(), all, root );
+    if ( com.rank != root ) return std::string();
+    // The paths are sorted by names from the root : a region is followed by its children
+    std::map<Path, Statistics> regions;
+    std::istringstream stream(all);
+    std::string line;
+    int rank = 0;
+    while ( std::getline(stream, line) ) {
+        if ( line.empty() ) { ++rank; continue; }
+        Path fields = split(line, '\t');
+        Statistics& stats = regions[split(fields[0], '/')];
+        if ( stats.seconds.empty() ) stats.seconds.resize(com.size, 0.);
+        stats.calls += std::stoul(fields[1]);
+        stats.seconds[rank] = std::stod(fields[2]);
+    }
+    std::size_t width = 6;
+    for ( const auto& region : regions )
+        width = std::max( width, 2*(region.first.size()-1) + region.first.back().size() );
+    std::ostringstream table;
+    table << "Timers on " << com.size << " processes ( times in seconds )\n"
+          << std::left << std::setw(width) << "region" << std::right << std::setw(10) << "calls"
+          << std::setw(12) << "min" << std::setw(12) << "mean" << std::setw(12) << "max"
+          << std::setw(9) << "slowest" << std::setw(11) << "imbalance" << '\n';
+    for ( const auto& region : regions ) {
+        const std::vector<double>& seconds = region.second.seconds;
+        auto slowest = std::max_element( seconds.begin(), seconds.end() );
+        const double mean = std::accumulate( seconds.begin(), seconds.end(), 0. )/seconds.size();
+        table << std::left << std::setw(width)
+              << std::string(2*(region.first.size()-1), ' ') + region.first.back()
+              << std::right << std::setw(10) << region.second.calls
+              << std::scientific << std::setprecision(3)
+              << std::setw(12) << *std::min_element( seconds.begin(), seconds.end() )
+              << std::setw(12) << mean << std::setw(12) << *slowest
+              << std::setw(9) << ( slowest - seconds.begin() )
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << ( mean > 0. ? 100.*( *slowest/mean - 1. ) : 0. ) << "%\n";
+    }
+    return table.str();
+}
@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 // Implementation of the Communicator class
+# include <mutex>
 # include "Parallel/Communicator.hpp"
+# include "Parallel/Profiler.hpp"
 # if defined(MPI_VERSION)
 #   include "Parallel/Communicator_mpi.tpp"
 # else
@@ -20,11 +22,41 @@
 # endif
 namespace Parallel
 {
+    namespace
+    {
+        // The global communicator, created at the first call of world() :
+#   if defined(MPI_VERSION)
+        std::unique_ptr<Communicator> world_communicator;
+        std::once_flag world_created;
+#   else
+        // One per thread simulating a process
+        thread_local std::unique_ptr<Communicator> world_communicator;
+#   endif
+    }
+    // .................................................................
+    const Communicator& Communicator::world()
+    {
+#   if defined(MPI_VERSION)
+        std::call_once( world_created, [] () {
+            world_communicator.reset( new Communicator( new Communicator::Implementation ) );
+        } );
+#   else
+        if ( !world_communicator )
+            world_communicator.reset( new Communicator( new Communicator::Implementation ) );
+#   endif
+        return *world_communicator;
+    }
+    // .................................................................
+    void Communicator::releaseWorld()
+    {
+        world_communicator.reset();
+    }
+    // =================================================================
     Communicator::Communicator() : 
-        m_impl( new Communicator::Implementation)
+        m_impl( world().m_impl )
     {
-        rank = m_impl->getRank();
-        size = m_impl->getSize();
+        rank = world().rank;
+        size = world().size;
     }
     // .................................................................
     Communicator::Communicator( const Communicator& com, 
@@ -35,11 +67,11 @@ namespace Parallel
         size = m_impl->getSize();        
     }
     // .................................................................
-    Communicator::Communicator( const Communicator& com ) :
-        m_impl(new Communicator::Implementation(*com.m_impl))
+    Communicator::Communicator( const Communicator& com, split_type type, int key ) :
+        m_impl(new Communicator::Implementation(*com.m_impl,type,key))
     {
         rank = m_impl->getRank();
-        size = m_impl->getSize();        
+        size = m_impl->getSize();
     }
     // .................................................................
     Communicator::Communicator( const Ext_Communicator& excom ) :
@@ -49,13 +81,99 @@ namespace Parallel
         size = m_impl->getSize();        
     }    
     // .................................................................
-    Communicator::~Communicator()
+    Communicator::Communicator( Implementation* impl ) :
+        m_impl(impl)
+    {
+        rank = m_impl->getRank();
+        size = m_impl->getSize();
+    }
+    // .................................................................
+    Communicator::Communicator( Communicator&& com ) :
+        rank(com.rank), size(com.size), m_impl(std::move(com.m_impl))
+    {
+        com.rank = -1;
+        com.size = 0;
+    }
+    // .................................................................
+    Communicator& Communicator::operator = ( Communicator&& com )
+    {
+        if ( this != &com ) {
+            m_impl = std::move(com.m_impl);
+            rank = com.rank;
+            size = com.size;
+            com.rank = -1;
+            com.size = 0;
+        }
+        return *this;
+    }
+    // .................................................................
+    Communicator Communicator::duplicate() const
     {
-        delete m_impl;
+        return Communicator( new Communicator::Implementation(*m_impl) );
+    }
+    // =================================================================
+    int Communicator::worldRank( int rank ) const
+    {
+        return m_impl->worldRank( rank );
+    }
+    // =================================================================
+    void Communicator::setHierarchical( bool hierarchical )
+    {
+        m_impl->setHierarchical( hierarchical );
+    }
+    // .................................................................
+    bool Communicator::isHierarchical() const
+    {
+        return m_impl->isHierarchical();
+    }
+    // =================================================================
+    std::vector<int> Communicator::neighborSources() const
+    {
+        std::vector<int> sources, destinations;
+        m_impl->neighbors( sources, destinations );
+        return sources;
+    }
+    // .................................................................
+    std::vector<int> Communicator::neighborDestinations() const
+    {
+        std::vector<int> sources, destinations;
+        m_impl->neighbors( sources, destinations );
+        return destinations;
+    }
+    // =================================================================
+    void Communicator::pipelineNeighbors( int root, pipeline_type pipeline, int& parent,
+                                          std::vector<int>& children ) const
+    {
+        // Ranks relative to the root :
+        const int vrank = ( rank - root + size ) % size;
+        children.clear();
+        if ( pipeline == chain ) {
+            parent = ( vrank == 0 ? no_process : vrank - 1 );
+            if ( vrank + 1 < size ) children.push_back( vrank + 1 );
+        }
+        else {
+            parent = ( vrank == 0 ? no_process : (vrank - 1)/2 );
+            for ( int child = 2*vrank + 1; (child <= 2*vrank + 2) && (child < size); ++child )
+                children.push_back( child );
+        }
+        if ( parent != no_process ) parent = ( parent + root ) % size;
+        for ( int& child : children ) child = ( child + root ) % size;
     }
     // =================================================================
     void Communicator::barrier() const
     {
+        Profiler::Probe probe( *this, Profiler::barrier );
         m_impl->barrier();
     }
+    // .................................................................
+    Request Communicator::ibarrier() const
+    {
+        Profiler::Probe probe( *this, Profiler::ibarrier );
+        return m_impl->ibarrier();
+    }
+    // .................................................................
+    Request Communicator::barrier_init() const
+    {
+        return m_impl->barrier_init();
+    }
 }
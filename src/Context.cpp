@@ -11,12 +11,52 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+# include <algorithm>
+# include <cstdlib>
 # include <sstream>
 # include <iomanip>
 # include "Parallel/Context.hpp"
+# include "Parallel/Communicator.hpp"
+# include "Parallel/Operator.hpp"
+# include "Parallel/Profiler.hpp"
+# include "Parallel/ThreadGroup.hpp"
+# include "Parallel/Trace.hpp"
 using namespace Parallel;
 
+# if defined(USE_MPI)
 Logger Context::logger;
+TimerLog Context::timers;
+# else
+thread_local Logger Context::logger;
+thread_local TimerLog Context::timers;
+# endif
+
+namespace
+{
+  // Statistics of the communications and of the timers on all the processes,
+  // written by the process 0, and trace of the processes
+  void reportStatistics()
+  {
+    std::string summary = Profiler::current().report();
+    if ( !summary.empty() ) LogInformation << summary;
+    std::string table = Context::timers.report(Communicator::world());
+    if ( !table.empty() ) LogInformation << table;
+    Tracer::current().report();
+    Context::logger.close();
+  }
+# if defined(USE_MPI)
+  // The progress engine is started at the creation of the context if
+  // PARALLEL_PROGRESS gives its poll interval ( in microseconds )
+  void startProgress( ProgressEngine& engine )
+  {
+    const char* interval = std::getenv("PARALLEL_PROGRESS");
+    if ( interval == nullptr || interval[0] == '\0' ) return;
+    const char* cpu = std::getenv("PARALLEL_PROGRESS_CPU");
+    engine.start( ProgressEngine::interval_type( std::max(1L, std::atol(interval)) ),
+                  ( cpu != nullptr && cpu[0] != '\0' ? std::atoi(cpu) : -1 ) );
+  }
+# endif
+}
 
 
 #if defined(USE_MPI)
@@ -71,6 +111,8 @@ Context::Context(int& nargc, char* argv[],
                 m_provided = Context::thread_support::Multiple;
         }
     }
+    m_progress.m_is_allowed = ( m_provided == Context::thread_support::Multiple );
+    startProgress(m_progress);
 }
 // .....................................................................
 Context::~Context()
@@ -78,12 +120,23 @@ Context::~Context()
 # if defined(DEBUG)
   LogTrace << "Arrêt du contexte sous MPI" << "\n";
 # endif  
+  m_progress.stop();
+  reportStatistics();
+  Communicator::releaseWorld();
+  OperatorRegistry::freeAll();
   MPI_Finalize();
 }
+// .....................................................................
+int Context::launch(int& nargc, char* argv[],
+                    const std::function<int(int&, char*[])>& parallel_main)
+{
+  return parallel_main(nargc, argv);
+}
 #else
 Context::Context(int& nargc, char* argv[], bool isMultithreaded ) :
-    m_provided((isMultithreaded ? Context::thread_support::Multiple :
-                                  Context::thread_support::Single))
+    Context::Context(nargc, argv,
+                     (isMultithreaded ? Context::thread_support::Multiple :
+                                        Context::thread_support::Single ))
 {
 }
 //
@@ -91,8 +144,27 @@ Context::Context(int& nargc, char* argv[],
                  Context::thread_support thread_level_support) :
     m_provided(thread_level_support)
 {
+  // The mailbox of a simulated process is read only by its thread : no progress engine,
+  // PARALLEL_PROGRESS is ignored
 }
 //
 Context::~Context()
-{}
+{
+  m_progress.stop();
+  // Synchronization of the threads simulating the processes
+  ThreadGroup::world()->barrier(ThreadGroup::worldRank());
+  reportStatistics();
+  Communicator::releaseWorld();
+}
+//
+int Context::launch(int& nargc, char* argv[],
+                    const std::function<int(int&, char*[])>& parallel_main)
+{
+  const char* nbProcs = std::getenv("PARALLEL_NB_PROCS");
+  int nbThreads = ( nbProcs != nullptr ? std::max(1, std::atoi(nbProcs)) : 1 );
+  return ThreadGroup::launch(nbThreads, [&nargc, argv, &parallel_main] (int) {
+      int nargs = nargc;
+      return parallel_main(nargs, argv);
+    });
+}
 #endif
@@ -0,0 +1,124 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <cstdlib>
+# include <cstring>
+# include "Parallel/LocalGemm.hpp"
+
+# if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#   define PARALLEL_GEMM_X86
+# endif
+
+namespace
+{
+# if defined(PARALLEL_GEMM_X86)
+    // Micro kernel of ( 2 x W ) x NR coefficients with the vectors of W values of the compiler :
+    // the block of AB stays in 2 x NR registers. Inlined in the functions compiled for
+    // the instructions set of each processor.
+    template<typename K, std::size_t W, std::size_t NR> __attribute__((always_inline)) inline void
+    simd_kernel( std::size_t kc, const K* Ap, const K* Bp, K* AB )
+    {
+        typedef K vector __attribute__((vector_size(W*sizeof(K))));
+        vector acc[NR][2];
+        for ( std::size_t j = 0; j < NR; ++j ) acc[j][0] = acc[j][1] = vector{};
+        for ( std::size_t l = 0; l < kc; ++l, Ap += 2*W, Bp += NR ) {
+            vector a0, a1;
+            std::memcpy( &a0, Ap, sizeof(vector) );
+            std::memcpy( &a1, Ap + W, sizeof(vector) );
+            for ( std::size_t j = 0; j < NR; ++j ) {
+                const vector b = vector{} + Bp[j];
+                acc[j][0] += a0*b;
+                acc[j][1] += a1*b;
+            }
+        }
+        for ( std::size_t j = 0; j < NR; ++j ) {
+            std::memcpy( AB + 2*W*j, &acc[j][0], sizeof(vector) );
+            std::memcpy( AB + 2*W*j + W, &acc[j][1], sizeof(vector) );
+        }
+    }
+    // AVX2 : 4 doubles or 8 floats by register, 12 accumulators among the 16 registers
+    __attribute__((target("avx2,fma"))) void
+    avx2_kernel( std::size_t kc, const double* Ap, const double* Bp, double* AB )
+    {
+        simd_kernel<double,4,6>( kc, Ap, Bp, AB );
+    }
+    __attribute__((target("avx2,fma"))) void
+    avx2_kernel( std::size_t kc, const float* Ap, const float* Bp, float* AB )
+    {
+        simd_kernel<float,8,6>( kc, Ap, Bp, AB );
+    }
+    // AVX-512 : 8 doubles or 16 floats by register, 24 accumulators among the 32 registers
+    __attribute__((target("avx512f"))) void
+    avx512_kernel( std::size_t kc, const double* Ap, const double* Bp, double* AB )
+    {
+        simd_kernel<double,8,12>( kc, Ap, Bp, AB );
+    }
+    __attribute__((target("avx512f"))) void
+    avx512_kernel( std::size_t kc, const float* Ap, const float* Bp, float* AB )
+    {
+        simd_kernel<float,16,12>( kc, Ap, Bp, AB );
+    }
+# endif
+    // -----------------------------------------------------------------
+    // The best micro kernel for the processor running the program
+    template<typename K> Parallel::gemm_details::Kernel<K>
+    selectKernel()
+    {
+        using Parallel::gemm_details::Kernel;
+# if defined(PARALLEL_GEMM_X86)
+        __builtin_cpu_init();
+        if ( __builtin_cpu_supports("avx512f") )
+            return Kernel<K>{ "avx512", 128/sizeof(K), 12, &avx512_kernel };
+        if ( __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+            return Kernel<K>{ "avx2", 64/sizeof(K), 6, &avx2_kernel };
+# endif
+        return Kernel<K>{ "generic", 4, 4, &Parallel::gemm_details::generic_kernel<K,4,4> };
+    }
+    template<typename K> const Parallel::gemm_details::Kernel<K>&
+    kernel()
+    {
+        static const Parallel::gemm_details::Kernel<K> selected = selectKernel<K>();
+        return selected;
+    }
+}
+
+namespace Parallel
+{
+    int gemmThreads()
+    {
+        static const int nbThreads = [] () {
+            const char* value = std::getenv("PARALLEL_GEMM_THREADS");
+            return ( value != nullptr && std::atoi(value) > 0 ? std::atoi(value) : 1 );
+        }();
+        return nbThreads;
+    }
+    // .................................................................
+    const char* gemmKernel()
+    {
+        return kernel<double>().name;
+    }
+    // .................................................................
+    void local_gemm( std::size_t m, std::size_t n, std::size_t k, const double& alpha,
+                     const double* A, std::size_t lda, const double* B, std::size_t ldb,
+                     double* C, std::size_t ldc, int nbThreads )
+    {
+        gemm_details::threaded_gemm( kernel<double>(), m, n, k, alpha, A, lda, B, ldb, C, ldc, nbThreads );
+    }
+    // .................................................................
+    void local_gemm( std::size_t m, std::size_t n, std::size_t k, const float& alpha,
+                     const float* A, std::size_t lda, const float* B, std::size_t ldb,
+                     float* C, std::size_t ldc, int nbThreads )
+    {
+        gemm_details::threaded_gemm( kernel<float>(), m, n, k, alpha, A, lda, B, ldb, C, ldc, nbThreads );
+    }
+}
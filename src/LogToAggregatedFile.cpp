@@ -0,0 +1,153 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <iostream>
+# include <iomanip>
+# include <sstream>
+# include "Parallel/LogToAggregatedFile.hpp"
+# include "Parallel/Communicator"
+# include "Parallel/NullStream.hpp"
+using namespace Parallel;
+
+// A sender sends the size of a chunk ( size_tag ), then its text ( text_tag ) if the size
+// isn't null. A null size is the end of the messages of the sender.
+namespace {
+  std::ostream null_stream(new NullBuffer);
+  const int size_tag = 1;
+  const int text_tag = 2;
+}
+
+LogToAggregatedFile::LogToAggregatedFile( std::string const& filename_base, int flags, int ranksPerWriter,
+                                          std::size_t chunkSize ) :
+  Logger::Listener(flags),
+  m_group( ranksPerWriter > 0 ?
+           Communicator( Communicator::world(), Communicator::world().rank/ranksPerWriter, Communicator::world().rank ) :
+           Communicator( Communicator::world(), Communicator::shared_memory, Communicator::world().rank ) ),
+  m_fileName(), m_chunk_size(chunkSize), m_text_buffer(m_text), m_text_stream(&m_text_buffer),
+  m_incoming(0), m_nb_senders(0), m_closed(false)
+{
+  int writer = Communicator::world().rank;
+  m_group.bcast( 1, &writer, &writer, 0 );
+  std::stringstream file_name;
+  file_name << filename_base << std::setfill('0') << std::setw(5) << writer << ".txt";
+  m_fileName = std::string(file_name.str());
+  if ( !isWriter() ) return;
+  m_file.open(m_fileName);
+  if (!m_file) std::cerr << "File creation failed. The messages of this group will be lost.\n";
+  m_nb_senders = m_group.size - 1;
+  if ( m_nb_senders > 0 ) m_incoming_request = m_group.irecv( 1, &m_incoming, any_source, size_tag );
+}
+// -------------------------------------------------------------------
+LogToAggregatedFile::~LogToAggregatedFile()
+{
+  // Without close(), the messages not sent yet are lost
+  m_file.close();
+}
+// -------------------------------------------------------------------
+void
+LogToAggregatedFile::begin( int mode, const Logger::CallSite& site, int rank )
+{
+  if ( m_closed ) return;
+  if ( isWriter() ) receive(false);
+  else {
+    if ( m_text.size() >= m_chunk_size ) send(false);
+    release();
+  }
+  Logger::Listener::begin( mode, site, rank );
+}
+// -------------------------------------------------------------------
+void
+LogToAggregatedFile::flush()
+{
+  if ( m_closed ) return;
+  if ( isWriter() ) {
+    receive(false);
+    m_file.flush();
+  }
+  else {
+    send(false);
+    release();
+  }
+}
+// -------------------------------------------------------------------
+void
+LogToAggregatedFile::close()
+{
+  if ( m_closed ) return;
+  if ( isWriter() ) {
+    receive(true);
+    m_file.close();
+  }
+  else {
+    send(true);
+    m_chunks.emplace_back();
+    Chunk& end = m_chunks.back();
+    end.size = 0;
+    end.sizeRequest = m_group.isend( 1, &end.size, 0, size_tag );
+    for ( Chunk& chunk : m_chunks ) {
+      chunk.sizeRequest.wait();
+      chunk.textRequest.wait();
+    }
+    m_chunks.clear();
+  }
+  m_closed = true;
+}
+// -------------------------------------------------------------------
+std::ostream&
+LogToAggregatedFile::report()
+{
+  if ( m_closed ) return null_stream;
+  if ( isWriter() ) {
+    if (m_file) return m_file;
+    return null_stream;
+  }
+  return m_text_stream;
+}
+// -------------------------------------------------------------------
+void
+LogToAggregatedFile::send( bool all )
+{
+  // Without all, up to the last new line ( rfind returns npos = -1 without new line )
+  const std::size_t length = ( all ? m_text.size() : m_text.rfind('\n') + 1 );
+  if ( length == 0 ) return;
+  m_chunks.emplace_back();
+  Chunk& chunk = m_chunks.back();
+  chunk.text.assign( m_text, 0, length );
+  m_text.erase( 0, length );
+  chunk.size = chunk.text.size();
+  chunk.sizeRequest = m_group.isend( 1, &chunk.size, 0, size_tag );
+  chunk.textRequest = m_group.isend( chunk.text, 0, text_tag );
+}
+// -------------------------------------------------------------------
+void
+LogToAggregatedFile::release()
+{
+  while ( !m_chunks.empty() && m_chunks.front().sizeRequest.test() && m_chunks.front().textRequest.test() )
+    m_chunks.pop_front();
+}
+// -------------------------------------------------------------------
+void
+LogToAggregatedFile::receive( bool wait )
+{
+  while ( m_nb_senders > 0 ) {
+    if ( wait ) m_incoming_request.wait();
+    else if ( !m_incoming_request.test() ) return;
+    if ( m_incoming == 0 ) --m_nb_senders;
+    else {
+      std::string text;
+      m_group.recv( text, m_incoming_request.status().source(), text_tag );
+      m_file << text;
+    }
+    if ( m_nb_senders > 0 ) m_incoming_request = m_group.irecv( 1, &m_incoming, any_source, size_tag );
+  }
+}
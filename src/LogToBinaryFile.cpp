@@ -0,0 +1,299 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <chrono>
+# include <cstring>
+# include <iostream>
+# include <iomanip>
+# include <sstream>
+# include "Parallel/LogToBinaryFile.hpp"
+# include "Parallel/Communicator.hpp"
+using namespace Parallel;
+
+// Layout of the file : the header "PLOG", version ( u32 ) and rank ( i32 ), then records.
+//   Call site : 'S', identifier, line, file and function ( strings )
+//   Message   : 'M', time since the previous message ( signed ), mode ( u8 ), call site,
+//               size of the arguments, arguments
+//   Argument  : 'i' signed, 'u' unsigned, 'd' f64 or 's' string
+//   String    : length and characters
+// The integers are written by groups of 7 bits ( varint ), the signed ones after a zigzag
+// encoding ( 0, -1, 1, -2, ... -> 0, 1, 2, 3, ... ), so the small values take one byte.
+namespace {
+  const char          magic[4] = { 'P', 'L', 'O', 'G' };
+  const std::uint32_t version  = 1;
+
+  void appendVarint( std::string& data, std::uint64_t value )
+  {
+    while ( value >= 0x80 ) {
+      data.push_back( char(0x80 | (value & 0x7F)) );
+      value >>= 7;
+    }
+    data.push_back( char(value) );
+  }
+  std::uint64_t zigzag( std::int64_t value )
+  {
+    return ( std::uint64_t(value) << 1 ) ^ std::uint64_t(value >> 63);
+  }
+  void appendString( std::string& data, const char* text, std::size_t length )
+  {
+    appendVarint( data, length );
+    data.append( text, length );
+  }
+  // ...................................................................
+  template<typename K> bool get( const std::string& data, std::size_t& pos, K& value )
+  {
+    if ( pos + sizeof(K) > data.size() ) return false;
+    std::memcpy( &value, data.data() + pos, sizeof(K) );
+    pos += sizeof(K);
+    return true;
+  }
+  bool getVarint( const std::string& data, std::size_t& pos, std::uint64_t& value )
+  {
+    value = 0;
+    for ( int shift = 0; shift < 64 && pos < data.size(); shift += 7 ) {
+      const std::uint8_t byte = std::uint8_t(data[pos++]);
+      value |= std::uint64_t(byte & 0x7F) << shift;
+      if ( (byte & 0x80) == 0 ) return true;
+    }
+    return false;
+  }
+  bool getSigned( const std::string& data, std::size_t& pos, std::int64_t& value )
+  {
+    std::uint64_t encoded;
+    if ( !getVarint(data, pos, encoded) ) return false;
+    value = std::int64_t(encoded >> 1) ^ -std::int64_t(encoded & 1);
+    return true;
+  }
+  bool getString( const std::string& data, std::size_t& pos, std::string& text )
+  {
+    std::uint64_t length;
+    if ( !getVarint(data, pos, length) || pos + length > data.size() ) return false;
+    text.assign( data, pos, std::size_t(length) );
+    pos += std::size_t(length);
+    return true;
+  }
+}
+
+LogToBinaryFile::LogToBinaryFile( std::string const& filename_base, int flags ) :
+  Logger::Listener(flags), m_fileName(), m_open_record(false), m_time(0), m_last_time(0), m_mode(0), m_site(0),
+  m_text_buffer(m_text), m_text_stream(&m_text_buffer)
+{
+  const std::int32_t rank = Communicator::world().rank;
+  std::stringstream file_name;
+  file_name << filename_base << std::setfill('0') << std::setw(5) << rank << ".plog";
+  m_fileName = std::string(file_name.str());
+  m_file.open(m_fileName, std::ios::binary);
+  if (!m_file) {
+    std::cerr << "File creation failed. This listener will be unavailable.\n";
+    m_fileName = "";
+    return;
+  }
+  m_file.write( magic, sizeof(magic) );
+  m_file.write( reinterpret_cast<const char*>(&version), sizeof(version) );
+  m_file.write( reinterpret_cast<const char*>(&rank), sizeof(rank) );
+}
+// -------------------------------------------------------------------
+LogToBinaryFile::~LogToBinaryFile()
+{
+  endRecord();
+  m_file.close();
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::begin( int mode, const Logger::CallSite& site, int )
+{
+  endRecord();
+  m_open_record = true;
+  m_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch()).count();
+  m_mode = mode;
+  m_site = 0;
+  if ( site.file == nullptr ) return;
+  auto key = std::make_tuple( site.file, site.function, site.line );
+  auto itS = m_sites.find(key);
+  if ( itS != m_sites.end() ) {
+    m_site = itS->second;
+    return;
+  }
+  // First message of this call site : its definition is written before the message
+  m_site = std::uint32_t(m_sites.size()) + 1;
+  m_sites.emplace( key, m_site );
+  std::string definition(1, 'S');
+  appendVarint( definition, m_site );
+  appendVarint( definition, zigzag(site.line) );
+  for ( const char* text : { site.file, site.function } )
+    appendString( definition, text, std::strlen(text) );
+  m_file.write( definition.data(), std::streamsize(definition.size()) );
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::put( long long value )
+{
+  putText();
+  m_record.push_back('i');
+  appendVarint( m_record, zigzag(value) );
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::put( unsigned long long value )
+{
+  putText();
+  m_record.push_back('u');
+  appendVarint( m_record, value );
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::put( double value )
+{
+  putText();
+  m_record.push_back('d');
+  m_record.append( reinterpret_cast<const char*>(&value), sizeof(value) );
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::put( const char* text, std::size_t length )
+{
+  m_text.append( text, length );
+  if ( !m_text.empty() && m_text.back() == '\n' ) {
+    m_text.pop_back();
+    endRecord();
+  }
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::flush()
+{
+  endRecord();
+  m_file.flush();
+}
+// -------------------------------------------------------------------
+std::ostream&
+LogToBinaryFile::report()
+{
+  return m_text_stream;
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::putText()
+{
+  if ( m_text.empty() ) return;
+  m_record.push_back('s');
+  appendString( m_record, m_text.data(), m_text.size() );
+  m_text.clear();
+}
+// -------------------------------------------------------------------
+void
+LogToBinaryFile::endRecord()
+{
+  putText();
+  if ( !m_open_record && m_record.empty() ) return;
+  if ( !m_open_record ) {
+    // Arguments logged without beginning of message
+    m_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch()).count();
+    m_mode = Logger::INFORMATION;
+    m_site = 0;
+  }
+  std::string header(1, 'M');
+  appendVarint( header, zigzag(m_time - m_last_time) );
+  header.push_back( char(m_mode) );
+  appendVarint( header, m_site );
+  appendVarint( header, m_record.size() );
+  m_last_time = m_time;
+  m_file.write( header.data(), std::streamsize(header.size()) );
+  m_file.write( m_record.data(), std::streamsize(m_record.size()) );
+  m_record.clear();
+  m_open_record = false;
+}
+// ===================================================================
+bool
+LogToBinaryFile::read( const std::string& fileName, Content& content )
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if ( !file ) return false;
+  std::ostringstream buffer;
+  buffer << file.rdbuf();
+  const std::string data = buffer.str();
+  std::size_t pos = sizeof(magic);
+  std::uint32_t fileVersion;
+  std::int32_t rank;
+  if ( data.compare(0, sizeof(magic), magic, sizeof(magic)) != 0 ||
+       !get(data, pos, fileVersion) || fileVersion != version || !get(data, pos, rank) ) return false;
+  content.rank = rank;
+  content.entries.clear();
+  content.sites.assign( 1, Site{ std::string(), std::string(), 0 } );
+  std::vector<std::size_t> indices(1, 0); // Index in sites of each identifier
+  std::int64_t time = 0;
+  while ( pos < data.size() ) {
+    const char kind = data[pos++];
+    if ( kind == 'S' ) {
+      std::uint64_t id;
+      std::int64_t line;
+      Site site;
+      if ( !getVarint(data, pos, id) || !getSigned(data, pos, line) ||
+           !getString(data, pos, site.file) || !getString(data, pos, site.function) ) return false;
+      site.line = int(line);
+      if ( indices.size() <= id ) indices.resize(std::size_t(id)+1, 0);
+      indices[std::size_t(id)] = content.sites.size();
+      content.sites.push_back(site);
+      continue;
+    }
+    if ( kind != 'M' ) return false;
+    Entry entry;
+    std::int64_t elapsed;
+    std::uint8_t mode;
+    std::uint64_t site, size;
+    if ( !getSigned(data, pos, elapsed) || !get(data, pos, mode) || !getVarint(data, pos, site) ||
+         !getVarint(data, pos, size) || pos + size > data.size() ) return false;
+    time += elapsed;
+    entry.time = time;
+    entry.mode = mode;
+    entry.site = ( site < indices.size() ? std::uint32_t(indices[std::size_t(site)]) : 0 );
+    // The arguments are written as LogToFile would do :
+    std::ostringstream text;
+    const std::size_t end = pos + std::size_t(size);
+    while ( pos < end ) {
+      const char tag = data[pos++];
+      std::int64_t  i;
+      std::uint64_t u;
+      double        d;
+      std::string   s;
+      bool ok = true;
+      switch ( tag ) {
+        case 'i': ok = getSigned(data, pos, i); text << i; break;
+        case 'u': ok = getVarint(data, pos, u); text << u; break;
+        case 'd': ok = get(data, pos, d); text << d; break;
+        case 's': ok = getString(data, pos, s); text << s; break;
+        default: ok = false;
+      }
+      if ( !ok || pos > end ) return false;
+    }
+    entry.text = text.str();
+    content.entries.push_back( std::move(entry) );
+  }
+  return true;
+}
+// -------------------------------------------------------------------
+std::string
+LogToBinaryFile::format( const Content& content, const Entry& entry )
+{
+  std::ostringstream text;
+  if ( entry.site != 0 ) {
+    const Site& site = content.sites[entry.site];
+    Logger::writePrefix( text, entry.mode,
+                         Logger::CallSite{ site.file.c_str(), site.function.c_str(), site.line },
+                         content.rank );
+  }
+  text << entry.text;
+  return text.str();
+}
@@ -27,9 +27,8 @@ namespace {
 LogToFile::LogToFile( std::string const& filename_base, int flags ) :
   Logger::Listener(flags), m_fileName()
 {
-  Communicator com;
   std::stringstream file_name;
-  file_name << filename_base << std::setfill('0') << std::setw(5) << com.rank << ".txt";
+  file_name << filename_base << std::setfill('0') << std::setw(5) << Communicator::world().rank << ".txt";
   m_fileName = std::string(file_name.str());
   m_file.open(m_fileName);
   if (!m_file) {
@@ -13,24 +13,250 @@
 // limitations under the License.
 # include <cassert>
 # include <algorithm>
+# include <atomic>
+# include <chrono>
+# include <condition_variable>
+# include <cstdint>
+# include <cstdlib>
 # include <iostream>
+# include <thread>
+# include <vector>
 # include "Parallel/Logger.hpp"
 # include "Parallel/Communicator.hpp"
 using namespace Parallel;
 
-Logger::Logger() : m_listeners(), m_rank(-1), m_current_mode(Logger::INFORMATION)
-{}
+// ========================================================================
+// Bounded queue of messages with several producers ( the threads logging ) and
+// one consumer ( the background thread ), without lock : each cell has a sequence
+// number telling if it's free for the producer of the position or full for the
+// consumer. The strings are swapped, so their memory is reused.
+class Logger::AsyncWriter
+{
+public:
+  AsyncWriter( Logger& log, std::size_t capacity, overflow_policy policy ) :
+    m_log(log), m_policy(policy), m_head(0), m_tail(0), m_written(0), m_dropped(0),
+    m_reported_drops(0), m_stop(false)
+  {
+    std::size_t size = 2;
+    while ( size < capacity ) size *= 2;
+    m_cells = std::vector<Cell>(size);
+    for ( std::size_t i = 0; i < size; ++i ) m_cells[i].sequence = i;
+    m_mask   = size - 1;
+    m_thread = std::thread( [this] () { run(); } );
+  }
+  ~AsyncWriter()
+  {
+    m_stop = true;
+    m_wakeup.notify_one();
+    m_thread.join();
+  }
+  // Push the message, or drop it if the queue is full and the policy is drop_when_full
+  void push( int mode, const CallSite& site, std::string& text )
+  {
+    while ( !tryPush(mode, site, text) ) {
+      if ( m_policy == drop_when_full ) {
+        ++ m_dropped;
+        text.clear();
+        return;
+      }
+      m_wakeup.notify_one();
+      std::this_thread::yield();
+    }
+    if ( 2*(m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_relaxed)) > m_mask )
+      m_wakeup.notify_one();
+  }
+  // Wait the writing of all the messages pushed before the call
+  void drain()
+  {
+    const std::size_t target = m_head.load();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wakeup.notify_one();
+    m_drained.wait( lock, [this, target] () { return m_written.load() >= target; } );
+  }
+  std::size_t dropped() const { return m_dropped; }
+private:
+  struct Cell
+  {
+    std::atomic<std::size_t> sequence;
+    int                      mode;
+    CallSite                 site;
+    std::string              text;
+  };
+  bool tryPush( int mode, const CallSite& site, std::string& text )
+  {
+    std::size_t pos = m_head.load(std::memory_order_relaxed);
+    for ( ;; ) {
+      Cell& cell = m_cells[pos & m_mask];
+      const std::intptr_t diff = std::intptr_t(cell.sequence.load(std::memory_order_acquire)) - std::intptr_t(pos);
+      if ( diff == 0 ) {
+        if ( m_head.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed) ) {
+          cell.mode = mode;
+          cell.site = site;
+          cell.text.swap(text);
+          text.clear();
+          cell.sequence.store(pos+1, std::memory_order_release);
+          return true;
+        }
+      }
+      else if ( diff < 0 ) return false; // Full
+      else pos = m_head.load(std::memory_order_relaxed);
+    }
+  }
+  bool pop( int& mode, CallSite& site, std::string& text )
+  {
+    const std::size_t pos = m_tail.load(std::memory_order_relaxed);
+    Cell& cell = m_cells[pos & m_mask];
+    if ( cell.sequence.load(std::memory_order_acquire) != pos+1 ) return false;
+    mode = cell.mode;
+    site = cell.site;
+    text.swap(cell.text);
+    cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+    m_tail.store(pos+1, std::memory_order_relaxed);
+    return true;
+  }
+  // Write the queued messages by batches until the stop
+  void run()
+  {
+    int mode;
+    CallSite site;
+    std::string text;
+    for ( ;; ) {
+      const bool stop = m_stop;
+      std::size_t nbWritten = 0;
+      {
+        std::lock_guard<std::mutex> lock(m_log.m_listeners_mutex);
+        while ( pop(mode, site, text) ) {
+          for ( auto listener : m_log.m_listeners )
+            if ( listener->toReport(mode) ) {
+              listener->begin( mode, site, m_log.m_rank );
+              listener->put( text.data(), text.size() );
+            }
+          ++ nbWritten;
+        }
+        const std::size_t drops = m_dropped;
+        if ( drops > m_reported_drops ) {
+          const std::string warning = std::to_string(drops - m_reported_drops) +
+                                      " messages dropped ( queue full )\n";
+          for ( auto listener : m_log.m_listeners )
+            if ( listener->toReport(WARNING) ) {
+              listener->begin( WARNING, CallSite{ __FILE__, __FUNCTION__, __LINE__ }, m_log.m_rank );
+              listener->put( warning.data(), warning.size() );
+            }
+          m_reported_drops = drops;
+        }
+        if ( nbWritten > 0 )
+          for ( auto listener : m_log.m_listeners ) listener->flush();
+      }
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if ( nbWritten > 0 ) {
+        m_written += nbWritten;
+        m_drained.notify_all();
+      }
+      if ( stop && nbWritten == 0 ) return;
+      if ( nbWritten == 0 ) m_wakeup.wait_for( lock, std::chrono::milliseconds(10) );
+    }
+  }
+
+  Logger&                  m_log;
+  overflow_policy          m_policy;
+  std::vector<Cell>        m_cells;
+  std::size_t              m_mask;
+  std::atomic<std::size_t> m_head, m_tail, m_written, m_dropped;
+  std::size_t              m_reported_drops;
+  std::atomic<bool>        m_stop;
+  std::mutex               m_mutex;
+  std::condition_variable  m_wakeup, m_drained;
+  std::thread              m_thread;
+};
+// ========================================================================
+void
+Logger::writePrefix( std::ostream& out, int mode, const CallSite& site, int rank )
+{
+  out << rank;
+  switch ( mode ) {
+    case INFORMATION: out << " : [Information] "; return;
+    case ASSERTION:   out << " : [ [Assertion] "; break;
+    case ERROR:       out << " : [ [Error] ";     break;
+    case WARNING:     out << " : [ [Warning] ";   break;
+    default:          out << " : [ [Trace] ";
+  }
+  out << site.file << " in " << site.function << " at " << site.line << " ] : ";
+}
+// ------------------------------------------------------------------------
+Logger::Logger() : m_rank(-1), m_current_mode(Logger::INFORMATION), m_wanted(0), m_listeners()
+{
+  const char* policy = std::getenv("PARALLEL_LOG_ASYNC");
+  if ( policy != nullptr && policy[0] != '\0' )
+    setAsynchronous( true, 4096, std::string(policy) == "drop" ? drop_when_full : block_when_full );
+}
+// ------------------------------------------------------------------------
+Logger::~Logger()
+{
+  // The messages not ended by a new line are lost : the buffer of the thread may be
+  // destroyed yet
+  m_writer.reset();
+  for ( auto listener : m_listeners )
+    listener->flush();
+}
+// ------------------------------------------------------------------------
+void
+Logger::setAsynchronous( bool async, std::size_t capacity, overflow_policy policy )
+{
+  if ( m_writer ) {
+    Record& record = current();
+    if ( !record.text.empty() ) commit(record);
+    m_writer.reset();
+  }
+  if ( async ) m_writer.reset( new AsyncWriter(*this, capacity, policy) );
+}
+// ------------------------------------------------------------------------
+std::size_t
+Logger::dropped() const
+{
+  return ( m_writer ? m_writer->dropped() : 0 );
+}
+// ------------------------------------------------------------------------
+Logger&
+Logger::flush()
+{
+  if ( m_writer ) {
+    Record& record = current();
+    if ( !record.text.empty() ) commit(record);
+    m_writer->drain();
+    return *this;
+  }
+  for ( auto listener : m_listeners )
+    listener->flush();
+  return *this;
+}
+// ------------------------------------------------------------------------
+void
+Logger::close()
+{
+  flush();
+  std::lock_guard<std::mutex> lock(m_listeners_mutex);
+  for ( auto listener : m_listeners )
+    listener->close();
+}
+// ------------------------------------------------------------------------
+void
+Logger::commit( Record& record )
+{
+  m_writer->push( record.mode, record.site, record.text );
+}
 // ------------------------------------------------------------------------
 bool
 Logger::subscribe(Logger::Listener* listener)
 {
   if ( m_rank == -1 ) {
-    m_rank = Communicator().rank;
+    m_rank = Communicator::world().rank;
   }
   if (listener == nullptr) return false;
+  std::lock_guard<std::mutex> lock(m_listeners_mutex);
   auto itL = std::find(m_listeners.begin(),m_listeners.end(), listener);
   if (itL != m_listeners.end()) return false;
   m_listeners.push_back(listener);
+  updateWanted();
   return true;
 }
 // ------------------------------------------------------------------------
@@ -38,11 +264,23 @@ bool
 Logger::unsubscribe(Logger::Listener* listener)
 {
   if (listener == NULL) return false;
+  std::lock_guard<std::mutex> lock(m_listeners_mutex);
   auto itL = std::find(m_listeners.begin(),m_listeners.end(), listener);
   if (itL == m_listeners.end()) return false;
   m_listeners.remove(listener);
+  updateWanted();
   return true;
 }
+// ------------------------------------------------------------------------
+void
+Logger::updateWanted()
+{
+  int wanted = 0;
+  for ( auto listener : m_listeners )
+    for ( int mode = ASSERTION; mode <= TRACE; mode *= 2 )
+      if ( listener->toReport(mode) ) wanted |= mode;
+  m_wanted = wanted;
+}
 // ========================================================================
 Logger::Listener::Listener( int flags ) : m_flags(flags)
 {}
@@ -0,0 +1,200 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include "Parallel/NodeHierarchy.hpp"
+
+#if defined(USE_MPI)
+using namespace Parallel;
+
+namespace
+{
+    // Tag of the messages between the root and the leader of its node
+    const int node_tag = 1;
+    // Temporary buffer for count objects of the datatype
+    struct Buffer
+    {
+        Buffer( int count, MPI_Datatype type )
+        {
+            MPI_Aint lb, extent;
+            MPI_Type_get_extent( type, &lb, &extent );
+            m_storage.resize( std::size_t(count)*std::size_t(extent) );
+            m_data = m_storage.data() - lb;
+        }
+        void* data() { return m_data; }
+        std::vector<char> m_storage;
+        char* m_data;
+    };
+    // Copy of count objects in a local buffer
+    void local_copy( const void* src, void* dst, int count, MPI_Datatype type )
+    {
+        if ( src == dst ) return;
+        MPI_Sendrecv( src, count, type, 0, node_tag, dst, count, type, 0, node_tag,
+                      MPI_COMM_SELF, MPI_STATUS_IGNORE );
+    }
+    bool is_commutative( MPI_Op op )
+    {
+        int commute;
+        MPI_Op_commutative( op, &commute );
+        return ( commute != 0 );
+    }
+}
+// .....................................................................
+NodeHierarchy::NodeHierarchy( MPI_Comm com ) : m_leaders(MPI_COMM_NULL)
+{
+    int size, nodeRank;
+    MPI_Comm_rank( com, &m_rank );
+    MPI_Comm_size( com, &size );
+    MPI_Comm_split_type( com, MPI_COMM_TYPE_SHARED, m_rank, MPI_INFO_NULL, &m_node );
+    MPI_Comm_rank( m_node, &nodeRank );
+    MPI_Comm_split( com, (nodeRank == 0 ? 0 : MPI_UNDEFINED), m_rank, &m_leaders );
+    // Rank of the node of the current process in the leaders communicator :
+    int node[2] = { 0, nodeRank };
+    if ( isLeader() ) {
+        MPI_Comm_rank( m_leaders, &node[0] );
+        MPI_Comm_size( m_leaders, &m_nb_nodes );
+    }
+    MPI_Bcast( node, 1, MPI_INT, 0, m_node );
+    MPI_Bcast( &m_nb_nodes, 1, MPI_INT, 0, m_node );
+    std::vector<int> nodes(2*size);
+    MPI_Allgather( node, 2, MPI_INT, nodes.data(), 2, MPI_INT, com );
+    m_node_of.resize(size);
+    m_node_rank.resize(size);
+    for ( int p = 0; p < size; ++p ) {
+        m_node_of  [p] = nodes[2*p];
+        m_node_rank[p] = nodes[2*p+1];
+    }
+}
+// .....................................................................
+NodeHierarchy::~NodeHierarchy()
+{
+    if ( m_leaders != MPI_COMM_NULL ) MPI_Comm_free( &m_leaders );
+    MPI_Comm_free( &m_node );
+}
+// .....................................................................
+int NodeHierarchy::keyval()
+{
+    static const int key = [] () {
+        int key;
+        MPI_Comm_create_keyval( MPI_COMM_NULL_COPY_FN, NodeHierarchy::free_attribute, &key, nullptr );
+        return key;
+    }();
+    return key;
+}
+// .....................................................................
+int NodeHierarchy::free_attribute( MPI_Comm, int, void* attribute, void* )
+{
+    delete static_cast<NodeHierarchy*>(attribute);
+    return MPI_SUCCESS;
+}
+// .....................................................................
+void NodeHierarchy::attach( MPI_Comm com )
+{
+    if ( get(com) != nullptr ) return;
+    MPI_Comm_set_attr( com, keyval(), new NodeHierarchy(com) );
+}
+// .....................................................................
+void NodeHierarchy::detach( MPI_Comm com )
+{
+    if ( get(com) != nullptr ) MPI_Comm_delete_attr( com, keyval() );
+}
+// .....................................................................
+const NodeHierarchy* NodeHierarchy::get( MPI_Comm com )
+{
+    void* attribute;
+    int found;
+    MPI_Comm_get_attr( com, keyval(), &attribute, &found );
+    return ( found != 0 ? static_cast<const NodeHierarchy*>(attribute) : nullptr );
+}
+// =====================================================================
+int NodeHierarchy::bcast( void* buffer, int count, MPI_Datatype type, int root, MPI_Comm com )
+{
+    const NodeHierarchy* hierarchy = get(com);
+    if ( hierarchy == nullptr ) return MPI_Bcast( buffer, count, type, root, com );
+    return hierarchy->hierarchical_bcast( buffer, count, type, root );
+}
+// .....................................................................
+int NodeHierarchy::reduce( const void* sndbuf, void* rcvbuf, int count, MPI_Datatype type,
+                           MPI_Op op, int root, MPI_Comm com )
+{
+    const NodeHierarchy* hierarchy = get(com);
+    if ( (hierarchy == nullptr) || !is_commutative(op) )
+        return MPI_Reduce( sndbuf, rcvbuf, count, type, op, root, com );
+    return hierarchy->hierarchical_reduce( sndbuf, rcvbuf, count, type, op, root );
+}
+// .....................................................................
+int NodeHierarchy::allreduce( const void* sndbuf, void* rcvbuf, int count, MPI_Datatype type,
+                              MPI_Op op, MPI_Comm com )
+{
+    const NodeHierarchy* hierarchy = get(com);
+    if ( (hierarchy == nullptr) || !is_commutative(op) )
+        return MPI_Allreduce( sndbuf, rcvbuf, count, type, op, com );
+    return hierarchy->hierarchical_allreduce( sndbuf, rcvbuf, count, type, op );
+}
+// =====================================================================
+int NodeHierarchy::hierarchical_bcast( void* buffer, int count, MPI_Datatype type, int root ) const
+{
+    // 1. If the root isn't a leader, it sends the data to the leader of its node
+    const int rootNode = m_node_of[root], rootLocal = m_node_rank[root];
+    const int localRank = m_node_rank[m_rank];
+    if ( (rootLocal != 0) && (m_node_of[m_rank] == rootNode) ) {
+        if ( m_rank == root )
+            MPI_Send( buffer, count, type, 0, node_tag, m_node );
+        else if ( localRank == 0 )
+            MPI_Recv( buffer, count, type, rootLocal, node_tag, m_node, MPI_STATUS_IGNORE );
+    }
+    // 2. Broadcast between the leaders, then inside each node
+    if ( isLeader() ) MPI_Bcast( buffer, count, type, rootNode, m_leaders );
+    return MPI_Bcast( buffer, count, type, 0, m_node );
+}
+// .....................................................................
+int NodeHierarchy::hierarchical_reduce( const void* sndbuf, void* rcvbuf, int count,
+                                        MPI_Datatype type, MPI_Op op, int root ) const
+{
+    const int rootNode = m_node_of[root], rootLocal = m_node_rank[root];
+    const void* data = ( sndbuf == MPI_IN_PLACE ? rcvbuf : sndbuf );
+    // 1. Reduction inside each node on the leader
+    Buffer node(isLeader() ? count : 0, type);
+    MPI_Reduce( data, node.data(), count, type, op, 0, m_node );
+    // 2. Reduction between the leaders on the leader of the node of root
+    if ( isLeader() ) {
+        int leaderRank;
+        MPI_Comm_rank( m_leaders, &leaderRank );
+        MPI_Reduce( (leaderRank == rootNode ? MPI_IN_PLACE : node.data()), node.data(),
+                    count, type, op, rootNode, m_leaders );
+    }
+    // 3. The leader of the node of root gives the result to root
+    if ( m_node_of[m_rank] != rootNode ) return MPI_SUCCESS;
+    if ( rootLocal == 0 ) {
+        if ( m_rank == root ) local_copy( node.data(), rcvbuf, count, type );
+        return MPI_SUCCESS;
+    }
+    if ( m_node_rank[m_rank] == 0 )
+        return MPI_Send( node.data(), count, type, rootLocal, node_tag, m_node );
+    if ( m_rank == root )
+        return MPI_Recv( rcvbuf, count, type, 0, node_tag, m_node, MPI_STATUS_IGNORE );
+    return MPI_SUCCESS;
+}
+// .....................................................................
+int NodeHierarchy::hierarchical_allreduce( const void* sndbuf, void* rcvbuf, int count,
+                                           MPI_Datatype type, MPI_Op op ) const
+{
+    const void* data = ( sndbuf == MPI_IN_PLACE ? rcvbuf : sndbuf );
+    Buffer node(isLeader() ? count : 0, type);
+    MPI_Reduce( data, node.data(), count, type, op, 0, m_node );
+    if ( isLeader() ) {
+        MPI_Allreduce( MPI_IN_PLACE, node.data(), count, type, op, m_leaders );
+        local_copy( node.data(), rcvbuf, count, type );
+    }
+    return MPI_Bcast( rcvbuf, count, type, 0, m_node );
+}
+#endif
@@ -0,0 +1,42 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <mutex>
+# include <vector>
+# include "Parallel/Operator.hpp"
+
+#if defined(USE_MPI)
+using namespace Parallel;
+
+namespace
+{
+    std::mutex          operators_mutex;
+    std::vector<MPI_Op> operators;
+}
+// .....................................................................
+MPI_Op OperatorRegistry::create( MPI_User_function* fct, bool commute )
+{
+    MPI_Op op;
+    MPI_Op_create( fct, (commute ? 1 : 0), &op );
+    std::lock_guard<std::mutex> lock(operators_mutex);
+    operators.push_back(op);
+    return op;
+}
+// .....................................................................
+void OperatorRegistry::freeAll()
+{
+    std::lock_guard<std::mutex> lock(operators_mutex);
+    for ( auto& op : operators ) MPI_Op_free(&op);
+    operators.clear();
+}
+#endif
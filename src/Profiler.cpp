@@ -0,0 +1,230 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <algorithm>
+# include <cstdlib>
+# include <fstream>
+# include <iomanip>
+# include <sstream>
+# include <vector>
+# include "Parallel/Profiler.hpp"
+# include "Parallel/Communicator"
+using namespace Parallel;
+
+namespace
+{
+    const char* operation_names[Profiler::nb_operations] = {
+        "send", "isend", "recv", "irecv",
+        "bcast", "ibcast", "reduce", "ireduce", "allreduce", "iallreduce",
+        "gather", "allgather", "iallgather", "scatter", "alltoall", "ialltoall",
+        "neighbor", "barrier", "ibarrier"
+    };
+    // Bin of the histograms for a message of nbBytes bytes
+    int bin( std::size_t nbBytes )
+    {
+        int b = 0;
+        while ( (nbBytes > 0) && (b < Profiler::nb_bins - 1) ) { nbBytes >>= 1; ++b; }
+        return b;
+    }
+    // Range of the sizes of the messages counted in the bin b
+    std::size_t binMin( int b ) { return ( b == 0 ? 0 : std::size_t(1) << (b-1) ); }
+    std::size_t binMax( int b ) { return ( b == 0 ? 0 : (std::size_t(1) << b) - 1 ); }
+}
+// =====================================================================
+Profiler::Profiler() : m_enabled(false), m_format(csv), m_fileBase("Profile")
+{
+    const char* format = std::getenv("PARALLEL_PROFILE");
+    if ( format != nullptr ) {
+        if      ( std::string(format) == "csv"  ) enable( csv );
+        else if ( std::string(format) == "json" ) enable( json );
+    }
+}
+// ---------------------------------------------------------------------
+Profiler& Profiler::current()
+{
+# if defined(USE_MPI)
+    static Profiler profiler;
+# else
+    static thread_local Profiler profiler; // One profiler for each simulated process
+# endif
+    return profiler;
+}
+// ---------------------------------------------------------------------
+const char* Profiler::name( operation op )
+{
+    return operation_names[op];
+}
+// ---------------------------------------------------------------------
+void Profiler::enable( format_type format, const std::string& fileBase )
+{
+    m_format   = format;
+    m_fileBase = fileBase;
+    m_enabled  = true;
+}
+// ---------------------------------------------------------------------
+void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_counters.fill( Counters() );
+    m_peers.clear();
+}
+// ---------------------------------------------------------------------
+void Profiler::record( operation op, int peer, std::size_t bytes, double seconds )
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Counters& counters = m_counters[op];
+    counters.calls   += 1;
+    counters.bytes   += bytes;
+    counters.seconds += seconds;
+    counters.histogram[bin(bytes)] += 1;
+    if ( peer < 0 ) return;
+    if ( (op == send) || (op == isend) ) {
+        m_peers[peer].sent      += 1;
+        m_peers[peer].sentBytes += bytes;
+    }
+    else if ( (op == recv) || (op == irecv) ) {
+        m_peers[peer].received      += 1;
+        m_peers[peer].receivedBytes += bytes;
+    }
+}
+// ---------------------------------------------------------------------
+void Profiler::write( std::ostream& out, format_type format ) const
+{
+    out << std::setprecision(9);
+    if ( format == csv ) {
+        out << "# operation,name,calls,bytes,seconds\n";
+        for ( int op = 0; op < nb_operations; ++op ) {
+            const Counters& c = m_counters[op];
+            if ( c.calls > 0 )
+                out << "operation," << operation_names[op] << ',' << c.calls << ','
+                    << c.bytes << ',' << c.seconds << '\n';
+        }
+        out << "# histogram,name,min bytes,max bytes,messages\n";
+        for ( int op = 0; op < nb_operations; ++op )
+            for ( int b = 0; b < nb_bins; ++b )
+                if ( m_counters[op].histogram[b] > 0 )
+                    out << "histogram," << operation_names[op] << ',' << binMin(b) << ','
+                        << binMax(b) << ',' << m_counters[op].histogram[b] << '\n';
+        out << "# peer,world rank,messages sent,bytes sent,messages received,bytes received\n";
+        for ( const auto& peer : m_peers )
+            out << "peer," << peer.first << ',' << peer.second.sent << ',' << peer.second.sentBytes
+                << ',' << peer.second.received << ',' << peer.second.receivedBytes << '\n';
+        return;
+    }
+    out << "{\n  \"operations\": {";
+    bool first = true;
+    for ( int op = 0; op < nb_operations; ++op ) {
+        const Counters& c = m_counters[op];
+        if ( c.calls == 0 ) continue;
+        out << ( first ? "\n" : ",\n" ) << "    \"" << operation_names[op] << "\": { \"calls\": "
+            << c.calls << ", \"bytes\": " << c.bytes << ", \"seconds\": " << c.seconds
+            << ", \"histogram\": [";
+        bool firstBin = true;
+        for ( int b = 0; b < nb_bins; ++b )
+            if ( c.histogram[b] > 0 ) {
+                out << ( firstBin ? "" : ", " ) << "[" << binMin(b) << ", " << binMax(b) << ", "
+                    << c.histogram[b] << "]";
+                firstBin = false;
+            }
+        out << "] }";
+        first = false;
+    }
+    out << "\n  },\n  \"peers\": {";
+    first = true;
+    for ( const auto& peer : m_peers ) {
+        out << ( first ? "\n" : ",\n" ) << "    \"" << peer.first << "\": { \"sent\": "
+            << peer.second.sent << ", \"sentBytes\": " << peer.second.sentBytes
+            << ", \"received\": " << peer.second.received << ", \"receivedBytes\": "
+            << peer.second.receivedBytes << " }";
+        first = false;
+    }
+    out << "\n  }\n}\n";
+}
+// ---------------------------------------------------------------------
+std::string Profiler::report( int root )
+{
+    // The communications of the report aren't recorded :
+    const bool enabled = m_enabled;
+    m_enabled = false;
+    const Communicator& world = Communicator::world();
+    int anyEnabled;
+    world.allreduce( int(enabled), anyEnabled, Parallel::max );
+    if ( anyEnabled == 0 ) return std::string();
+    if ( enabled ) {
+        std::ostringstream fileName;
+        fileName << m_fileBase << std::setfill('0') << std::setw(5) << world.rank
+                 << ( m_format == csv ? ".csv" : ".json" );
+        std::ofstream file(fileName.str());
+        write( file, m_format );
+    }
+    // Communication matrix : bytes sent by each process to each process
+    std::vector<unsigned long long> row(world.size, 0ULL), matrix;
+    for ( const auto& peer : m_peers )
+        if ( peer.first < world.size ) row[peer.first] = peer.second.sentBytes;
+    // Calls, bytes and seconds of each operation on each process
+    std::vector<double> mine(3*nb_operations), all;
+    for ( int op = 0; op < nb_operations; ++op ) {
+        mine[3*op  ] = double(m_counters[op].calls);
+        mine[3*op+1] = double(m_counters[op].bytes);
+        mine[3*op+2] = m_counters[op].seconds;
+    }
+    if ( world.rank == root ) {
+        matrix.resize( std::size_t(world.size)*world.size );
+        all.resize( mine.size()*world.size );
+    }
+    world.gather( row.size(), row.data(), matrix.data(), root );
+    world.gather( mine.size(), mine.data(), all.data(), root );
+    if ( world.rank != root ) return std::string();
+
+    std::ofstream file( m_fileBase + "Matrix.csv" );
+    file << "# bytes sent by the process of the row to the process of the column";
+    for ( int q = 0; q < world.size; ++q ) file << ',' << q;
+    file << '\n';
+    for ( int p = 0; p < world.size; ++p ) {
+        file << p;
+        for ( int q = 0; q < world.size; ++q ) file << ',' << matrix[std::size_t(p)*world.size + q];
+        file << '\n';
+    }
+    std::ostringstream summary;
+    summary << "Communications on " << world.size << " processes ( times in seconds )\n"
+            << std::left << std::setw(11) << "operation" << std::right << std::setw(10) << "calls"
+            << std::setw(14) << "bytes" << std::setw(12) << "min" << std::setw(12) << "mean"
+            << std::setw(12) << "max" << '\n';
+    for ( int op = 0; op < nb_operations; ++op ) {
+        double calls = 0., bytes = 0., minTime = 1.E300, maxTime = 0., sumTime = 0.;
+        for ( int p = 0; p < world.size; ++p ) {
+            const double* counters = all.data() + std::size_t(p)*mine.size() + 3*op;
+            calls  += counters[0];
+            bytes  += counters[1];
+            minTime = std::min( minTime, counters[2] );
+            maxTime = std::max( maxTime, counters[2] );
+            sumTime += counters[2];
+        }
+        if ( calls == 0. ) continue;
+        summary << std::left << std::setw(11) << operation_names[op] << std::right
+                << std::fixed << std::setprecision(0) << std::setw(10) << calls << std::setw(14) << bytes
+                << std::scientific << std::setprecision(3) << std::setw(12) << minTime
+                << std::setw(12) << sumTime/world.size << std::setw(12) << maxTime << '\n';
+    }
+    return summary.str();
+}
+// =====================================================================
+void Profiler::Probe::finish()
+{
+    const int peer = ( m_peer >= 0 ? m_com.worldRank(m_peer) : no_process );
+    if ( m_profiler != nullptr ) {
+        std::chrono::duration<double> elapsed = clock::now() - m_start;
+        m_profiler->record( m_op, peer, m_bytes, elapsed.count() );
+    }
+    if ( m_tracer != nullptr ) m_tracer->end( name(m_op), peer, m_bytes );
+}
@@ -0,0 +1,143 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+# endif
+# include "Parallel/Progress.hpp"
+# include "Parallel/Logger.hpp"
+# include "Parallel/Context.hpp"
+using namespace Parallel;
+
+// =====================================================================
+ProgressEngine::~ProgressEngine()
+{
+    stop();
+}
+// ---------------------------------------------------------------------
+bool ProgressEngine::start( interval_type interval, int cpu )
+{
+    if ( !m_is_allowed ) {
+        LogWarning << "The progress engine needs MPI and the multiple thread support of the context" << std::endl;
+        return false;
+    }
+    if ( m_running ) return false;
+    m_interval = interval;
+    m_running  = true;
+    m_thread   = std::thread( &ProgressEngine::run, this );
+    if ( cpu < 0 ) return true;
+# if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    if ( pthread_setaffinity_np( m_thread.native_handle(), sizeof(cpus), &cpus ) != 0 ) {
+        LogWarning << "The progress engine can't be bound to the core " << cpu << std::endl;
+    }
+# else
+    LogWarning << "The binding of the progress engine isn't available on this system" << std::endl;
+# endif
+    return true;
+}
+// ---------------------------------------------------------------------
+void ProgressEngine::stop()
+{
+    if ( !m_running ) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+    m_done.notify_all();
+}
+// ---------------------------------------------------------------------
+void ProgressEngine::submit( Request&& req, const RequestSet::Callback& callback )
+{
+    ++ m_nb_submitted;
+    if ( req.test() ) {
+        if ( callback ) callback( req.status() );
+        ++ m_nb_completed;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_submitted.emplace_back( std::move(req), callback );
+    }
+    m_wakeup.notify_one();
+}
+// ---------------------------------------------------------------------
+void ProgressEngine::waitAll()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if ( m_running ) {
+        m_done.wait( lock, [this] () { return pending() == 0 || !m_running; } );
+        if ( pending() == 0 ) return;
+    }
+    // The engine isn't started : the calling thread completes the requests
+    takeSubmitted();
+    lock.unlock();
+    m_requests.waitAll();
+    m_requests.clear();
+}
+// ---------------------------------------------------------------------
+int ProgressEngine::addHook( const Hook& hook )
+{
+    std::lock_guard<std::mutex> lock(m_hooks_mutex);
+    m_hooks.emplace( m_next_hook, hook );
+    return m_next_hook++;
+}
+// ---------------------------------------------------------------------
+void ProgressEngine::removeHook( int id )
+{
+    std::lock_guard<std::mutex> lock(m_hooks_mutex);
+    m_hooks.erase(id);
+}
+// ---------------------------------------------------------------------
+void ProgressEngine::takeSubmitted()
+{
+    for ( auto& submitted : m_submitted ) {
+        const RequestSet::Callback callback = submitted.second;
+        m_requests.push_back( std::move(submitted.first), [this, callback] ( const Status& status ) {
+                if ( callback ) callback(status);
+                ++ m_nb_completed;
+            } );
+    }
+    m_submitted.clear();
+}
+// ---------------------------------------------------------------------
+void ProgressEngine::poll()
+{
+    // The set grows until all its requests are completed
+    if ( m_requests.pending() > 0 ) m_requests.testAll();
+    if ( m_requests.pending() == 0 ) m_requests.clear();
+# if defined(USE_MPI)
+    int flag;
+    MPI_Iprobe( MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE );
+# endif
+    std::lock_guard<std::mutex> lock(m_hooks_mutex);
+    for ( auto& hook : m_hooks ) hook.second();
+}
+// ---------------------------------------------------------------------
+void ProgressEngine::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while ( m_running ) {
+        takeSubmitted();
+        lock.unlock();
+        poll();
+        lock.lock();
+        if ( pending() == 0 ) m_done.notify_all();
+        m_wakeup.wait_for( lock, m_interval, [this] () { return !m_running || !m_submitted.empty(); } );
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <algorithm>
+# include <thread>
+# include "Parallel/ThreadGroup.hpp"
+
+#if !defined(USE_MPI)
+using namespace Parallel;
+
+namespace
+{
+    // World and rank of the current thread ( empty for a thread not launched by launch )
+    thread_local std::shared_ptr<ThreadGroup> current_world;
+    thread_local int current_rank = 0;
+
+    bool match( const ThreadGroup::Message& msg, int source, int tag )
+    {
+        return ( (source < 0) || (msg.source == source) ) && ( (tag < 0) || (msg.tag == tag) );
+    }
+}
+// .....................................................................
+ThreadGroup::ThreadGroup( int size ) :
+    m_size(size),
+    m_mailboxes(size),
+    m_episodes(size, 0U),
+    m_slots(size, nullptr)
+{
+    int nbRounds = 0;
+    for ( int dist = 1; dist < size; dist *= 2 ) ++ nbRounds;
+    std::vector<std::atomic<unsigned>>(nbRounds*size).swap(m_flags);
+    for ( auto& flag : m_flags ) flag.store(0U);
+    for ( auto& box : m_mailboxes ) box.incoming.store(nullptr);
+}
+// .....................................................................
+ThreadGroup::~ThreadGroup()
+{
+    for ( auto& box : m_mailboxes ) {
+        Message* msg = box.incoming.load();
+        while ( msg != nullptr ) {
+            Message* next = msg->next;
+            delete msg;
+            msg = next;
+        }
+    }
+}
+// .....................................................................
+void ThreadGroup::post( int dest, std::unique_ptr<Message>&& msg )
+{
+    std::atomic<Message*>& head = m_mailboxes[dest].incoming;
+    Message* pt_msg = msg.release();
+    pt_msg->next = head.load(std::memory_order_relaxed);
+    while ( !head.compare_exchange_weak(pt_msg->next, pt_msg,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed) );
+}
+// .....................................................................
+std::list<std::unique_ptr<ThreadGroup::Message>>::iterator
+ThreadGroup::find( int rank, int source, int tag )
+{
+    Mailbox& box = m_mailboxes[rank];
+    auto found = std::find_if( box.pending.begin(), box.pending.end(),
+                               [=] ( const std::unique_ptr<Message>& msg )
+                               { return match(*msg, source, tag); } );
+    if ( found != box.pending.end() ) return found;
+    // Drain the incoming stack : the messages are in the reverse order of posting
+    Message* msg = box.incoming.exchange(nullptr, std::memory_order_acquire);
+    if ( msg == nullptr ) return found;
+    auto first = box.pending.end();
+    while ( msg != nullptr ) {
+        Message* next = msg->next;
+        first = box.pending.emplace(first, msg);
+        msg = next;
+    }
+    return std::find_if( first, box.pending.end(),
+                         [=] ( const std::unique_ptr<Message>& msg )
+                         { return match(*msg, source, tag); } );
+}
+// .....................................................................
+std::unique_ptr<ThreadGroup::Message> ThreadGroup::take( int rank, int source, int tag )
+{
+    auto found = find( rank, source, tag );
+    if ( found == m_mailboxes[rank].pending.end() ) return nullptr;
+    std::unique_ptr<Message> msg = std::move(*found);
+    m_mailboxes[rank].pending.erase(found);
+    return msg;
+}
+// .....................................................................
+const ThreadGroup::Message* ThreadGroup::peek( int rank, int source, int tag )
+{
+    auto found = find( rank, source, tag );
+    if ( found == m_mailboxes[rank].pending.end() ) return nullptr;
+    return found->get();
+}
+// .....................................................................
+void ThreadGroup::barrier( int rank )
+{
+    // At each round r, the rank signals rank + 2^r and waits the signal of rank - 2^r.
+    // The flags count the signals, so they never need to be reset between two barriers.
+    unsigned episode = ++ m_episodes[rank];
+    for ( int round = 0, dist = 1; dist < m_size; ++ round, dist *= 2 ) {
+        m_flags[round*m_size + (rank+dist)%m_size].fetch_add(1U, std::memory_order_acq_rel);
+        std::atomic<unsigned>& flag = m_flags[round*m_size + rank];
+        while ( flag.load(std::memory_order_acquire) < episode ) std::this_thread::yield();
+    }
+}
+// .....................................................................
+std::shared_ptr<ThreadGroup> ThreadGroup::world()
+{
+    if ( !current_world ) current_world = std::make_shared<ThreadGroup>(1);
+    return current_world;
+}
+// .....................................................................
+int ThreadGroup::worldRank()
+{
+    return current_rank;
+}
+// .....................................................................
+int ThreadGroup::launch( int nbThreads, const std::function<int(int)>& fct )
+{
+    std::shared_ptr<ThreadGroup> world = std::make_shared<ThreadGroup>(nbThreads);
+    auto run = [&world, &fct] ( int rank ) {
+        current_world = world;
+        current_rank  = rank;
+        int ret = fct(rank);
+        current_world.reset();
+        current_rank  = 0;
+        return ret;
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nbThreads-1);
+    for ( int rank = 1; rank < nbThreads; ++ rank )
+        threads.emplace_back(run, rank);
+    int ret = run(0);
+    for ( auto& thread : threads ) thread.join();
+    return ret;
+}
+#endif
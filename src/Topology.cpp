@@ -0,0 +1,95 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Implementation of the communicators with a topology
+# include <cassert>
+# include <functional>
+# include <numeric>
+# include "Parallel/Topology.hpp"
+# if defined(MPI_VERSION)
+#   include "Parallel/Communicator_mpi.tpp"
+# else
+#   include "Parallel/Communicator_stub.tpp"
+# endif
+namespace Parallel
+{
+    CartesianCommunicator::CartesianCommunicator( const Communicator& com, const std::vector<int>& dims,
+                                                  const std::vector<bool>& periods, bool reorder ) :
+        Communicator( new Communicator::Implementation( *com.m_impl,
+                                                        Implementation::dimensions( com.size, dims ),
+                                                        periods, reorder ) )
+    {
+        assert( dims.size() == periods.size() );
+        assert( size == com.size );
+    }
+    // .................................................................
+    CartesianCommunicator::CartesianCommunicator( const CartesianCommunicator& cart,
+                                                  const std::vector<bool>& remainDims ) :
+        Communicator( new Communicator::Implementation( *cart.m_impl, remainDims ) )
+    {
+        assert( int(remainDims.size()) == cart.nbDimensions() );
+    }
+    // .................................................................
+    int CartesianCommunicator::nbDimensions() const
+    {
+        return m_impl->nbDimensions();
+    }
+    // .................................................................
+    std::vector<int> CartesianCommunicator::dimensions() const
+    {
+        std::vector<int> dims, coords;
+        std::vector<bool> prds;
+        m_impl->cartesian( dims, prds, coords );
+        return dims;
+    }
+    // .................................................................
+    std::vector<bool> CartesianCommunicator::periods() const
+    {
+        std::vector<int> dims, coords;
+        std::vector<bool> prds;
+        m_impl->cartesian( dims, prds, coords );
+        return prds;
+    }
+    // .................................................................
+    std::vector<int> CartesianCommunicator::coordinates() const
+    {
+        return m_impl->coordinates( rank );
+    }
+    // .................................................................
+    std::vector<int> CartesianCommunicator::coordinates( int rank ) const
+    {
+        return m_impl->coordinates( rank );
+    }
+    // .................................................................
+    int CartesianCommunicator::rankOf( const std::vector<int>& coords ) const
+    {
+        assert( int(coords.size()) == nbDimensions() );
+        return m_impl->rankOf( coords );
+    }
+    // .................................................................
+    std::pair<int,int> CartesianCommunicator::shift( int direction, int displacement ) const
+    {
+        assert( (direction >= 0) && (direction < nbDimensions()) );
+        return m_impl->shift( direction, displacement );
+    }
+    // .................................................................
+    std::vector<int> CartesianCommunicator::dimensions( int nbProcs, const std::vector<int>& dims )
+    {
+        return Implementation::dimensions( nbProcs, dims );
+    }
+    // =================================================================
+    GraphCommunicator::GraphCommunicator( const Communicator& com, const std::vector<int>& sources,
+                                          const std::vector<int>& destinations, bool reorder ) :
+        Communicator( new Communicator::Implementation( *com.m_impl, sources, destinations, reorder ) )
+    {}
+}
@@ -0,0 +1,138 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+# include <cstdlib>
+# include <fstream>
+# include <iomanip>
+# include <set>
+# include <sstream>
+# include "Parallel/Trace.hpp"
+# include "Parallel/Communicator"
+using namespace Parallel;
+
+// =====================================================================
+Tracer::Tracer() : m_enabled(false), m_layout(per_process), m_fileBase("Trace"),
+                   m_origin(clock::now())
+{
+    const char* layout = std::getenv("PARALLEL_TRACE");
+    if ( layout != nullptr && layout[0] != '\0' )
+        enable( std::string(layout) == "merged" ? merged : per_process );
+}
+// ---------------------------------------------------------------------
+Tracer& Tracer::current()
+{
+# if defined(USE_MPI)
+    static Tracer tracer;
+# else
+    static thread_local Tracer tracer; // One tracer for each simulated process
+# endif
+    return tracer;
+}
+// ---------------------------------------------------------------------
+const char* Tracer::intern( const std::string& name )
+{
+    static std::set<std::string> names;
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.insert(name).first->c_str();
+}
+// ---------------------------------------------------------------------
+void Tracer::enable( layout_type layout, const std::string& fileBase )
+{
+    m_layout   = layout;
+    m_fileBase = fileBase;
+    m_enabled  = true;
+}
+// ---------------------------------------------------------------------
+Tracer::Buffer& Tracer::addBuffer()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_buffers.emplace_back( new Buffer );
+    m_buffers.back()->reserve(1024);
+    return *m_buffers.back();
+}
+// ---------------------------------------------------------------------
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for ( auto& events : m_buffers ) events->clear();
+}
+// ---------------------------------------------------------------------
+std::size_t Tracer::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t nbEvents = 0;
+    for ( const auto& events : m_buffers ) nbEvents += events->size();
+    return nbEvents;
+}
+// ---------------------------------------------------------------------
+void Tracer::write( std::ostream& out, int pid, std::int64_t shift ) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"name\":\"rank " << pid << "\"}},\n"
+        << "{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"sort_index\":" << pid << "}}";
+    // The times are in microseconds with the precision of the nanosecond :
+    out << std::fixed << std::setprecision(3);
+    for ( std::size_t tid = 0; tid < m_buffers.size(); ++tid )
+        for ( const Event& event : *m_buffers[tid] ) {
+            out << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+                << "\",\"pid\":" << pid << ",\"tid\":" << tid
+                << ",\"ts\":" << double(event.time + shift)*1.E-3;
+            if ( event.phase == 'E' && (event.peer >= 0 || event.bytes > 0) ) {
+                out << ",\"args\":{\"bytes\":" << event.bytes;
+                if ( event.peer >= 0 ) out << ",\"peer\":" << event.peer;
+                out << '}';
+            }
+            out << '}';
+        }
+}
+// ---------------------------------------------------------------------
+void Tracer::report()
+{
+    // The communications of the report aren't traced :
+    const bool enabled = m_enabled;
+    m_enabled = false;
+    const Communicator& world = Communicator::world();
+    int anyEnabled, layout;
+    world.allreduce( int(enabled), anyEnabled, Parallel::max );
+    if ( anyEnabled == 0 ) return;
+    world.allreduce( int(enabled && m_layout == merged), layout, Parallel::max );
+    // The end of the barrier is the same instant on all the processes : the times
+    // are taken relative to it, then shifted to be positive on all the processes.
+    world.barrier();
+    const long long sync = now();
+    long long maxSync;
+    world.allreduce( sync, maxSync, Parallel::max );
+    const std::int64_t shift = maxSync - sync;
+
+    std::ostringstream events;
+    if ( enabled ) write( events, world.rank, shift );
+    if ( layout == per_process ) {
+        if ( !enabled ) return;
+        std::ostringstream fileName;
+        fileName << m_fileBase << std::setfill('0') << std::setw(5) << world.rank << ".json";
+        std::ofstream file(fileName.str());
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" << events.str() << "\n]}\n";
+        return;
+    }
+    // One file for all the processes : the events of each process are ended by a separator
+    if ( enabled ) events << ",\n";
+    std::string all;
+    world.gatherv( events.str(), all, 0 );
+    if ( world.rank != 0 ) return;
+    if ( all.size() >= 2 ) all.resize(all.size()-2);
+    std::ofstream file( m_fileBase + ".json" );
+    file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" << all << "\n]}\n";
+}
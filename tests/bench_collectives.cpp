@@ -0,0 +1,80 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Benchmark of the node aware collective operations ( bcast, reduce, allreduce )
+// against the flat ones. Usage : bench_collectives [number of iterations]
+# include <chrono>
+# include <cstdlib>
+# include <functional>
+# include <iomanip>
+# include <iostream>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+
+// Mean time ( in microseconds ) of one call, maximum on all the processes
+double timing( const Parallel::Communicator& com, int nbIter,
+               const std::function<void(const Parallel::Communicator&)>& collective )
+{
+    collective(com); // Warm up
+    com.barrier();
+    auto start = std::chrono::steady_clock::now();
+    for ( int iter = 0; iter < nbIter; ++iter ) collective(com);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    double loc = elapsed.count()/nbIter, glob;
+    com.allreduce(loc, glob, Parallel::max);
+    return glob;
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Communicator com;
+    Parallel::Communicator hcom = com.duplicate();
+    hcom.setHierarchical(true);
+    const int nbIter = ( nargs > 1 ? std::atoi(argv[1]) : 50 );
+    const int root = com.size-1;
+
+    if ( com.rank == 0 ) {
+        std::cout << "# " << com.size << " processes, " << nbIter
+                  << " iterations, mean time by call in microseconds ( flat / node aware )\n"
+                  << "#   doubles         bcast              reduce           allreduce\n";
+    }
+    for ( std::size_t n = 1; n <= (std::size_t(1)<<20); n *= 8 ) {
+        std::vector<double> snd(n, double(com.rank)), rcv(n);
+        auto bcast = [&] ( const Parallel::Communicator& c ) {
+            c.bcast(n, snd.data(), rcv.data(), root);
+        };
+        auto reduce = [&] ( const Parallel::Communicator& c ) {
+            c.reduce(n, snd.data(), rcv.data(), Parallel::sum, root);
+        };
+        auto allreduce = [&] ( const Parallel::Communicator& c ) {
+            c.allreduce(n, snd.data(), rcv.data(), Parallel::sum);
+        };
+        double times[6] = { timing(com, nbIter, bcast),     timing(hcom, nbIter, bcast),
+                            timing(com, nbIter, reduce),    timing(hcom, nbIter, reduce),
+                            timing(com, nbIter, allreduce), timing(hcom, nbIter, allreduce) };
+        if ( com.rank == 0 ) {
+            std::cout << std::setw(11) << n << std::fixed << std::setprecision(1);
+            for ( int i = 0; i < 6; i += 2 )
+                std::cout << std::setw(10) << times[i] << " /" << std::setw(8) << times[i+1];
+            std::cout << std::endl;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,82 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Benchmark of the distributed matrix-matrix product on grids of 1, 4, 9, ... processes
+// Usage : bench_gemm [maximal dimension] [number of iterations]
+# include <chrono>
+# include <cmath>
+# include <cstdlib>
+# include <iomanip>
+# include <iostream>
+# include <map>
+# include "Parallel/Parallel.hpp"
+
+// Mean time ( in seconds ) of one product, maximum on all the processes of the grid
+double timing( const Parallel::CartesianCommunicator& grid, std::size_t dim, int nbIter )
+{
+    Parallel::DistributedMatrix<double> A( grid, dim, dim, [] ( std::size_t i, std::size_t j ) {
+            return 1./(i+j+1.); } );
+    Parallel::DistributedMatrix<double> B( grid, dim, dim, [] ( std::size_t i, std::size_t j ) {
+            return ( i == j ? 2. : 0.5/(i+j+1.) ); } );
+    Parallel::DistributedMatrix<double> C( grid, dim, dim );
+    Parallel::gemm( 1., A, B, 0., C ); // Warm up
+    grid.barrier();
+    auto start = std::chrono::steady_clock::now();
+    for ( int iter = 0; iter < nbIter; ++iter ) Parallel::gemm( 1., A, B, 0., C );
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double loc = elapsed.count()/nbIter, glob;
+    grid.allreduce(loc, glob, Parallel::max);
+    return glob;
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Communicator com;
+    const std::size_t maxDim = ( nargs > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024 );
+    const int nbIter = ( nargs > 2 ? std::atoi(argv[2]) : 3 );
+    const int maxGrid = int(std::sqrt(double(com.size)));
+
+    if ( com.rank == 0 ) {
+        std::cout << "# " << nbIter << " iterations, mean time by product ( SUMMA on a q x q grid )\n"
+                  << "# processes  dimension     time (s)    GFlop/s  efficiency\n";
+    }
+    std::map<std::size_t,double> sequential; // Time on one process for each dimension
+    for ( int q = 1; q <= maxGrid; ++q ) {
+        // The q x q first processes make the grid, the others wait :
+        const bool inGrid = ( com.rank < q*q );
+        Parallel::Communicator sub( com, ( inGrid ? 0 : 1 ), com.rank );
+        if ( inGrid ) {
+            Parallel::CartesianCommunicator grid( sub, {q, q}, {false, false} );
+            for ( std::size_t dim = 128; dim <= maxDim; dim *= 2 ) {
+                double time = timing( grid, dim, nbIter );
+                if ( q == 1 ) sequential[dim] = time;
+                if ( com.rank == 0 ) {
+                    double gflops = 2.*dim*dim*dim/time*1.E-9;
+                    std::cout << std::setw(11) << q*q << std::setw(11) << dim
+                              << std::scientific << std::setprecision(3) << std::setw(13) << time
+                              << std::fixed << std::setprecision(2) << std::setw(11) << gflops
+                              << std::setw(11) << sequential[dim]/(q*q*time) << std::endl;
+                }
+            }
+        }
+        com.barrier();
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,91 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Benchmark of the product of matrices on one process : plain loops against local_gemm
+// Usage : bench_local_gemm [maximal dimension] [number of threads]
+# include <chrono>
+# include <cmath>
+# include <cstdlib>
+# include <iomanip>
+# include <iostream>
+# include "Parallel/Parallel.hpp"
+
+namespace
+{
+    // The product by loops on the coefficients, as it was done before local_gemm
+    void loopProduct( const Parallel::BlockMatrix<double>& A, const Parallel::BlockMatrix<double>& B,
+                      Parallel::BlockMatrix<double>& C )
+    {
+        for ( std::size_t k = 0; k < A.getNCols(); ++k )
+            for ( std::size_t j = 0; j < B.getNCols(); ++j )
+                for ( std::size_t i = 0; i < A.getNRows(); ++i )
+                    C(i, j) += A(i, k)*B(k, j);
+    }
+    // Best time ( in seconds ) of three runs of fct
+    template<typename Function> double timing( Function fct )
+    {
+        double best = 1.E30;
+        for ( int run = 0; run < 3; ++run ) {
+            auto start = std::chrono::steady_clock::now();
+            fct();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min( best, elapsed.count() );
+        }
+        return best;
+    }
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Communicator com;
+    const std::size_t maxDim = ( nargs > 1 ? std::strtoul(argv[1], nullptr, 10) : 1024 );
+    const int nbThreads = ( nargs > 2 ? std::atoi(argv[2]) : Parallel::gemmThreads() );
+
+    if ( com.rank == 0 ) {
+        std::cout << "# Micro kernel " << Parallel::gemmKernel() << ", best time of 3 runs by process\n"
+                  << "# dimension   loops (s)    GFlop/s  gemm 1 thread (s)   GFlop/s  gemm "
+                  << nbThreads << " threads (s)   GFlop/s  max error\n";
+    }
+    for ( std::size_t dim = 64; dim <= maxDim; dim *= 2 ) {
+        Parallel::BlockMatrix<double> A(dim, dim), B(dim, dim), C(dim, dim), Cref(dim, dim);
+        for ( std::size_t j = 0; j < dim; ++j )
+            for ( std::size_t i = 0; i < dim; ++i ) {
+                A(i, j) = 1./(i+j+1.);
+                B(i, j) = std::cos(double(i*j));
+            }
+        double tLoops = timing( [&] () { std::fill(Cref.begin(), Cref.end(), 0.); loopProduct(A, B, Cref); } );
+        double tOne   = timing( [&] () { Parallel::gemm(1., A, B, 0., C, 1); } );
+        double tMany  = timing( [&] () { Parallel::gemm(1., A, B, 0., C, nbThreads); } );
+        double error  = 0.;
+        for ( std::size_t i = 0; i < C.size(); ++i ) error = std::max( error, std::abs(C[i] - Cref[i]) );
+        if ( com.rank == 0 ) {
+            const double flops = 2.E-9*dim*dim*dim;
+            std::cout << std::setw(11) << dim << std::scientific << std::setprecision(3)
+                      << std::setw(12) << tLoops << std::fixed << std::setprecision(2)
+                      << std::setw(11) << flops/tLoops << std::scientific << std::setprecision(3)
+                      << std::setw(19) << tOne << std::fixed << std::setprecision(2)
+                      << std::setw(10) << flops/tOne << std::scientific << std::setprecision(3)
+                      << std::setw(20) << tMany << std::fixed << std::setprecision(2)
+                      << std::setw(10) << flops/tMany << std::scientific << std::setprecision(1)
+                      << std::setw(11) << error << std::endl;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
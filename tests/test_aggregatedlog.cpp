@@ -0,0 +1,85 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the log files shared by groups of processes
+# include <algorithm>
+# include <fstream>
+# include <iomanip>
+# include <iostream>
+# include <sstream>
+# include <string>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+# include "Parallel/LogToAggregatedFile.hpp"
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    Parallel::Communicator com;
+    bool isOK = true;
+    // One file for two processes, small chunks to send during the logging :
+    const int ranksPerWriter = 2;
+    Parallel::LogToAggregatedFile aggregated("AggregatedLog", Parallel::Logger::Listener::Listen_for_trace,
+                                             ranksPerWriter, 256);
+    log.subscribe(&aggregated);
+    isOK &= ( aggregated.isWriter() == (com.rank%ranksPerWriter == 0) );
+    const int nbMessages = 200;
+    for ( int i = 0; i < nbMessages; ++i )
+        LogTrace << "message " << i << std::endl;
+    log.close();
+    log.unsubscribe(&aggregated);
+    if ( aggregated.isWriter() ) {
+        // The lines of each process of the group, in their order :
+        const int first = com.rank, last = std::min(com.rank + ranksPerWriter, com.size);
+        std::vector<int> next(ranksPerWriter, 0);
+        std::ifstream file(aggregated.fileName());
+        std::string line;
+        int nbLines = 0;
+        while ( std::getline(file, line) ) {
+            ++nbLines;
+            std::istringstream fields(line);
+            int rank = -1;
+            fields >> rank;
+            const auto pos = line.rfind("message ");
+            if ( rank < first || rank >= last || pos == std::string::npos ) { isOK = false; break; }
+            isOK &= ( std::stoi(line.substr(pos+8)) == next[rank-first]++ );
+        }
+        isOK &= ( nbLines == nbMessages*(last - first) );
+    }
+    else {
+        // No file created by the other processes :
+        std::ostringstream fileName;
+        fileName << "AggregatedLog" << std::setfill('0') << std::setw(5) << com.rank << ".txt";
+        isOK &= ( fileName.str() != aggregated.fileName() && !std::ifstream(fileName.str()) );
+    }
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,81 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the binary log files
+# include <fstream>
+# include <iomanip>
+# include <iostream>
+# include <sstream>
+# include <string>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+# include "Parallel/LogToBinaryFile.hpp"
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    Parallel::Communicator com;
+    bool isOK = true;
+    // The same messages in a text file and in a binary file :
+    Parallel::LogToFile text("TextLog", Parallel::Logger::Listener::Listen_for_all);
+    Parallel::LogToBinaryFile binary("BinaryLog", Parallel::Logger::Listener::Listen_for_all);
+    log.subscribe(&text);
+    log.subscribe(&binary);
+    const int nbMessages = 100;
+    for ( int i = 0; i < nbMessages; ++i ) {
+        LogWarning << "iteration " << i << " residual " << 1./(i+1) << " size " << std::size_t(i*i) << std::endl;
+        LogTrace << "rank " << com.rank << " char " << 'c' << std::string(" string") << std::endl;
+    }
+    LogInformation << "table\nwith lines\n";
+    log.flush();
+    log.unsubscribe(&text);
+    log.unsubscribe(&binary);
+    binary.flush();
+    text.flush();
+    // The decoded binary file is the text file :
+    std::ostringstream suffix;
+    suffix << std::setfill('0') << std::setw(5) << com.rank;
+    Parallel::LogToBinaryFile::Content content;
+    isOK &= Parallel::LogToBinaryFile::read("BinaryLog" + suffix.str() + ".plog", content);
+    isOK &= ( content.rank == com.rank && content.entries.size() == std::size_t(2*nbMessages + 1) );
+    isOK &= ( content.sites.size() == 4 ); // Empty site and three call sites
+    std::ostringstream decoded;
+    for ( const auto& entry : content.entries )
+        decoded << Parallel::LogToBinaryFile::format(content, entry) << '\n';
+    std::ifstream textFile("TextLog" + suffix.str() + ".txt");
+    std::ostringstream expected;
+    expected << textFile.rdbuf();
+    isOK &= ( decoded.str() == expected.str() );
+    // The binary file is smaller :
+    std::ifstream binaryFile("BinaryLog" + suffix.str() + ".plog", std::ios::binary | std::ios::ate);
+    isOK &= ( std::size_t(binaryFile.tellg()) < expected.str().size()/2 );
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
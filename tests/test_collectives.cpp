@@ -0,0 +1,240 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the collective operations ( allreduce, allgather, gather, scatter, alltoall )
+# include <iostream>
+# include <vector>
+# include <list>
+# include <string>
+# include <thread>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+// Reduction function with a state ( the same type is used with two states ) :
+struct SumModulo
+{
+    int modulo;
+    int operator () ( const int& a, const int& b ) const { return (a+b)%modulo; }
+};
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    if ( nargs > 1 ) {
+      if ( std::string(argv[1]) == std::string("trace") )
+        log.subscribe(new Parallel::LogToFile("Trace",Parallel::Logger::Listener::Listen_for_trace));
+    }
+    Parallel::Communicator com;
+    const int rank = com.rank, size = com.size;
+    bool isOK = true;
+    // Allreduce on a scalar, a container and with a functor :
+    double x = rank + 1., sx;
+    com.allreduce(x, sx, Parallel::sum);
+    isOK &= ( sx == 0.5*size*(size+1) );
+    std::vector<int> v(3, rank), sv;
+    com.allreduce(v, sv, Parallel::max);
+    isOK &= ( sv == std::vector<int>(3, size-1) );
+    int m;
+    com.allreduce(rank, m, [](const int& a, const int& b) { return std::min(a,b); }, true);
+    isOK &= ( m == 0 );
+    // Allgather(v) :
+    std::vector<int> ranks;
+    com.allgather(rank, ranks);
+    for ( int i = 0; i < size; ++i ) isOK &= ( ranks[i] == i );
+    std::vector<int> loc(rank+1, rank), all;
+    std::vector<int> counts;
+    com.allgatherv(loc, all, counts);
+    isOK &= ( all.size() == std::size_t(size*(size+1)/2) );
+    for ( int i = 0, k = 0; i < size; ++i ) {
+        isOK &= ( counts[i] == i+1 );
+        for ( int j = 0; j <= i; ++j, ++k ) isOK &= ( all[k] == i );
+    }
+    // Gather(v) :
+    std::list<double> lst(2, double(rank)), glst;
+    com.gather(lst, glst, 0);
+    if ( rank == 0 ) {
+        isOK &= ( glst.size() == std::size_t(2*size) );
+        int k = 0;
+        for ( auto& val : glst ) isOK &= ( val == double(k++/2) );
+    }
+    std::vector<int> gall;
+    com.gatherv(loc, gall, 0);
+    if ( rank == 0 ) isOK &= ( gall == all );
+    // Scatter(v) :
+    std::vector<int> toScatter;
+    if ( rank == 0 ) {
+        for ( int i = 0; i < size; ++i ) toScatter.push_back(10*i);
+    }
+    int mine;
+    com.scatter(toScatter, mine, 0);
+    isOK &= ( mine == 10*rank );
+    std::vector<int> chunk;
+    com.scatterv(all, counts, chunk, 0);
+    isOK &= ( chunk == loc );
+    // Alltoall(v) :
+    std::vector<int> snd(size), rcv;
+    for ( int i = 0; i < size; ++i ) snd[i] = 100*rank + i;
+    com.alltoall(snd, rcv);
+    for ( int i = 0; i < size; ++i ) isOK &= ( rcv[i] == 100*i + rank );
+    std::vector<int> sndCounts(size), rcvCounts;
+    std::vector<int> sndv;
+    for ( int i = 0; i < size; ++i ) {
+        sndCounts[i] = i+1;
+        for ( int j = 0; j <= i; ++j ) sndv.push_back(rank);
+    }
+    std::vector<int> rcvv;
+    com.alltoallv(sndv, sndCounts, rcvv, rcvCounts);
+    isOK &= ( rcvv.size() == std::size_t(size*(rank+1)) );
+    for ( int i = 0; i < size; ++i ) {
+        isOK &= ( rcvCounts[i] == rank+1 );
+        for ( int j = 0; j <= rank; ++j ) isOK &= ( rcvv[i*(rank+1)+j] == i );
+    }
+    // Non blocking collectives ( the list needs a temporary buffer kept by the request ) :
+    std::list<double> lloc(4, double(rank)), lglob;
+    Parallel::Request r1 = com.iallreduce(lloc, lglob, Parallel::sum);
+    double dsum = 0.;
+    Parallel::Request r2 = com.iallreduce(1, &x, &dsum, Parallel::sum);
+    std::vector<int> iranks;
+    Parallel::Request r3 = com.iallgather(rank, iranks);
+    std::vector<int> ibuf(5, rank);
+    Parallel::Request r4 = ( rank == size-1 ? com.ibcast(ibuf, ibuf, size-1) : com.ibcast(ibuf, size-1) );
+    std::vector<int> irecvd;
+    Parallel::Request r5 = com.ialltoall(snd, irecvd);
+    int rsum = 0;
+    Parallel::Request r6 = com.ireduce(rank, rsum, Parallel::sum, 0);
+    Parallel::Request r7 = com.ibarrier();
+    r1.wait(); r2.wait(); r3.wait(); r4.wait(); r5.wait(); r6.wait(); r7.wait();
+    isOK &= ( lglob == std::list<double>(4, 0.5*size*(size-1)) );
+    isOK &= ( dsum == sx );
+    isOK &= ( iranks == ranks );
+    isOK &= ( ibuf == std::vector<int>(5, size-1) );
+    isOK &= ( irecvd == rcv );
+    if ( rank == 0 ) isOK &= ( rsum == size*(size-1)/2 );
+    // Persistent collectives started several times :
+    std::vector<double> pval(3), psum(3);
+    Parallel::Request p1 = com.allreduce_init(pval.size(), pval.data(), psum.data(), Parallel::sum);
+    std::vector<int> pranks(size);
+    Parallel::Request p2 = com.allgather_init(1, &mine, pranks.data());
+    for ( int iter = 0; iter < 3; ++iter ) {
+        for ( auto& val : pval ) val = double(iter+rank);
+        mine = iter*rank;
+        p1.start(); p2.start();
+        p1.wait(); p2.wait();
+        isOK &= ( psum == std::vector<double>(3, iter*size + 0.5*size*(size-1)) );
+        for ( int i = 0; i < size; ++i ) isOK &= ( pranks[i] == iter*i );
+    }
+    // Node aware collectives ( the root isn't the leader of its node ) :
+    Parallel::Communicator hcom = com.duplicate();
+    hcom.setHierarchical(true);
+    isOK &= hcom.isHierarchical();
+    std::vector<double> hbuf(5, ( rank == size-1 ? 3. : 0. ));
+    hcom.bcast(hbuf, size-1);
+    isOK &= ( hbuf == std::vector<double>(5, 3.) );
+    int hsum = 0;
+    hcom.reduce(rank+1, hsum, Parallel::sum, size-1);
+    if ( rank == size-1 ) isOK &= ( hsum == size*(size+1)/2 );
+    std::vector<int> hloc(4, rank), hmax;
+    hcom.allreduce(hloc, hmax, Parallel::max);
+    isOK &= ( hmax == std::vector<int>(4, size-1) );
+    double hx = rank + 1.;
+    hcom.allreduce(1, &hx, &hx, Parallel::sum);
+    isOK &= ( hx == sx );
+    hcom.setHierarchical(false);
+    isOK &= !hcom.isHierarchical();
+    // Communicator handles : the copies share the communication context of world
+    Parallel::Communicator copy(com), moved(std::move(copy));
+    isOK &= ( copy.size == 0 && moved.rank == rank && moved.size == size );
+    copy = Parallel::Communicator::world();
+    int token = 0;
+    if ( rank == 0 ) copy.bcast(7, token, 0);
+    else copy.bcast(token, 0);
+    isOK &= ( token == 7 && !moved.isHierarchical() );
+    // Segmented broadcast and reduction along a chain and a binary tree :
+    for ( auto pipeline : { Parallel::Communicator::chain, Parallel::Communicator::binary_tree } ) {
+        const std::size_t n = 1000;
+        std::vector<double> seg(n, -1.);
+        if ( rank == size/2 ) for ( std::size_t i = 0; i < n; ++i ) seg[i] = 0.5*i;
+        std::size_t nbReady = 0;
+        bool inOrder = true;
+        com.segmented_bcast(n, seg.data(), seg.data(), size/2, 64, pipeline,
+                            [&] ( std::size_t first, std::size_t count ) {
+                                inOrder &= ( first == nbReady && seg[first+count-1] == 0.5*(first+count-1) );
+                                nbReady += count;
+                            });
+        isOK &= ( inOrder && nbReady == n );
+        for ( std::size_t i = 0; i < n; ++i ) isOK &= ( seg[i] == 0.5*i );
+        std::vector<int> contrib(n), total(n, 0);
+        for ( std::size_t i = 0; i < n; ++i ) contrib[i] = int(i) + rank;
+        nbReady = 0;
+        com.segmented_reduce(n, contrib.data(), total.data(), Parallel::sum, size-1, 100, pipeline,
+                             [&] ( std::size_t, std::size_t count ) { nbReady += count; });
+        if ( rank == size-1 ) {
+            isOK &= ( nbReady == n );
+            for ( std::size_t i = 0; i < n; ++i ) isOK &= ( total[i] == size*int(i) + size*(size-1)/2 );
+        }
+        else isOK &= ( nbReady == 0 );
+#       if defined(USE_MPI)
+        // A non commutative operation ( the left operand, so the result is the contribution
+        // of the process 0 ) gives the result of reduce :
+        auto left = [] ( const int& x, const int& ) { return x; };
+        Parallel::Operator<int, decltype(left)> first(left, false);
+        for ( std::size_t i = 0; i < n; ++i ) contrib[i] = 1000*rank + int(i);
+        nbReady = 0;
+        com.segmented_reduce(n, contrib.data(), total.data(), first.mpi_op(), size-1, 100, pipeline,
+                             [&] ( std::size_t, std::size_t count ) { nbReady += count; });
+        if ( rank == size-1 ) {
+            isOK &= ( nbReady == n );
+            for ( std::size_t i = 0; i < n; ++i ) isOK &= ( total[i] == int(i) );
+        }
+#       endif
+    }
+    // Reductions with the same type of function but distinct states in two threads :
+    if ( context.levelOfThreadSupport() == Parallel::Context::Multiple ) {
+        Parallel::Communicator com2 = com.duplicate();
+        bool isThreadOK = true;
+        std::thread thread([&com2, &isThreadOK, rank, size] () {
+            for ( int iter = 0; iter < 100; ++iter ) {
+                int res;
+                com2.allreduce((rank+iter)%7, res, SumModulo{7}, true);
+                isThreadOK &= ( res == (size*iter + size*(size-1)/2)%7 );
+            }
+        });
+        for ( int iter = 0; iter < 100; ++iter ) {
+            int res;
+            com.allreduce((rank+iter)%1000, res, SumModulo{1000}, true);
+            isOK &= ( res == (size*iter + size*(size-1)/2)%1000 );
+        }
+        thread.join();
+        isOK &= isThreadOK;
+    }
+
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -12,12 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 // Test des communications intra--communicateur
+# include <algorithm>
 # include <iostream>
 # include <cmath>
+# include <vector>
 # include "Parallel/Parallel.hpp"
 # include "Parallel/LogToFile.hpp"
 
-int main( int nargs, char* argv[] )
+int parallel_main( int nargs, char* argv[] )
 {
     Parallel::Context context(nargs, argv);
     Parallel::Logger& log = Parallel::Context::logger;
@@ -71,5 +73,86 @@ int main( int nargs, char* argv[] )
     for ( const auto& t : array )
       log << t << " ";
     log << std::endl;
+
+    // Exchange with the two neighbours, completed with a set of requests :
+    bool isOK = true;
+    std::vector<int> fromLeft(3), fromRight(3), toSend(3, com.rank);
+    int left = (com.rank+com.size-1)%com.size, right = (com.rank+1)%com.size;
+    int nbReceived = 0;
+    std::vector<int> sources(2, Parallel::no_process);
+    auto exchange = [&] ( Parallel::RequestSet& requests, int tag, bool withCallbacks ) {
+        std::fill(fromLeft.begin(), fromLeft.end(), -1);
+        std::fill(fromRight.begin(), fromRight.end(), -1);
+        requests.clear();
+        Parallel::RequestSet::Callback fromLeftDone, fromRightDone;
+        if ( withCallbacks ) {
+            fromLeftDone  = [&] (const Parallel::Status& st) { ++ nbReceived; sources[0] = st.source(); };
+            fromRightDone = [&] (const Parallel::Status& st) { ++ nbReceived; sources[1] = st.source(); };
+        }
+        requests.push_back(com.irecv(fromLeft, left, tag), fromLeftDone);
+        requests.push_back(com.irecv(fromRight, right, tag+1), fromRightDone);
+        requests.push_back(com.isend(toSend, right, tag));
+        requests.push_back(com.isend(toSend, left, tag+1));
+    };
+    auto received = [&] () {
+        return ( fromLeft == std::vector<int>(3, left) ) && ( fromRight == std::vector<int>(3, right) );
+    };
+    Parallel::RequestSet requests(4);
+    // waitAny until a reception is completed, then waitAll ( without callbacks, all
+    // the requests are completed by one call ) : the status of the reception completed
+    // by waitAny is kept
+    exchange(requests, 1, false);
+    int first;
+    do {
+        first = requests.waitAny();
+    } while ( first > 1 );
+    requests.waitAll();
+    isOK &= ( requests.pending() == 0 && nbReceived == 0 && received() );
+    for ( int i = 0; i < 2; ++i ) {
+        isOK &= ( requests.status(i).source() == (i == 0 ? left : right) );
+        isOK &= ( requests.status(i).tag() == 1 + i );
+        isOK &= ( requests.status(i).count<int>() == 3 );
+    }
+    // waitSome until all the requests are completed, the callbacks are called :
+    exchange(requests, 3, true);
+    const std::size_t nbPending = requests.pending(); // Without MPI, the sends are already completed
+    std::size_t nbCompleted = 0;
+    while ( requests.pending() > 0 ) nbCompleted += requests.waitSome().size();
+    isOK &= ( nbPending >= 2 && nbCompleted == nbPending && nbReceived == 2 && received() );
+    isOK &= ( sources[0] == left && sources[1] == right );
+    isOK &= ( requests.status(0).tag() == 3 && requests.status(1).tag() == 4 );
+    // testAll until all the requests are completed :
+    sources.assign(2, Parallel::no_process);
+    exchange(requests, 5, true);
+    while ( !requests.testAll() );
+    isOK &= ( nbReceived == 4 && received() );
+    isOK &= ( sources[0] == left && sources[1] == right );
+    isOK &= ( requests.status(0).source() == left && requests.status(1).source() == right );
+
+    // Same exchange repeated with persistent requests :
+    Parallel::RequestSet persistents(4);
+    persistents.push_back(com.recv_init(fromLeft.size(), fromLeft.data(), left, 7));
+    persistents.push_back(com.recv_init(fromRight.size(), fromRight.data(), right, 8));
+    persistents.push_back(com.send_init(toSend.size(), toSend.data(), right, 7));
+    persistents.push_back(com.send_init(toSend.size(), toSend.data(), left, 8));
+    for ( int iter = 1; iter <= 3; ++iter ) {
+        std::fill(toSend.begin(), toSend.end(), iter*com.rank);
+        persistents.startAll();
+        persistents.waitAll();
+        isOK &= ( fromLeft[0] == iter*left && fromRight[0] == iter*right );
+        isOK &= ( persistents.status(0).source() == left && persistents.status(1).tag() == 8 );
+    }
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
     return EXIT_SUCCESS;
 }
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,109 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the exchanges of structures with derived datatypes and of the std types
+# include <iostream>
+# include <array>
+# include <complex>
+# include <string>
+# include <utility>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+struct Particle
+{
+    double pos[3];
+    char   kind;   // Not exchanged
+    double mass;
+    long long id;
+};
+PARALLEL_MPI_STRUCT(Particle, &Particle::pos, &Particle::mass, &Particle::id)
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    if ( nargs > 1 ) {
+      if ( std::string(argv[1]) == std::string("trace") )
+        log.subscribe(new Parallel::LogToFile("Trace",Parallel::Logger::Listener::Listen_for_trace));
+    }
+    Parallel::Communicator com;
+    const int rank = com.rank, size = com.size;
+    bool isOK = true;
+    // Ring exchange of a vector of structures :
+    std::vector<Particle> particles(4), received(4);
+    for ( int i = 0; i < 4; ++i )
+        particles[i] = Particle{ {double(rank), double(i), 0.}, 'x', 1.5*rank, 1000LL*rank + i };
+    int right = (rank+1)%size, left = (rank+size-1)%size;
+    Parallel::Request req = com.isend(particles, right, 1);
+    com.recv(received, left, 1);
+    req.wait();
+    for ( int i = 0; i < 4; ++i ) {
+        isOK &= ( received[i].pos[0] == double(left) && received[i].pos[1] == double(i) );
+        isOK &= ( received[i].mass == 1.5*left && received[i].id == 1000LL*left + i );
+    }
+    // Contiguous containers other than vectors are exchanged without copy :
+    std::array<int,4> arr{ {rank, rank, rank, rank} }, rcvArr;
+    req = com.isend(arr, right, 2);
+    com.recv(rcvArr, left, 2);
+    req.wait();
+    isOK &= ( rcvArr == std::array<int,4>{ {left, left, left, left} } );
+    std::string word(3, char('a'+rank%26));
+    com.bcast(word, 0);
+    isOK &= ( word == "aaa" );
+    // Reduction of a structure with a user function :
+    Particle heaviest;
+    com.allreduce(particles[0], heaviest,
+                  [](const Particle& a, const Particle& b) { return (a.mass > b.mass ? a : b); }, true);
+    isOK &= ( heaviest.id == 1000LL*(size-1) );
+    // Std types :
+    std::complex<double> z(rank, 1.), sz;
+    com.allreduce(z, sz, Parallel::sum);
+    isOK &= ( sz == std::complex<double>(0.5*size*(size-1), double(size)) );
+    long long big = (1LL << 40) + rank, maxbig;
+    com.allreduce(big, maxbig, Parallel::max);
+    isOK &= ( maxbig == (1LL << 40) + size - 1 );
+    bool flag = (rank == 0), anyFlag;
+    com.allreduce(flag, anyFlag, Parallel::logical_or);
+    isOK &= anyFlag;
+    long double ld = 0.5L, sld;
+    com.allreduce(ld, sld, Parallel::sum);
+    isOK &= ( sld == 0.5L*size );
+    std::vector<std::array<double,3>> coords(2, std::array<double,3>{ {1., 2., double(rank)} }), scoords;
+    com.allreduce(coords, scoords, [](const std::array<double,3>& a, const std::array<double,3>& b) {
+                      return std::array<double,3>{ {a[0]+b[0], a[1]+b[1], a[2]+b[2]} }; }, true);
+    isOK &= ( scoords[1][0] == double(size) && scoords[1][2] == 0.5*size*(size-1) );
+    std::vector<std::pair<int,double>> gathered;
+    com.allgather(std::make_pair(rank, 0.25*rank), gathered);
+    for ( int i = 0; i < size; ++i ) isOK &= ( gathered[i] == std::make_pair(i, 0.25*i) );
+
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,106 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the messages larger than 2^31 bytes between two processes
+// Usage : test_largecount [number of bytes] ( by default 2^31 + 4099 bytes )
+# include <algorithm>
+# include <cstdlib>
+# include <iostream>
+# include <string>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+namespace
+{
+    // A structure exchanged as bytes
+    struct Triplet
+    {
+        unsigned char a, b, c;
+    };
+
+    bool check( const std::vector<unsigned char>& buffer, int shift )
+    {
+        for ( std::size_t i = 0; i < buffer.size(); ++i )
+            if ( buffer[i] != (unsigned char)((i + shift)%251) ) return false;
+        return true;
+    }
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    std::size_t nbBytes = (std::size_t(1) << 31) + 4099;
+    if ( nargs > 1 ) nbBytes = std::strtoull(argv[1], nullptr, 10);
+    Parallel::Communicator world;
+    // Only the two first processes exchange the messages :
+    Parallel::Communicator com(world, ( world.rank < 2 ? 0 : 1 ), world.rank);
+    if ( world.rank >= 2 ) return EXIT_SUCCESS;
+    const int rank = com.rank, other = ( com.size > 1 ? 1 - rank : rank );
+    bool isOK = true;
+    // One buffer per process to keep the memory footprint low :
+    std::vector<unsigned char> buffer(nbBytes);
+    for ( std::size_t i = 0; i < nbBytes; ++i ) buffer[i] = (unsigned char)((i + rank)%251);
+    // Container sent by the first process and received by the other ( the size is probed ) :
+    if ( com.size > 1 ) {
+        if ( rank == 0 ) com.send(buffer, other, 101);
+        else {
+            com.recv(buffer, other, 101);
+            isOK &= ( buffer.size() == nbBytes && check(buffer, 0) );
+            for ( std::size_t i = 0; i < nbBytes; ++i ) buffer[i] = (unsigned char)((i + 2)%251);
+        }
+        // Non blocking exchange of the buffer in the other direction :
+        Parallel::Request req = ( rank == 1 ? com.isend(nbBytes, buffer.data(), other, 102)
+                                            : com.irecv(nbBytes, buffer.data(), other, 102) );
+        req.wait();
+        isOK &= check(buffer, 2);
+    }
+    else
+        for ( std::size_t i = 0; i < nbBytes; ++i ) buffer[i] = (unsigned char)((i + 2)%251);
+    // Broadcast of the buffer from the last process, seen as packed structures :
+    if ( rank == com.size - 1 )
+        for ( std::size_t i = 0; i < nbBytes; ++i ) buffer[i] = (unsigned char)((i + 3)%251);
+    Triplet* triplets = reinterpret_cast<Triplet*>(buffer.data());
+    com.bcast(nbBytes/3, triplets, triplets, com.size - 1);
+    com.bcast(nbBytes%3, buffer.data() + 3*(nbBytes/3), buffer.data() + 3*(nbBytes/3), com.size - 1);
+    isOK &= check(buffer, 3);
+    // Reduction in place ( by chunks ) :
+    for ( std::size_t i = 0; i < nbBytes; i += 4096 ) buffer[i] = (unsigned char)(rank + 1);
+    com.reduce(nbBytes, buffer.data(), buffer.data(), Parallel::max, 0);
+    if ( rank == 0 ) {
+        bool isReduced = true;
+        for ( std::size_t i = 0; i < nbBytes; ++i )
+            isReduced &= ( buffer[i] == ( i%4096 == 0 ? (unsigned char)com.size
+                                                      : (unsigned char)((i + 3)%251) ) );
+        isOK &= isReduced;
+    }
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,82 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the product of matrices on one process ( blocked kernels and threads )
+# include <cmath>
+# include <iostream>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+namespace
+{
+    // Compare local_gemm with the plain product on sub-matrices of larger arrays ( lda > m )
+    template<typename K> bool
+    checkProduct( std::size_t m, std::size_t n, std::size_t k, int nbThreads, double tolerance )
+    {
+        const std::size_t lda = m + 3, ldb = k + 1, ldc = m + 5;
+        std::vector<K> A(lda*k), B(ldb*n), C(ldc*n), Cref;
+        for ( std::size_t i = 0; i < A.size(); ++i ) A[i] = K( (i*7)%13 ) - K(6);
+        for ( std::size_t i = 0; i < B.size(); ++i ) B[i] = K( (i*5)%11 ) - K(5);
+        for ( std::size_t i = 0; i < C.size(); ++i ) C[i] = K( i%3 );
+        Cref = C;
+        for ( std::size_t j = 0; j < n; ++j )
+            for ( std::size_t l = 0; l < k; ++l )
+                for ( std::size_t i = 0; i < m; ++i )
+                    Cref[i + j*ldc] += K(2)*A[i + l*lda]*B[l + j*ldb];
+        Parallel::local_gemm( m, n, k, K(2), A.data(), lda, B.data(), ldb, C.data(), ldc, nbThreads );
+        // The coefficients outside the sub-matrix of C must be unchanged :
+        for ( std::size_t i = 0; i < C.size(); ++i )
+            if ( std::abs( double(C[i]) - double(Cref[i]) ) > tolerance*( 1. + std::abs(double(Cref[i])) ) )
+                return false;
+        return true;
+    }
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    bool isOK = true;
+    LogInformation << "Micro kernel : " << Parallel::gemmKernel() << std::endl;
+    // Dimensions smaller than the micro kernels, not multiple of the blocks, larger than the blocks :
+    const std::size_t dims[][3] = { {1, 1, 1}, {3, 5, 2}, {17, 13, 29}, {130, 70, 300}, {257, 131, 517} };
+    for ( const auto& d : dims )
+        for ( int nbThreads : { 1, 3 } ) {
+            isOK &= checkProduct<double>( d[0], d[1], d[2], nbThreads, 1.E-12 );
+            isOK &= checkProduct<float>( d[0], d[1], d[2], nbThreads, 1.E-5 );
+            isOK &= checkProduct<long>( d[0], d[1], d[2], nbThreads, 0. );
+        }
+    // Product of blocks with beta :
+    Parallel::BlockMatrix<double> A(5, 4, 1.), B(4, 3, 2.), C(5, 3, 1.);
+    Parallel::gemm( 0.5, A, B, 3., C );
+    for ( double coef : C ) isOK &= ( coef == 7. );
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
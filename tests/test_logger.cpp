@@ -0,0 +1,133 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the asynchronous mode of the logger
+# include <fstream>
+# include <iomanip>
+# include <iostream>
+# include <sstream>
+# include <string>
+# include <thread>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+namespace
+{
+    // Log nbMessages messages from nbThreads threads at the same time
+    void logFromThreads( Parallel::Logger& log, int nbThreads, int nbMessages )
+    {
+        std::vector<std::thread> threads;
+        for ( int t = 0; t < nbThreads; ++t )
+            threads.emplace_back( [&log, t, nbMessages] () {
+                for ( int i = 0; i < nbMessages; ++i )
+                    log[Parallel::Logger::INFORMATION] << "thread " << t << " message " << i
+                                                       << " end" << std::endl;
+            } );
+        for ( auto& thread : threads ) thread.join();
+    }
+    // Count the lines of the file, false if a line isn't a whole message
+    bool checkLines( const std::string& fileName, std::size_t& nbMessages, std::size_t& nbWarnings )
+    {
+        std::ifstream file(fileName);
+        std::string line;
+        nbMessages = nbWarnings = 0;
+        while ( std::getline(file, line) ) {
+            if ( line.find("messages dropped") != std::string::npos ) { ++nbWarnings; continue; }
+            std::istringstream words(line);
+            std::string thread, message, end;
+            int t = -1, i = -1;
+            words >> thread >> t >> message >> i >> end;
+            if ( thread != "thread" || message != "message" || end != "end" || !words.eof() ) return false;
+            ++nbMessages;
+        }
+        return true;
+    }
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    Parallel::Communicator com;
+    bool isOK = true;
+    const int nbThreads = 4, nbMessages = 1000;
+    std::ostringstream fileName;
+    // Blocking policy : all the messages are written, without interleaving
+    {
+        Parallel::Logger async;
+        Parallel::LogToFile file("AsyncOutput", listeners);
+        async.subscribe(&file);
+        async.setAsynchronous(true, 64);
+        isOK &= async.isAsynchronous();
+        logFromThreads(async, nbThreads, nbMessages);
+        async.flush();
+        fileName << "AsyncOutput" << std::setfill('0') << std::setw(5) << com.rank << ".txt";
+        std::size_t nbLines, nbWarnings;
+        isOK &= checkLines(fileName.str(), nbLines, nbWarnings);
+        isOK &= ( nbLines == std::size_t(nbThreads*nbMessages) && nbWarnings == 0 );
+        isOK &= ( async.dropped() == 0 );
+        async.setAsynchronous(false);
+        async.unsubscribe(&file);
+    }
+    // Dropping policy : the lost messages are counted
+    {
+        Parallel::Logger async;
+        Parallel::LogToFile file("AsyncOutput", listeners);
+        async.subscribe(&file);
+        async.setAsynchronous(true, 2, Parallel::Logger::drop_when_full);
+        logFromThreads(async, nbThreads, nbMessages);
+        async.flush();
+        const std::size_t dropped = async.dropped();
+        async.setAsynchronous(false);
+        std::size_t nbLines, nbWarnings;
+        isOK &= checkLines(fileName.str(), nbLines, nbWarnings);
+        isOK &= ( nbLines + dropped == std::size_t(nbThreads*nbMessages) );
+        isOK &= ( (dropped == 0) == (nbWarnings == 0) );
+        async.unsubscribe(&file);
+    }
+    // The arguments of the messages reported by no listener aren't evaluated :
+    int nbEvaluations = 0;
+    auto evaluate = [&nbEvaluations] () { return ++nbEvaluations; };
+    isOK &= !log.wants(Parallel::Logger::TRACE) && log.wants(Parallel::Logger::ERROR);
+    LogTrace << "never formatted " << evaluate() << std::endl;
+    LogAssert( com.size > 0 ) << "not failed " << evaluate() << std::endl;
+    isOK &= ( nbEvaluations == 0 );
+# if PARALLEL_LOG_LEVEL >= PARALLEL_LOG_WARNING
+    LogWarning << "formatted " << evaluate() << std::endl;
+    isOK &= ( nbEvaluations == 1 );
+    // A log statement can be the body of an if without braces :
+    bool elseTaken = false;
+    if ( com.size > 0 ) LogWarning << "formatted " << evaluate() << std::endl;
+    else elseTaken = true;
+    isOK &= ( nbEvaluations == 2 ) && !elseTaken;
+# endif
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,128 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the memory shared by the processes of a node and of the one-sided communications
+# include <algorithm>
+# include <array>
+# include <iostream>
+# include <string>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    if ( nargs > 1 ) {
+      if ( std::string(argv[1]) == std::string("trace") )
+        log.subscribe(new Parallel::LogToFile("Trace",Parallel::Logger::Listener::Listen_for_trace));
+    }
+    Parallel::Communicator com;
+    bool isOK = true;
+    {
+        // The owner of each node fills the array, the others read it :
+        const std::size_t n = 1000;
+        Parallel::SharedArray<double> table(com, n);
+        const Parallel::Communicator& node = table.nodeCommunicator();
+        isOK &= ( table.size() == n );
+        isOK &= ( table.isOwner() == (node.rank == 0) );
+        if ( table.isOwner() )
+            for ( std::size_t i = 0; i < n; ++i ) table[i] = 0.5*i;
+        table.fence();
+        for ( std::size_t i = 0; i < n; ++i ) isOK &= ( table[i] == 0.5*i );
+        table.fence();
+        // Each process of the node writes its own part and reads the parts of the others :
+        Parallel::SharedArray<int> ranks(com, std::size_t(node.size));
+        ranks[node.rank] = com.rank;
+        ranks.fence();
+        int nbProcs = 0;
+        for ( int p = 0; p < node.size; ++p ) nbProcs += ( ranks[p] >= 0 && ranks[p] < com.size );
+        isOK &= ( nbProcs == node.size );
+        // The nodes share out all the processes :
+        int total;
+        com.allreduce(table.isOwner() ? node.size : 0, total, Parallel::sum);
+        isOK &= ( total == com.size );
+    }
+    {
+        const int rank = com.rank, size = com.size;
+        const int right = (rank+1)%size, left = (rank+size-1)%size;
+        // Active target : put and get between two fences
+        Parallel::Window<int> win(com, 4);
+        for ( int& val : win ) val = -1;
+        win.fence();
+        win.put(rank, right, 0);
+        win.fence();
+        isOK &= ( win[0] == left );
+        int value;
+        win.get(value, left, 0);
+        win.accumulate(rank, 0, 1, Parallel::sum);
+        win.fence();
+        isOK &= ( value == (left+size-1)%size );
+        if ( rank == 0 ) isOK &= ( win[1] == size*(size-1)/2 - 1 );
+        // Passive target : atomic operations on rank 0
+        win.lock_all();
+        int ticket = win.fetch_and_op(1, 0, 2, Parallel::sum);
+        win.unlock_all();
+        win.lock(0, true);
+        int previous = win.compare_and_swap(rank, -1, 0, 3);
+        win.unlock(0);
+        win.fence();
+        std::vector<int> tickets;
+        com.allgather(ticket, tickets);
+        std::sort(tickets.begin(), tickets.end());
+        for ( int p = 0; p < size; ++p ) isOK &= ( tickets[p] == p - 1 );
+        int nbWinners;
+        com.allreduce(previous == -1 ? 1 : 0, nbWinners, Parallel::sum);
+        isOK &= ( nbWinners == 1 );
+        if ( rank == 0 ) isOK &= ( win[2] == size - 1 );
+        win.lock(0);
+        isOK &= ( win.fetch_and_op(0, 0, 3, Parallel::no_op) == win.compare_and_swap(0, -2, 0, 3) );
+        win.unlock(0);
+        win.fence();
+        // Window on an existing buffer with containers :
+        std::vector<double> buffer(3, double(rank));
+        {
+            Parallel::Window<double> wbuf(com, buffer.size(), buffer.data());
+            std::vector<double> remote(3);
+            wbuf.lock(left);
+            wbuf.get(remote, left, 0);
+            wbuf.flush(left);
+            wbuf.unlock(left);
+            isOK &= ( remote == std::vector<double>(3, double(left)) );
+            wbuf.fence();
+            std::array<double,2> contrib{ {1., 2.} };
+            wbuf.accumulate(contrib, right, 1, Parallel::sum);
+            wbuf.fence();
+        }
+        isOK &= ( buffer[0] == double(rank) && buffer[1] == rank + 1. && buffer[2] == rank + 2. );
+    }
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -21,43 +21,6 @@
 # include "Parallel/Parallel.hpp"
 # include "Parallel/LogToFile.hpp"
 
-template<typename K>
-class BlockMatrix : public std::vector<K>
-{
-public:
-    BlockMatrix() = default;
-    BlockMatrix( std::size_t nrows, std::size_t ncols ) :
-        std::vector<K>(nrows*ncols),
-        m_nrows(nrows), m_ncols(ncols)
-    {}
-    BlockMatrix( std::size_t nrows, std::size_t ncols, const K& val ) :
-        std::vector<K>(nrows*ncols, val),
-        m_nrows(nrows), m_ncols(ncols)
-    {}
-    BlockMatrix( const BlockMatrix& A ) = default;
-    BlockMatrix( BlockMatrix&& A ) = default;
-    ~BlockMatrix() = default;
-  
-    BlockMatrix& operator = ( const BlockMatrix& A )  = default;
-    BlockMatrix& operator = ( BlockMatrix&& A ) = default;
-  
-    std::size_t getNRows() const { return m_nrows; }
-    std::size_t getNCols() const { return m_ncols; }
-
-    const K& operator () ( std::size_t i, std::size_t j ) const {
-      assert(i<m_nrows);
-      assert(j<m_ncols);
-      return (*this)[i + j*m_nrows];
-    }
-    K& operator () ( std::size_t i, std::size_t j ) {
-      assert(i<m_nrows);
-      assert(j<m_ncols);
-      return (*this)[i + j*m_nrows];
-    }
-private:
-    std::size_t m_nrows, m_ncols;
-};
-
 /*
  * Compute two pairs of vectors. Each pair of vectors define a tensor product to
  * compute respectivly the coefficients of the A and B matrices.
@@ -79,38 +42,6 @@ private:
     return std::make_tuple(u1_r,v1_c,u2_r, v2_c );
 }
 // -----------------------------------------------------------------------------
-/*
- * Compute a matrix block with the tensor product of a pair of vectors :
- */
-template<typename K>
-auto computeMatrice( const std::vector<K>& u_row, const std::vector<K>& v_col )
-{
-    BlockMatrix<K> A( u_row.size(), v_col.size() );
-    for ( std::size_t irow = 0; irow < u_row.size(); ++irow ) {
-        for ( std::size_t jcol = 0; jcol < v_col.size(); ++jcol ) {
-            A(irow, jcol) = u_row[irow] * v_col[jcol];
-        }
-    }
-    return A;
-}
-// -----------------------------------------------------------------------------
-/*
- * Product of two block matrices A  and B  which is added to a third block matrix C
- */
-template<typename K>
-void prodMatrixMatrixBloc( const BlockMatrix<K>& A, const BlockMatrix<K>& B,
-                           BlockMatrix<K>& C )
-{
-    assert( A.getNCols() == B.getNRows() );
-    for ( std::size_t k = 0; k < A.getNCols(); ++k ) {
-        for ( std::size_t j = 0; j < B.getNCols(); ++j ) {
-            for ( std::size_t i = 0; i < A.getNRows(); ++i ) {
-                C(i,j) += A(i,k) * B(k,j);
-            }
-        }
-    }
-}
-// -----------------------------------------------------------------------------
 /*
  * Dot product of two local vectors ( not a global dot product ! )
  */
@@ -134,7 +65,7 @@ dotProduct( const std::vector<K>& u, const std::vector<K>& v )
 template<typename K>
 bool verifyProdMatMat( std::size_t dimBlock, const K& alpha,
                        const std::vector<K>& uA, const std::vector<K>& vB,
-                       const BlockMatrix<K>& C )
+                       const Parallel::BlockMatrix<K>& C )
 {
     bool isOK = true;
     for ( std::size_t i  = 0; i < dimBlock; ++i )
@@ -154,7 +85,7 @@ bool verifyProdMatMat( std::size_t dimBlock, const K& alpha,
 }
 // _____________________________________________________________________________
 // =============================================================================
-int main( int nargs, char* argv[] )
+int parallel_main( int nargs, char* argv[] )
 {
     Parallel::Context context(nargs, argv);
     Parallel::Logger& log = Parallel::Context::logger;
@@ -172,42 +103,55 @@ int main( int nargs, char* argv[] )
     if ( nargs > 1 )
         dim = std::stoul(std::string(argv[1]));
     Parallel::Communicator globCom;
-    // Prepare the parallel computation :
+    // Prepare the parallel computation on a periodic grid of p x p processes :
     int p = int(std::sqrt(globCom.size));
     std::size_t dim_block = dim/p;
-    int IBlock = globCom.rank % p;
-    int JBlock = globCom.rank / p;
-    std::size_t begRow = IBlock*dim_block;
-    std::size_t begCol = JBlock*dim_block;
+    Parallel::CartesianCommunicator grid( globCom, {p, p}, {true, true}, true );
+    // A = u1 x v1^{T} and B = u2 x v2^{T} :
+    const double pi = std::acos(-1.);
+    Parallel::DistributedMatrix<double> A( grid, dim, dim, [dim, pi] ( std::size_t i, std::size_t j ) {
+            return std::cos( 2*i*pi/dim ) * std::sin( 2*j*pi/dim );
+        } );
+    Parallel::DistributedMatrix<double> B( grid, dim, dim, [dim] ( std::size_t i, std::size_t j ) {
+            return (i*1./dim) * (j*2./dim);
+        } );
+    Parallel::DistributedMatrix<double> C( grid, dim, dim );
+    std::size_t begRow = C.beginRow();
+    std::size_t begCol = C.beginCol();
     LogInformation << "Number of blocks per direction " << p << std::endl
                    << "Dimension of each block : " << dim_block << std::endl
-                   << "Indice of C block : " << IBlock << " : " << JBlock << std::endl
                    << "Beginning of the row and column indices : " << begRow
                    << ", " << begCol << std::endl;
-    Parallel::Communicator rowCom( globCom, IBlock, JBlock );
-    Parallel::Communicator colCom( globCom, JBlock, IBlock );
+    const Parallel::CartesianCommunicator& rowCom = C.rowCommunicator();
     assert( rowCom.size == p );
-    assert( rowCom.rank == JBlock );
-    assert( colCom.size == p );
-    assert( colCom.rank == IBlock );
+    assert( C.colCommunicator().size == p );
+    assert( C.block().getNRows() == dim_block && C.block().getNCols() == dim_block );
 
     std::vector<double> uA, vA, uB, vB;
     std::tie(uA,vA,uB,vB) = computeTensorVectors<double>( dim, dim_block,
                                                           begRow, begCol );
-    auto A = computeMatrice( uA, vA );
-    auto B = computeMatrice( uB, vB );
-    BlockMatrix<double> C( A.getNRows(), B.getNCols() );
-    // Parallel product :
-    BlockMatrix<double> Atmp(dim_block, dim_block), Btmp(dim_block,dim_block);
-
-    for ( int kBlock = 0; kBlock < p; ++kBlock ) {
-        rowCom.bcast( A, Atmp, kBlock );
-        colCom.bcast( B, Btmp, kBlock );
-        prodMatrixMatrixBloc(Atmp, Btmp, C);
-    }
+    // Parallel product ( SUMMA ) :
+    Parallel::gemm( 1., A, B, 0., C );
     std::tie(std::ignore,vA,uB,std::ignore) = computeTensorVectors<double>( dim,dim,0, 0 );
     double vAdotuB = dotProduct( vA, uB );
-    if ( verifyProdMatMat( dim_block, vAdotuB, uA, vB, C ) ) {
+    bool isOK = verifyProdMatMat( dim_block, vAdotuB, uA, vB, C.block() );
+    // Exchange of the first row of C with the neighbours in the row communicator :
+    int left, right;
+    std::tie(left, right) = rowCom.shift(0);
+    Parallel::BlockMatrix<double> Crow( dim_block, dim_block, 0. );
+    auto rcvRow = Crow.row(0);
+    Parallel::Request req = rowCom.isend( C.block().row(0), left );
+    rowCom.recv( rcvRow, right );
+    req.wait();
+    std::vector<double> vBright;
+    std::tie(std::ignore,std::ignore,std::ignore,vBright) =
+        computeTensorVectors<double>( dim, dim_block, begRow, right*dim_block );
+    for ( std::size_t j = 0; j < dim_block; ++j ) {
+        double val = vAdotuB*uA[0]*vBright[j];
+        if ( std::abs(val-Crow(0,j)) > 1.E-6*std::abs(val) ) isOK = false;
+        if ( (Crow.getNRows() > 1) && (Crow(1,j) != 0.) ) isOK = false;
+    }
+    if ( isOK ) {
       LogInformation << "Test passed." << std::endl;
     }
     else {
@@ -215,3 +159,9 @@ int main( int nargs, char* argv[] )
     }
     return EXIT_SUCCESS;
 }
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
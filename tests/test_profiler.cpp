@@ -0,0 +1,91 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the profiling of the communications
+# include <fstream>
+# include <iostream>
+# include <string>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    Parallel::Communicator com;
+    Parallel::Profiler& profiler = Parallel::Profiler::current();
+    bool isOK = true;
+    // Nothing is recorded before the profiler is enabled :
+    com.barrier();
+    isOK &= ( profiler.counters(Parallel::Profiler::barrier).calls == 0 );
+    profiler.enable(Parallel::Profiler::json, "TestProfile");
+    // Ring in a communicator with the ranks in reverse order : the peers are given by world rank
+    Parallel::Communicator reversed(com, 0, com.size - com.rank);
+    const int next = (reversed.rank + 1)%reversed.size, prev = (reversed.rank + reversed.size - 1)%reversed.size;
+    std::vector<double> values(100, double(com.rank)), received;
+    Parallel::Request req = reversed.isend(values, next, 7);
+    reversed.recv(received, prev, 7);
+    req.wait();
+    isOK &= ( received.size() == 100 );
+    const int worldNext = (com.rank + com.size - 1)%com.size, worldPrev = (com.rank + 1)%com.size;
+    isOK &= ( reversed.worldRank(next) == worldNext && reversed.worldRank(prev) == worldPrev );
+    const Parallel::Profiler::Counters& isends = profiler.counters(Parallel::Profiler::isend);
+    isOK &= ( isends.calls == 1 && isends.bytes == 800 && isends.histogram[10] == 1 );
+    isOK &= ( profiler.counters(Parallel::Profiler::recv).bytes == 800 );
+    isOK &= ( profiler.peers().at(worldNext).sentBytes == 800 );
+    isOK &= ( profiler.peers().at(worldPrev).receivedBytes == 800 );
+    // Collective operations :
+    int token = ( com.rank == 0 ? 42 : 0 ), sum;
+    com.bcast(1, &token, &token, 0);
+    com.allreduce(com.rank, sum, Parallel::sum);
+    com.barrier();
+    isOK &= ( profiler.counters(Parallel::Profiler::bcast).calls == 1 );
+    isOK &= ( profiler.counters(Parallel::Profiler::allreduce).bytes == sizeof(int) );
+    isOK &= ( profiler.counters(Parallel::Profiler::barrier).calls == 1 );
+    // Files and summary :
+    std::string summary = profiler.report();
+    isOK &= !profiler.isEnabled();
+    if ( com.rank == 0 ) {
+        isOK &= ( summary.find("isend") != std::string::npos );
+        std::ifstream matrix("TestProfileMatrix.csv");
+        std::string header, row;
+        std::getline(matrix, header);
+        std::getline(matrix, row);
+        // The process 0 sent 800 bytes to the last process :
+        std::string expected("0");
+        for ( int q = 0; q < com.size; ++q ) expected += ( q == com.size - 1 ? ",800" : ",0" );
+        isOK &= ( row == expected );
+        LogInformation << summary;
+    }
+    else
+        isOK &= summary.empty();
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
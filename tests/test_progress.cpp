@@ -0,0 +1,100 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the progress engine
+# include <atomic>
+# include <chrono>
+# include <iostream>
+# include <thread>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+namespace
+{
+    // Exchange of values with the neighbours in a ring, completed by the engine
+    void exchange( Parallel::ProgressEngine& engine, const Parallel::Communicator& com, int tag,
+                   std::atomic<int>& nbCompleted, std::vector<double>& values, std::vector<double>& received )
+    {
+        const int next = (com.rank + 1)%com.size, prev = (com.rank + com.size - 1)%com.size;
+        values.assign(1000, double(com.rank));
+        received.assign(1000, -1.);
+        auto count = [&nbCompleted] ( const Parallel::Status& ) { ++nbCompleted; };
+        engine.submit( com.irecv(received, prev, tag), count );
+        engine.submit( com.isend(values, next, tag), count );
+    }
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    Parallel::Communicator com;
+    Parallel::ProgressEngine& engine = context.progress();
+    const int prev = (com.rank + com.size - 1)%com.size;
+    bool isOK = true;
+    std::atomic<int> nbCompleted(0);
+    std::vector<double> values, received;
+#   if defined(USE_MPI)
+    // Already started if PARALLEL_PROGRESS is set :
+    if ( !engine.isRunning() ) isOK &= engine.start( std::chrono::microseconds(50) );
+    isOK &= engine.isRunning() && !engine.start();
+    // The requests are completed while the process "computes" :
+    exchange( engine, com, 11, nbCompleted, values, received );
+    auto limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ( engine.pending() > 0 && std::chrono::steady_clock::now() < limit )
+        std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+    isOK &= ( engine.pending() == 0 && nbCompleted == 2 );
+    isOK &= ( received == std::vector<double>(1000, double(prev)) );
+    // The hooks are called at each poll until their removal :
+    std::atomic<int> nbCalls(0);
+    int hook = engine.addHook( [&nbCalls] () { ++nbCalls; } );
+    limit = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ( nbCalls < 3 && std::chrono::steady_clock::now() < limit )
+        std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+    engine.removeHook(hook);
+    const int nbCallsAtRemoval = nbCalls;
+    std::this_thread::sleep_for( std::chrono::milliseconds(5) );
+    isOK &= ( nbCallsAtRemoval >= 3 && nbCalls == nbCallsAtRemoval );
+    com.barrier();
+    engine.stop();
+#   else
+    // Without MPI, the engine can't be started :
+    isOK &= !engine.start();
+#   endif
+    // Without the thread, waitAll completes the requests :
+    isOK &= !engine.isRunning();
+    const int nbCompletedBefore = nbCompleted;
+    exchange( engine, com, 12, nbCompleted, values, received );
+    engine.waitAll();
+    isOK &= ( engine.pending() == 0 && nbCompleted == nbCompletedBefore + 2 );
+    isOK &= ( received == std::vector<double>(1000, double(prev)) );
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
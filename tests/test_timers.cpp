@@ -0,0 +1,84 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the timers of regions and of their statistics on the processes
+# include <chrono>
+# include <iostream>
+# include <string>
+# include <thread>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+namespace
+{
+    void work( int milliseconds )
+    {
+        TimeRegion("work");
+        std::this_thread::sleep_for( std::chrono::milliseconds(milliseconds) );
+    }
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    Parallel::Communicator com;
+    bool isOK = true;
+    Parallel::TimerLog timers;
+    isOK &= ( timers.empty() && timers.report(com).empty() );
+    // The last process works more than the others :
+    {
+        Parallel::TimerLog::Scope solver(timers, "solver");
+        for ( int it = 0; it < 3; ++it ) {
+            Parallel::TimerLog::Scope step(timers, "step");
+            std::this_thread::sleep_for( std::chrono::milliseconds( com.rank == com.size-1 ? 20 : 5 ) );
+        }
+        // Same name at another address :
+        std::string name("step");
+        Parallel::TimerLog::Scope step(timers, name.c_str());
+    }
+    isOK &= ( timers.calls("solver") == 1 && timers.calls("solver/step") == 4 && timers.calls("step") == 0 );
+    isOK &= ( timers.seconds("solver/step") >= 0.015 && timers.seconds("solver") >= timers.seconds("solver/step") );
+    std::string table = timers.report(com);
+    if ( com.rank == 0 ) {
+        isOK &= ( table.find("solver") != std::string::npos );
+        isOK &= ( table.find("  step") != std::string::npos );
+        LogInformation << table;
+    }
+    else
+        isOK &= table.empty();
+    timers.clear();
+    isOK &= timers.empty();
+    // Regions timed by the context, reported at its destruction :
+    work( 1 );
+    work( 2 );
+    isOK &= ( Parallel::Context::timers.calls("work") == 2 );
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
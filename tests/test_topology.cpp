@@ -0,0 +1,103 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the Cartesian and graph topologies and of the neighborhood collective operations
+# include <iostream>
+# include <string>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    if ( nargs > 1 ) {
+      if ( std::string(argv[1]) == std::string("trace") )
+        log.subscribe(new Parallel::LogToFile("Trace",Parallel::Logger::Listener::Listen_for_trace));
+    }
+    Parallel::Communicator com;
+    bool isOK = true;
+    // Periodic 2D grid with balanced dimensions :
+    Parallel::CartesianCommunicator grid(com, {0, 0}, {true, true}, true);
+    std::vector<int> dims = grid.dimensions();
+    isOK &= ( grid.size == com.size && grid.nbDimensions() == 2 );
+    isOK &= ( dims[0]*dims[1] == com.size && dims[0] >= dims[1] );
+    isOK &= ( Parallel::CartesianCommunicator::dimensions(12, {0, 0, 0}) == std::vector<int>({3, 2, 2}) );
+    isOK &= ( Parallel::CartesianCommunicator::dimensions(12, {0, 3}) == std::vector<int>({4, 3}) );
+    std::vector<int> coords = grid.coordinates();
+    isOK &= ( grid.rankOf(coords) == grid.rank && grid.coordinates(grid.rank) == coords );
+    std::pair<int,int> nghbs = grid.shift(1);
+    isOK &= ( nghbs.first  == grid.rankOf({coords[0], coords[1]-1}) );
+    isOK &= ( nghbs.second == grid.rankOf({coords[0], coords[1]+1}) );
+    // Rows and columns of the grid :
+    Parallel::CartesianCommunicator rows(grid, {false, true}), cols(grid, {true, false});
+    isOK &= ( rows.size == dims[1] && rows.coordinates() == std::vector<int>{coords[1]} );
+    isOK &= ( cols.size == dims[0] && cols.coordinates() == std::vector<int>{coords[0]} );
+    int rowSum;
+    rows.allreduce(coords[0], rowSum, Parallel::sum);
+    isOK &= ( rowSum == coords[0]*dims[1] );
+    // Neighborhood collectives on the grid : ( up, down, left, right )
+    std::vector<int> sources = grid.neighborSources();
+    isOK &= ( sources.size() == 4 && sources == grid.neighborDestinations() );
+    std::vector<int> ranks;
+    grid.neighbor_allgather(grid.rank, ranks);
+    isOK &= ( ranks == sources );
+    // The chunk sended in one direction is received from the opposite direction :
+    std::vector<int> chunks(8), received;
+    for ( int i = 0; i < 8; ++i ) chunks[i] = 10*grid.rank + i/2;
+    grid.neighbor_alltoall(chunks, received);
+    isOK &= ( received.size() == 8 );
+    for ( int i = 0; i < 8; ++i ) isOK &= ( received[i] == 10*sources[i/2] + ((i/2)^1) );
+    // Non periodic line : no neighbor on the boundaries
+    Parallel::CartesianCommunicator line(com, {com.size}, {false});
+    nghbs = line.shift(0);
+    isOK &= ( nghbs.first  == (line.rank > 0 ? line.rank-1 : Parallel::no_process) );
+    isOK &= ( nghbs.second == (line.rank < line.size-1 ? line.rank+1 : Parallel::no_process) );
+    double values[2] = { -1., -1. }, mine = line.rank;
+    line.neighbor_allgather(1, &mine, values);
+    isOK &= ( values[0] == (line.rank > 0 ? line.rank-1. : -1.) );
+    isOK &= ( values[1] == (line.rank < line.size-1 ? line.rank+1. : -1.) );
+    // Graph : each process sends to the two next processes a chunk of growing size
+    const int rank = com.rank, size = com.size;
+    Parallel::GraphCommunicator graph(com, {(rank+size-1)%size, (rank+size-2)%size},
+                                      {(rank+1)%size, (rank+2)%size});
+    isOK &= ( graph.neighborSources() == std::vector<int>({(rank+size-1)%size, (rank+size-2)%size}) );
+    std::vector<double> snd{ double(rank), double(rank), double(rank) }, rcv;
+    std::vector<int> rcvCounts;
+    graph.neighbor_alltoallv(snd, {1, 2}, rcv, rcvCounts);
+    isOK &= ( rcvCounts == std::vector<int>({1, 2}) );
+    isOK &= ( rcv == std::vector<double>({double((rank+size-1)%size),
+                                          double((rank+size-2)%size), double((rank+size-2)%size)}) );
+    int next[2];
+    graph.neighbor_alltoall(1, std::vector<int>{rank, -rank}.data(), next);
+    isOK &= ( next[0] == (rank+size-1)%size && next[1] == -((rank+size-2)%size) );
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,106 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Test of the trace of the communications and of the regions
+# include <fstream>
+# include <iomanip>
+# include <iostream>
+# include <sstream>
+# include <string>
+# include <vector>
+# include "Parallel/Parallel.hpp"
+# include "Parallel/LogToFile.hpp"
+
+namespace
+{
+    std::string readFile( const std::string& fileName )
+    {
+        std::ifstream file(fileName);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+    std::size_t count( const std::string& text, const std::string& pattern )
+    {
+        std::size_t nb = 0;
+        for ( auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos+1) ) ++nb;
+        return nb;
+    }
+}
+
+int parallel_main( int nargs, char* argv[] )
+{
+    Parallel::Context context(nargs, argv);
+    Parallel::Logger& log = Parallel::Context::logger;
+    int listeners = Parallel::Logger::Listener::Listen_for_assertion +
+                    Parallel::Logger::Listener::Listen_for_error +
+                    Parallel::Logger::Listener::Listen_for_warning +
+                    Parallel::Logger::Listener::Listen_for_information;
+    log.subscribe(new Parallel::LogToFile("Output",listeners));
+    Parallel::Communicator com;
+    Parallel::Tracer& tracer = Parallel::Tracer::current();
+    bool isOK = true;
+    // Nothing is recorded before the tracer is enabled :
+    com.barrier();
+    isOK &= ( tracer.size() == 0 );
+    tracer.enable(Parallel::Tracer::per_process, "TestTrace");
+    {
+        TimeRegion("exchange");
+        const int next = (com.rank + 1)%com.size, prev = (com.rank + com.size - 1)%com.size;
+        std::vector<double> values(100, double(com.rank)), received;
+        Parallel::Request req = com.isend(values, next, 3);
+        com.recv(received, prev, 3);
+        req.wait();
+        int token = ( com.rank == 0 ? 42 : 0 );
+        com.bcast(1, &token, &token, 0);
+        com.barrier();
+    }
+    // Begin and end of exchange, isend, recv, wait ( if not completed ), bcast and barrier :
+    isOK &= ( tracer.size() >= 10 );
+    tracer.report();
+    isOK &= !tracer.isEnabled();
+    std::ostringstream fileName;
+    fileName << "TestTrace" << std::setfill('0') << std::setw(5) << com.rank << ".json";
+    std::string trace = readFile(fileName.str());
+    isOK &= ( trace.find("\"traceEvents\"") != std::string::npos );
+    isOK &= ( count(trace, "\"ph\":\"B\"") == count(trace, "\"ph\":\"E\"") );
+    isOK &= ( count(trace, "\"name\":\"exchange\",\"ph\":\"B\"") == 1 );
+    isOK &= ( count(trace, "\"name\":\"isend\",\"ph\":\"E\"") == 1 );
+    isOK &= ( trace.find("\"args\":{\"bytes\":800,\"peer\":" + std::to_string((com.rank+1)%com.size) + "}")
+              != std::string::npos );
+    isOK &= ( count(trace, "\"name\":\"barrier\",\"ph\":\"B\"") == 1 );
+    isOK &= ( trace.find("\"ts\":-") == std::string::npos );
+    // All the processes in one file :
+    tracer.clear();
+    tracer.enable(Parallel::Tracer::merged, "TestTraceMerged");
+    com.barrier();
+    tracer.report();
+    if ( com.rank == 0 ) {
+        std::string merged = readFile("TestTraceMerged.json");
+        isOK &= ( count(merged, "\"name\":\"process_name\"") == std::size_t(com.size) );
+        isOK &= ( count(merged, "\"name\":\"barrier\",\"ph\":\"B\"") == std::size_t(com.size) );
+    }
+    if ( isOK ) {
+      LogInformation << "Test passed." << std::endl;
+    }
+    else {
+      LogError << "Test failed !\n";
+    }
+    return EXIT_SUCCESS;
+}
+// ---------------------------------------------------------------------
+// Without MPI, the processes are simulated by threads ( PARALLEL_NB_PROCS )
+int main( int nargs, char* argv[] )
+{
+    return Parallel::Context::launch(nargs, argv, parallel_main);
+}
@@ -0,0 +1,65 @@
+// Copyright 2017 Dr. Xavier JUVIGNY
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+
+//     http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// Decode the binary logs of the processes ( LogToBinaryFile ) and print their
+// messages sorted by time :
+//     parallel-logdump [-m mask] Output*.plog
+// The mask selects the modes ( sum of 1 assertion, 2 error, 4 warning, 8 information, 16 trace ).
+# include <algorithm>
+# include <cstdlib>
+# include <cstring>
+# include <iomanip>
+# include <iostream>
+# include <string>
+# include <tuple>
+# include <vector>
+# include "Parallel/LogToBinaryFile.hpp"
+
+int main( int nargs, char* argv[] )
+{
+    using Parallel::LogToBinaryFile;
+    int mask = Parallel::Logger::ALL;
+    std::vector<LogToBinaryFile::Content> files;
+    for ( int iarg = 1; iarg < nargs; ++iarg ) {
+        if ( std::strcmp(argv[iarg], "-m") == 0 && iarg+1 < nargs ) {
+            mask = std::atoi(argv[++iarg]);
+            continue;
+        }
+        files.emplace_back();
+        if ( !LogToBinaryFile::read(argv[iarg], files.back()) ) {
+            std::cerr << argv[iarg] << " : not a binary log or truncated file\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if ( files.empty() ) {
+        std::cerr << "Usage : " << argv[0] << " [-m mask] files...\n";
+        return EXIT_FAILURE;
+    }
+    // Messages sorted by time, then by rank, then in their order in the file
+    typedef std::tuple<std::int64_t, int, std::size_t, std::size_t> Key;
+    std::vector<Key> messages;
+    for ( std::size_t f = 0; f < files.size(); ++f )
+        for ( std::size_t e = 0; e < files[f].entries.size(); ++e )
+            if ( files[f].entries[e].mode & mask )
+                messages.emplace_back( files[f].entries[e].time, files[f].rank, e, f );
+    std::sort( messages.begin(), messages.end() );
+    if ( messages.empty() ) return EXIT_SUCCESS;
+    const std::int64_t start = std::get<0>(messages.front());
+    std::cout << std::fixed << std::setprecision(9);
+    for ( const Key& message : messages ) {
+        const LogToBinaryFile::Content& content = files[std::get<3>(message)];
+        std::cout << "[" << std::setw(14) << 1.E-9*double(std::get<0>(message) - start) << "] "
+                  << LogToBinaryFile::format( content, content.entries[std::get<2>(message)] ) << '\n';
+    }
+    return EXIT_SUCCESS;
+}